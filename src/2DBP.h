@@ -28,6 +28,7 @@
 #include <array>
 #include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <cstdio>
 #include <ctime>
 #include <filesystem>
@@ -35,6 +36,7 @@
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <queue>
 #include <set>
 #include <sstream>
@@ -45,6 +47,7 @@
 #include <ilcplex/ilocplex.h>
 
 #include "logger.h"
+#include "profiler.h"
 
 using namespace std;
 
@@ -63,12 +66,29 @@ constexpr int kMaxCgIter = 100;             // 列生成最大迭代次数 (安
                                             // 正常应 5-30 次收敛，超过50次可能算例过大
 constexpr int kMaxBPNodes = -1;             // 分支树最大节点数 (-1 表示不限制，由时间控制)
                                             // 调试建议: -1 (不限制) 或 1000 (宽松限制)
+constexpr int kNodePoolBlockSize = 64;      // 节点池每块的节点数
+constexpr double kSpillResumeRatio = 0.9;   // 内存 (或内存中待处理节点数) 回落到该比例以下时恢复最优优先搜索
+constexpr double kSpillRegrowRatio = 1.05;  // 溢出后 RSS 增长到上次溢出时的该倍数以上才再次溢出
+constexpr int kCheckpointIntervalSec = 300; // 检查点默认写出间隔 (秒)
+constexpr int kImplicitArcMinLength = 20000;    // 条带长度 (缩放后) 超过该值时 SP2 使用隐式网络
+                                                // 不再显式存储 Arc 列表，定价改为最长路 DP
+
+// 秩1割参数 (cuts.cpp)
+constexpr int kMaxCutRounds = 5;            // 每个节点列生成收敛后的割平面轮数上限
+constexpr int kMaxCutsPerRound = 8;         // 每轮最多加入的割数 (按违反量从大到小)
+constexpr int kMaxNodeCuts = 24;            // 单个节点 RMP 中的割数上限 (SP2 标签数随割数增长)
+constexpr int kMaxCutPoolSize = 5000;       // 全局割池上限
+constexpr int kMaxCutDenom = 4;             // 单行 / 两行 CG 割的分母 q 上限
+constexpr int kMaxSepItems = 60;            // 枚举 SR3 时考虑的子板种类数上限
+constexpr double kCutViolationTol = 1.0e-2; // 违反量超过该值的割才加入
 
 // 文件路径配置
 const string kDataDir = "../CS-2D-Data/data/";  // 算例数据目录 (CS-2D-Data输出)
 const string kFilePattern = "inst_";            // 算例文件名前缀
 const string kLogDir = "logs/";             // 日志输出目录
 const string kLpDir = "lp/";                // LP 文件输出目录 (调试用)
+const string kArcCacheDir = "arc_cache/";   // Arc 网络缓存目录 (相同母板与尺寸集合的算例复用)
+const string kSpillDir = "spill/";          // 内存超预算时待处理节点的溢出文件目录
 constexpr bool kExportLp = false;           // 是否导出 LP 文件，开启会降低性能
 
 // 子问题求解方法枚举
@@ -92,6 +112,56 @@ enum BranchType {
     kBranchSP2Arc = 2   // SP2 Arc 分支，对长度方向的 Arc 进行分支
 };
 
+// CPLEX 求解阶段 (cplex_profile.cpp)，每个阶段一组参数
+enum CplexPhase {
+    kCplexRootMaster = 0,   // 根节点 RMP (加列后重解)
+    kCplexNodeRows = 1,     // 节点 RMP 建立及加入割行后重解
+    kCplexNodeColumns = 2,  // 节点 RMP 加列后重解
+    kCplexPricing = 3,      // 子问题 (背包 / Arc Flow MIP)
+    kNumCplexPhases = 4
+};
+constexpr int kNumMasterPhases = kCplexPricing;    // 主问题阶段数 (SolveMasterLP 计时与调参)
+
+// LP 算法，取值与 CPLEX RootAlgorithm 参数一致
+enum LpAlgorithm {
+    kLpAuto = 0,
+    kLpPrimal = 1,
+    kLpDual = 2,
+    kLpNetwork = 3,
+    kLpBarrier = 4,
+    kLpSifting = 5,
+    kLpConcurrent = 6,
+    kNumLpAlgorithms = 7
+};
+
+// 并行模式，取值与 CPLEX Parallel 参数一致
+enum ParallelMode {
+    kParallelOpportunistic = -1,
+    kParallelAuto = 0,
+    kParallelDeterministic = 1
+};
+
+constexpr int kTuneSamples = 5;             // 自动调参时每个候选 LP 算法的采样求解次数
+
+// 单个阶段的 CPLEX 参数
+struct CplexProfile {
+    int algorithm_ = kLpAuto;               // LpAlgorithm
+    int threads_ = 0;                       // 线程数，0 表示 CPLEX 自动
+    int parallel_mode_ = kParallelAuto;     // ParallelMode
+};
+
+// 单个阶段的主问题求解统计 (含自动调参样本)
+struct CplexPhaseStats {
+    int num_solves_ = 0;
+    double total_ms_ = 0.0;
+    int tune_samples_ = 0;                  // 已完成的调参采样次数
+    int tune_done_ = 0;                     // 1 = 已选定算法
+    array<double, kNumLpAlgorithms> tune_ms_{};     // 各候选算法的累计耗时
+    array<int, kNumLpAlgorithms> tune_count_{};     // 各候选算法的采样次数
+};
+
+array<CplexProfile, kNumCplexPhases> DefaultCplexProfiles();
+
 // 子板类型结构体
 // 存储同一规格子板的聚合信息，相同尺寸的子板归为同一类型
 struct ItemType {
@@ -99,6 +169,8 @@ struct ItemType {
     int length_ = -1;       // 长度 (沿 X 轴方向)
     int width_ = -1;        // 宽度 (沿 Y 轴方向)
     int demand_ = -1;       // 需求数量
+    int orig_length_ = -1;  // 预处理缩放前的长度 (用于恢复原始尺寸)
+    int orig_width_ = -1;   // 预处理缩放前的宽度
 };
 
 // 条带类型结构体
@@ -108,23 +180,39 @@ struct StripType {
     int type_id_ = -1;      // 类型编号，从 0 开始
     int width_ = -1;        // 宽度 (沿 Y 轴，等于对应子板宽度)
     int length_ = -1;       // 长度 (沿 X 轴，等于母板长度)
+    int orig_width_ = -1;   // 预处理缩放前的宽度
 };
 
 // SP2 Arc Flow 网络数据结构
 // 用于条带上的子板排列问题 (长度方向背包)
 // 网络节点表示条带上的位置 (0 到 stock_length)
 // Arc 表示在某位置放置一个子板，Arc 长度等于子板长度
+//
+// 所有条带类型共享同一个网络: 各条带类型的网络节点相同 (0..L)，只在可放入的子板上不同
+// Arc 只记录长度种类 lengths_[d] (能放入条带的子板长度去重，无长度 1 的子板时追加损耗弧)，
+// 条带类型 j 上长度种类 d 对应的子板由 SP2StripData::length_items_[d] 给出，定价时按此过滤
+//
+// 隐式模式 (implicit_ = true, 条带长度超过 kImplicitArcMinLength 时启用):
+//   不生成 arc_list_ / arc_to_index_ / 节点入出弧列表，Arc 在定价和分支时按公式现算
+//   Arc 编号 = 起点 * 种类数 + d，只有带分支约束的 Arc 的对偶价格显式存储
+//   内存与子板种类数成正比，与 L x 子板种类数无关
 struct SP2ArcFlowData {
-    int strip_type_id_ = -1;                // 对应的条带类型编号
+    // 隐式网络
+    bool implicit_ = false;                 // true = 隐式网络
+    int capacity_ = 0;                      // 条带长度 L
+
+    // Arc 长度种类
+    vector<int> lengths_;                   // 各长度种类的长度 (升序)
 
     // 节点分类: 起点 (位置0)、终点 (位置L)、中间节点
     vector<int> begin_nodes_;               // 起点节点列表 (只有一个元素: 0)
     vector<int> end_nodes_;                 // 终点节点列表 (只有一个元素: L)
-    vector<int> mid_nodes_;                 // 中间节点列表 (位置 1 到 L-1 中有效的)
+    vector<int> mid_nodes_;                 // 中间节点列表 (位置 1 到 L-1)
 
     // Arc 信息
     vector<array<int, 2>> arc_list_;        // Arc 列表，每个 Arc 为 [起点位置, 终点位置]
     map<array<int, 2>, int> arc_to_index_;  // Arc 到索引的映射，用于快速查找
+    vector<int> arc_length_index_;          // arc_length_index_[a] = Arc a 的长度种类下标
 
     // Arc 分类索引，用于构建流量守恒约束
     vector<int> begin_arc_indices_;         // 从起点 (位置0) 出发的 Arc 索引列表
@@ -133,6 +221,54 @@ struct SP2ArcFlowData {
     vector<vector<int>> mid_out_arcs_;      // mid_out_arcs_[i] = 离开中间节点 i 的 Arc 索引
 };
 
+// SP2 网络的条带类型数据 (每种条带类型一个)
+// 只保存与条带宽度有关的部分，大小与长度种类数及分支行数成正比
+struct SP2StripData {
+    vector<int> length_items_;              // length_items_[d] = 长度种类 d 对应的子板类型索引
+                                            // -1 表示该条带上没有此长度的子板
+    map<int, double> arc_duals_;            // 该条带类型受约束 Arc 的分支行对偶价格之和 μ_a (按编号)
+};
+
+// SP2 路径定价缓冲区 (SolveSP2ImplicitPath / SolveSP2LabelPath)
+// 每个线程一份 (ThreadPathWorkspace)，跨调用复用，定价时只清空不重新分配
+struct PathWorkspace {
+    vector<int> kinds_;                     // 本条带可用的长度种类
+    vector<char> kind_allowed_;
+    vector<double> kind_profit_;
+    vector<vector<int>> kind_cuts_;         // 各长度种类的子板所在的割
+
+    vector<double> best_;                   // 最长路: 到达各位置的最大收益
+    vector<int> pred_arc_;                  // 最长路: 到达各位置的最优入弧编号
+
+    vector<double> label_profit_;           // 标签池: 收益
+    vector<int> label_pred_;                // 标签池: 前驱标签
+    vector<int> label_arc_;                 // 标签池: 入弧编号
+    vector<uint8_t> label_res_;             // 标签池: 各割余数 (每个标签连续存放)
+    vector<vector<int>> buckets_;           // 各位置上未被支配的标签
+    vector<int> labels_;                    // 当前起点的标签
+    vector<pair<int, int>> out_arcs_;       // 当前起点出发的 Arc (编号, 长度种类)
+    vector<uint8_t> res_;                   // 新标签的余数
+};
+
+// SP2 Arc 的长度种类下标
+inline int GetSP2ArcKind(const SP2ArcFlowData& arc_data, int arc_id) {
+    return arc_data.implicit_ ? arc_id % static_cast<int>(arc_data.lengths_.size())
+                              : arc_data.arc_length_index_[arc_id];
+}
+
+// SP2 Arc 在指定条带类型上对应的子板类型，-1 表示损耗弧或该条带不可用
+inline int GetSP2ArcItem(const SP2ArcFlowData& arc_data, const SP2StripData& strip_data,
+    int arc_id) {
+    return strip_data.length_items_[GetSP2ArcKind(arc_data, arc_id)];
+}
+
+// SP2 Arc 能否用于指定条带类型: 对应子板宽度合适，或为长度 1 的损耗弧
+inline bool SP2ArcAllowed(const SP2ArcFlowData& arc_data, const SP2StripData& strip_data,
+    int arc_id) {
+    int kind = GetSP2ArcKind(arc_data, arc_id);
+    return strip_data.length_items_[kind] >= 0 || arc_data.lengths_[kind] == 1;
+}
+
 // SP1 Arc Flow 网络数据结构
 // 用于母板上的条带排列问题 (宽度方向背包)
 // 网络节点表示母板宽度方向的位置 (0 到 stock_width)
@@ -146,6 +282,10 @@ struct SP1ArcFlowData {
     // Arc 信息
     vector<array<int, 2>> arc_list_;        // Arc 列表 [起点, 终点]
     map<array<int, 2>, int> arc_to_index_;  // Arc 到索引的快速映射
+    vector<int> arc_strip_index_;           // arc_strip_index_[a] = Arc a 对应的条带类型索引
+                                            // -1 表示纯损耗弧
+    vector<double> arc_duals_;              // arc_duals_[a] = Arc a 的分支行对偶价格之和 μ_a
+    vector<int> touched_arcs_;              // arc_duals_ 中非零项的下标
 
     // Arc 分类索引
     vector<int> begin_arc_indices_;         // 从起点出发的 Arc
@@ -160,36 +300,87 @@ struct NewColumn {
     vector<int> pattern_;               // 切割方案系数向量
                                         // Y列: pattern_[j] = 条带类型 j 的数量
                                         // X列: pattern_[i] = 子板类型 i 的数量
-    set<array<int, 2>> arc_set_;        // 对应的 Arc 集合，用于 Arc 分支
+    vector<int> arc_ids_;               // Arc 编号 (升序)，用于 Arc 分支
+                                        // 子问题写入选中的 Arc，加入列池前替换为规范 Arc 编号
 };
 
-// Y 列结构体 (第一阶段切割方案)
-// 表示一种将母板切割为条带的方案
-struct YColumn {
-    vector<int> pattern_;               // pattern_[j] = 该方案中条带类型 j 的产出数量
-    set<array<int, 2>> arc_set_;        // 对应的 SP1 Arc 集合 (宽度方向)
-    double value_ = 0.0;                // LP 解中该列的取值
-    int var_index_ = -1;                // 该列在 IloNumVarArray vars 中的索引位置
+// 列存储结构体 (SoA 布局)
+// 一类列 (全部 Y 列或全部 X 列) 存放在一个对象中，第 c 列的数据分散在各数组的第 c 项:
+//   - 切割方案按行优先存入一块连续矩阵，每列占 width_ 个系数
+//   - LP 取值、所属条带类型、变量索引各为一个连续数组
+//   - Arc 集合按 CSR 存储: 第 c 列的 Arc 编号为 arc_ids_[arc_offsets_[c] .. arc_offsets_[c+1])
+// 系数上界不超过 int16 范围时用 int16 存储，否则用 int32 (由 InitColumnStore 决定)
+// 分支约束均以 RMP 行的形式施加，因此所有节点共享同一个全局列池
+struct ColumnStore {
+    int width_ = 0;                     // 每列系数个数 (Y 列 = J，X 列 = N)
+    int num_cols_ = 0;                  // 列数
+    bool wide_ = false;                 // true = 使用 int32 系数矩阵
+
+    vector<int16_t> patterns16_;        // 行优先系数矩阵 (wide_ = false)
+    vector<int32_t> patterns32_;        // 行优先系数矩阵 (wide_ = true)
+    vector<double> values_;             // 最近一次 RMP 求解中各列的取值
+    vector<int> strip_types_;           // X 列所属条带类型，Y 列为 -1
+    vector<int> var_indices_;           // 各列在当前 RMP 的 IloNumVarArray vars 中的索引
+    vector<int> arc_offsets_ = {0};     // CSR 行偏移，长度 num_cols_ + 1
+    vector<int> arc_ids_;               // CSR 数据: 各列的 Arc 编号 (列内升序)
 };
 
-// X 列结构体 (第二阶段切割方案)
-// 表示一种将条带切割为子板的方案
-struct XColumn {
-    int strip_type_id_ = -1;            // 所属条带类型编号
-    vector<int> pattern_;               // pattern_[i] = 该方案中子板类型 i 的产出数量
-    set<array<int, 2>> arc_set_;        // 对应的 SP2 Arc 集合 (长度方向)
-    double value_ = 0.0;                // LP 解中该列的取值
-    int var_index_ = -1;                // 该列在 IloNumVarArray vars 中的索引位置
+// 列取值
+// 引用全局列池中的一列及其在解中的取值
+struct ColumnValue {
+    int col_ = -1;                      // 列编号 (ColumnStore 下标)
+    double value_ = 0.0;                // 取值
 };
 
 // 节点解结构体
-// 存储分支定价节点的 LP 求解结果
+// 存储分支定价节点的 LP 求解结果，只记录非零列，列本身存放在全局列池中
 struct NodeSolution {
-    vector<YColumn> y_columns_;         // Y 列集合及其 LP 解值
-    vector<XColumn> x_columns_;         // X 列集合及其 LP 解值
+    vector<ColumnValue> y_cols_;        // 非零 Y 列 (列编号升序)
+    vector<ColumnValue> x_cols_;        // 非零 X 列 (列编号升序)
     double obj_val_ = -1;               // 目标函数值 (母板使用量)
 };
 
+// 节点 LP 解在一个 Arc 网络上的流量 (分支选择用)
+// 结果为按 Arc 编号升序的紧凑数组; flow_ 为按 Arc 编号的稠密累加数组，累加后按 touched_ 清零，跨节点复用
+struct ArcFlowList {
+    vector<int> arc_ids_;               // 流量非零的 Arc 编号 (升序)
+    vector<array<int, 2>> arcs_;        // 对应 Arc 的 [起点, 终点]
+    vector<double> flows_;              // 对应 Arc 的总流量
+
+    vector<double> flow_;               // 累加工作区 flow_[a]
+    vector<int> touched_;               // flow_ 中非零项的下标
+};
+
+// Arc 分支约束行
+// 记录 RMP 中一条 Arc 行约束的位置及所属网络，更新列系数和提取对偶价格时
+// 直接按下标访问，不再解析约束名
+struct ArcConRow {
+    int row_ = -1;                      // 在 cons 中的行索引
+    int strip_type_ = -1;               // -1 = SP1 网络，>= 0 = SP2 条带类型
+    int arc_idx_ = -1;                  // Arc 在对应网络 arc_list_ 中的编号，-1 = 不在网络中
+    array<int, 2> arc_ = {-1, -1};      // Arc [起点, 终点]
+    double dual_ = 0.0;                 // 最近一次 RMP 求解的对偶价格
+};
+
+// 秩1割 (cuts.cpp)
+// 需求行子集 S 以乘子 1/q 组合后取整 (Chvátal-Gomory 秩1割):
+//   Σ_p ceil(Σ_{i∈S} a_ip / q) X_p >= ceil(Σ_{i∈S} d_i / q)
+// |S| = 3, q = 2 即子集行割 (SR3); Y 列系数为 0, SP1 定价不受影响
+// 割对任意整数解有效, 与分支约束无关, 存放在全局割池中供各节点复用
+struct RankOneCut {
+    vector<int> items_;                 // 子板类型子集 S (升序)
+    int denom_ = 2;                     // 分母 q
+    int rhs_ = 0;                       // 右端项 ceil(Σ_{i∈S} d_i / q)
+};
+
+// 割行
+// 记录 RMP 中一条割约束的位置及其对偶价格 ρ_c (>= 0)
+struct CutRow {
+    int row_ = -1;                      // 在 cons 中的行索引
+    int cut_id_ = -1;                   // 割池下标
+    double dual_ = 0.0;                 // 最近一次 RMP 求解的对偶价格
+};
+
 // 分支定价节点结构体
 // 分支定价树中的一个节点，包含该节点的所有状态信息
 struct BPNode {
@@ -200,6 +391,7 @@ struct BPNode {
     // 节点标识信息
     int id_ = -1;               // 节点编号，从 1 开始
     int parent_id_ = -1;        // 父节点编号，-1 表示根节点
+    int depth_ = 0;             // 节点深度，根节点为 0
     double lower_bound_ = -1;   // 节点下界 (LP 松弛解的目标值)
 
     // 分支状态标志
@@ -207,6 +399,8 @@ struct BPNode {
     int prune_flag_ = 0;        // 剪枝标志: 0=未剪枝, 1=已剪枝
                                 // 节点被剪枝的条件: 不可行 或 下界 >= 全局最优整数解
     int branched_flag_ = 0;     // 分支完成标志: 0=未分支, 1=已创建子节点
+    int cg_converged_ = 0;      // 列生成收敛标志: 1=最终对偶价格下所有子问题均无改进列
+                                // 此时 lower_bound_ 是有效下界, 子节点可用其预筛 (PrescreenChild)
 
     // 变量分支信息 (已废弃，保留兼容性)
     int branch_var_id_ = -1;            // 待分支变量索引
@@ -238,18 +432,15 @@ struct BPNode {
     map<int, vector<array<int, 2>>> sp2_greater_arcs_;  // 条带类型 j 的下界约束 Arc
     map<int, vector<int>> sp2_greater_bounds_;          // 对应的下界值
 
-    // Arc 约束对偶价格 (数学模型 Section 9.5)
+    // Arc 约束行 (数学模型 Section 9.5)
     // 弧分支约束作为行约束添加到 RMP，求解后获取对偶价格 μ_a
-    // 在子问题中用 μ_a 修正弧的收益: π_i → π_i + μ_a
-    map<array<int, 2>, double> sp1_arc_duals_;                  // SP1 arc 对偶价格
-    map<int, map<array<int, 2>, double>> sp2_arc_duals_;        // SP2 arc 对偶价格 (按条带类型)
+    // 每次 RMP 求解后由 ScatterArcDuals 写入 SP1 网络与各条带类型的 arc_duals_
+    vector<ArcConRow> arc_con_rows_;
 
-    // 主问题数据
-    vector<vector<double>> matrix_;             // 完整系数矩阵 (调试用)
-    vector<YColumn> y_columns_;                 // 当前节点的 Y 列集合
-    vector<XColumn> x_columns_;                 // 当前节点的 X 列集合
-    vector<set<array<int, 2>>> y_arc_sets_;     // Y 列对应的 Arc 集合
-    vector<set<array<int, 2>>> x_arc_sets_;     // X 列对应的 Arc 集合
+    // 秩1割 (cuts.cpp)
+    // 从父节点继承其最终 LP 中对偶价格为正的割, 本节点分离的新割追加在后
+    vector<int> cut_ids_;               // 本节点 RMP 中的割 (全局割池下标)
+    vector<CutRow> cut_rows_;           // 对应的 RMP 行, 每次 RMP 求解后更新对偶价格
 
     // 列生成迭代状态
     int iter_ = -1;                     // 当前迭代次数
@@ -259,6 +450,8 @@ struct BPNode {
     NewColumn new_y_col_;               // 本次迭代 SP1 产生的新 Y 列
     NewColumn new_x_col_;               // 本次迭代 SP2 产生的新 X 列
     int new_strip_type_ = -1;           // 新 X 列对应的条带类型
+    double price_value_ = NAN;          // 最近一次子问题的最优定价值, 子问题不可行时为 NaN
+                                        // SP1: Σ v_j a_j; SP2: Σ π_i b_i (含 Arc / 割对偶修正)
 
     // SP2 临时数据
     double sp2_obj_ = -1;               // SP2 目标函数值
@@ -271,6 +464,53 @@ struct BPNode {
     BPNode* next_ = nullptr;
 };
 
+// 分支树节点池 (node_pool.cpp)
+// 子节点按块分配，剪枝或完成分支后归还并复用; 块随节点池析构一起释放
+struct NodePool {
+    vector<unique_ptr<BPNode[]>> blocks_;   // 节点块
+    int block_used_ = 0;                    // 最后一块已分配的节点数
+    vector<BPNode*> free_list_;             // 已归还、可复用的节点
+
+    // 统计
+    long long num_allocs_ = 0;              // 分配次数
+    long long num_reuses_ = 0;              // 其中复用空闲节点的次数
+    int num_live_ = 0;                      // 在用节点数
+    int peak_live_ = 0;                     // 峰值在用节点数
+    int num_released_ = 0;                  // 已归还节点数
+};
+
+// 节点溢出文件 (node_pool.cpp)
+// 内存超过预算时，下界最大的待处理节点写入磁盘并从链表移除，搜索切换为深度优先
+// 溢出节点只在内存中保留下界与文件偏移，需要时按偏移读回
+struct SpilledNode {
+    long long offset_ = 0;                  // 记录在溢出文件中的偏移
+    double lower_bound_ = 0.0;              // 节点下界
+    int id_ = -1;                           // 节点编号
+};
+
+struct NodeSpill {
+    string path_;                           // 溢出文件路径 (首次溢出时创建)
+    fstream file_;
+    vector<SpilledNode> entries_;           // 当前在磁盘上的节点
+    bool depth_first_ = false;              // 是否处于深度优先模式 (内存超预算)
+    double spill_rss_mb_ = 0.0;             // 上次溢出时的 RSS (MB)
+    int spill_open_ = 0;                    // 上次溢出后内存中保留的待处理节点数
+
+    // 统计
+    int num_spilled_ = 0;                   // 累计溢出节点数
+    int num_reloaded_ = 0;                  // 累计读回节点数
+    int num_dropped_ = 0;                   // 在磁盘上被剪枝的节点数
+};
+
+// 分支定价检查点 (serialize.cpp)
+// 列池、最优整数解与根节点直接写回 params / data / 根节点，其余状态放在这里
+struct BPCheckpoint {
+    vector<BPNode> open_nodes_;             // 待处理节点 (读回时填充)
+    double released_lb_ = INFINITY;         // 已回收节点下界的最小值
+    int released_pruned_ = 0;               // 已回收的剪枝节点数
+    double elapsed_sec_ = 0.0;              // 此前各次运行的累计求解时间 (秒)
+};
+
 // 问题参数结构体
 // 存储算法运行过程中的全局参数和最优解信息
 struct ProblemParams {
@@ -282,6 +522,14 @@ struct ProblemParams {
     // 母板尺寸
     int stock_length_ = -1;             // 母板长度 (L，沿 X 轴)
     int stock_width_ = -1;              // 母板宽度 (W，沿 Y 轴)
+                                        // 预处理后为缩放坐标，RestoreDimensions 后恢复原值
+
+    // 尺寸缩放预处理 (preprocess.cpp)
+    int orig_stock_length_ = -1;        // 原始母板长度
+    int orig_stock_width_ = -1;         // 原始母板宽度
+    int dim_scale_length_ = 1;          // 长度方向缩放因子 (GCD)
+    int dim_scale_width_ = 1;           // 宽度方向缩放因子 (GCD)
+    int fixed_plates_ = 0;              // 预处理直接固定的母板数 (不计入 RMP 目标值)
 
     // 算例信息
     string instance_file_ = "";         // 算例文件名
@@ -292,6 +540,28 @@ struct ProblemParams {
     chrono::steady_clock::time_point start_time_;  // 程序开始时间
     bool is_timeout_ = false;           // 是否因超时终止
 
+    // 内存预算 (MB)，0 表示不限制; 超出时待处理节点溢出到磁盘
+    int mem_limit_mb_ = 0;
+
+    // 检查点文件，空字符串表示不写检查点 (serialize.cpp)
+    string checkpoint_file_ = "";
+    int checkpoint_interval_ = kCheckpointIntervalSec;  // 写出间隔 (秒)
+
+    // 非根节点列生成收敛后分离秩1割 (cuts.cpp)，--no-cuts 关闭
+    bool use_cuts_ = true;
+
+    // 根节点流水线列生成的定价线程数 (async_cg.cpp)，0 表示同步列生成
+    int cg_threads_ = 0;
+
+    // 各求解阶段的 CPLEX 参数与主问题求解统计 (cplex_profile.cpp)
+    array<CplexProfile, kNumCplexPhases> cplex_profiles_ = DefaultCplexProfiles();
+    array<CplexPhaseStats, kNumMasterPhases> cplex_stats_;
+    bool cplex_tune_ = false;           // --tune: 自动调参
+    string cplex_tune_file_ = "";       // 调参结果输出文件
+
+    // Arc 网络缓存目录，空字符串表示不使用缓存 (arc_cache.cpp)
+    string arc_cache_dir_ = kArcCacheDir;
+
     // 子问题求解方法设置
     int sp1_method_ = kCplexIP;         // SP1 默认求解方法
     int sp2_method_ = kCplexIP;         // SP2 默认求解方法
@@ -302,8 +572,7 @@ struct ProblemParams {
 
     // 全局最优整数解信息
     double global_best_int_ = INFINITY;         // 最优整数解目标值
-    vector<YColumn> global_best_y_cols_;        // 最优整数解的 Y 列
-    vector<XColumn> global_best_x_cols_;        // 最优整数解的 X 列
+    NodeSolution global_best_sol_;              // 最优整数解的列取值 (引用全局列池)
     double gap_ = INFINITY;                     // 最优性间隙 = (UB - LB) / UB
 
     // 初始解矩阵 (启发式生成)
@@ -317,7 +586,7 @@ struct ProblemData {
     // 基本数据
     vector<ItemType> item_types_;               // 子板类型列表
     vector<StripType> strip_types_;             // 条带类型列表
-    vector<int> item_lengths_;                  // 子板长度列表 (按降序排列)
+    vector<int> item_lengths_;                  // 子板长度列表 (item_lengths_[i] = 子板类型 i 的长度)
     vector<int> strip_widths_;                  // 条带宽度列表 (按降序排列)
 
     // 索引映射，用于快速查找
@@ -325,61 +594,176 @@ struct ProblemData {
     map<int, int> width_to_strip_index_;        // 宽度 -> 条带类型索引
     map<int, vector<int>> width_to_item_indices_;  // 宽度 -> 该宽度的子板类型索引列表
 
+    // 直接索引表 (按尺寸下标访问，-1 表示无对应类型)
+    // 与上面的 map 内容一致，供热点循环使用，避免 map 查找
+    vector<int> length_to_item_table_;          // length_to_item_table_[l] = 子板类型索引
+    vector<int> width_to_strip_table_;          // width_to_strip_table_[w] = 条带类型索引
+
+    // 定价上界 (预处理计算，ComputePricingBounds)
+    vector<int> strip_max_per_plate_;           // 一块母板上 j 型条带的最大数量
+    vector<int> item_max_per_strip_;            // 一个条带上 i 型子板的最大数量
+
+    // 预处理直接固定的子板 (独占整块母板，不进入主问题)
+    vector<ItemType> fixed_items_;
+
+    // 全局列池 (所有节点共享)
+    ColumnStore y_columns_;                     // Y 列 (母板 -> 条带)
+    ColumnStore x_columns_;                     // X 列 (条带 -> 子板)
+
     // SP1 Arc Flow 网络 (宽度方向，只有一个)
     SP1ArcFlowData sp1_arc_data_;
 
-    // SP2 Arc Flow 网络 (长度方向，每种条带类型一个)
-    vector<SP2ArcFlowData> sp2_arc_data_;
+    // SP2 Arc Flow 网络 (长度方向，所有条带类型共享)
+    SP2ArcFlowData sp2_arc_data_;
+    vector<SP2StripData> sp2_strip_data_;       // 各条带类型的子板过滤表与 Arc 对偶价格
+
+    // 全局割池 (所有节点共享，节点只记录割池下标)
+    vector<RankOneCut> cut_pool_;
+
+    // 分支选择的 Arc 流量工作区 (SelectBranchArc)
+    ArcFlowList branch_flow_;
+    vector<ColumnValue> branch_x_cols_;         // 非零 X 列按条带类型分组
+    vector<int> branch_x_offsets_;              // 条带类型 j 的列为 [offsets[j], offsets[j+1])
 };
 
+// 列存储函数 (column_store.cpp)
+// 初始化空列池，max_coef 为系数上界 (决定 int16 / int32 存储)
+void InitColumnStore(ColumnStore& store, int width, int max_coef);
+
+// 追加一列，返回列编号
+int AppendColumn(ColumnStore& store, const vector<int>& pattern,
+    int strip_type, const vector<int>& arc_ids);
+
+// 截断列池，只保留前 num_cols 列
+void TruncateColumnStore(ColumnStore& store, int num_cols);
+
+// 读取第 col 列的完整切割方案
+void GetColumnPattern(const ColumnStore& store, int col, vector<int>& pattern);
+
+// 判断第 col 列是否使用编号为 arc_id 的 Arc
+bool ColumnUsesArc(const ColumnStore& store, int col, int arc_id);
+
+// 读取第 col 列第 row 个系数
+inline int GetPatternCoef(const ColumnStore& store, int col, int row) {
+    size_t pos = static_cast<size_t>(col) * store.width_ + row;
+    return store.wide_ ? store.patterns32_[pos] : store.patterns16_[pos];
+}
+
 // Arc Flow 网络生成函数 (arc_flow.cpp)
 // 生成 SP1 宽度方向的 Arc Flow 网络
 void GenerateSP1Arcs(ProblemData& data, ProblemParams& params);
 
-// 生成指定条带类型的 SP2 长度方向 Arc Flow 网络
-void GenerateSP2Arcs(ProblemData& data, ProblemParams& params, int strip_type_id);
+// 生成 SP2 长度方向 Arc Flow 网络 (各条带类型共享) 及各条带类型的子板过滤表
+void GenerateSP2Arcs(ProblemData& data, ProblemParams& params);
 
-// 生成所有 Arc Flow 网络 (SP1 + 所有 SP2)
+// 生成所有 Arc Flow 网络 (SP1 + 共享 SP2)
 void GenerateAllArcs(ProblemData& data, ProblemParams& params);
 
+// Arc 网络磁盘缓存 (arc_cache.cpp)
+// Load: 命中时填充 Arc 列表、索引映射与 Arc 标签，返回 true; 节点分类由调用方重建
+// Save: 网络生成后写入缓存目录 (params.arc_cache_dir_ 为空时不读写)
+bool LoadSP1ArcCache(ProblemData& data, ProblemParams& params);
+void SaveSP1ArcCache(const ProblemData& data, const ProblemParams& params);
+bool LoadSP2ArcCache(ProblemData& data, ProblemParams& params);
+void SaveSP2ArcCache(const ProblemData& data, const ProblemParams& params);
+
+// 查找 Arc 在 SP1 (strip_type = -1) 或 SP2 网络中的编号，不存在返回 -1
+int FindArcIndex(ProblemData& data, int strip_type, const array<int, 2>& arc);
+
+// SP2 Arc 编号与端点互查 (显式网络查表，隐式网络按公式计算)，不存在返回 -1
+int GetSP2ArcId(const SP2ArcFlowData& arc_data, const array<int, 2>& arc);
+array<int, 2> GetSP2Arc(const SP2ArcFlowData& arc_data, int arc_id);
+
+// 当前线程的路径定价缓冲区
+PathWorkspace& ThreadPathWorkspace();
+
+// 隐式 SP2 网络最长路定价
+// strip_data 为所属条带类型，profits[i] = 子板 i 的收益 π_i，forbidden 为禁用 Arc 编号 (升序，可为空)
+// 输出最优路径的切割方案与 Arc 编号 (升序)，返回路径总收益
+double SolveSP2ImplicitPath(const SP2ArcFlowData& arc_data, const SP2StripData& strip_data,
+    const vector<double>& profits, const vector<int>& forbidden,
+    vector<int>& pattern, vector<int>& arc_ids, PathWorkspace& ws);
+
+// SP2 标签定价 (节点 RMP 含对偶价格为正的割行时使用)
+// cuts / cut_duals 为与本条带有关的割及其对偶价格 ρ_c，其余参数同 SolveSP2ImplicitPath
+// 显式与隐式网络均可使用，返回最优路径的收益 (含割收益)
+double SolveSP2LabelPath(const SP2ArcFlowData& arc_data, const SP2StripData& strip_data,
+    const vector<double>& profits, const vector<int>& forbidden,
+    const vector<const RankOneCut*>& cuts, const vector<double>& cut_duals,
+    vector<int>& pattern, vector<int>& arc_ids, PathWorkspace& ws);
+
+// 将节点 Arc 行对偶价格写入 SP1 的稠密 arc_duals_ 与各条带类型的 arc_duals_ (每次 RMP 求解后调用)
+void ScatterArcDuals(ProblemData& data, const BPNode* node);
+
+// 经过指定 Arc 的最优切割方案的收益 (Arc 收益与对应子问题定价相同，不考虑禁用 Arc 与割)
+// 用于右子节点的定价下界 (PrescreenChild)，没有路径经过该 Arc 时返回 -INFINITY
+double SP1PathValueThrough(const SP1ArcFlowData& arc_data, const vector<double>& duals,
+    int arc_idx);
+double SP2PathValueThrough(const SP2ArcFlowData& arc_data, const SP2StripData& strip_data,
+    const vector<double>& profits, int arc_id);
+
 // 将切割方案 (pattern) 转换为 Arc 集合
 void ConvertPatternToArcSet(vector<int>& pattern, vector<int>& sizes,
     set<array<int, 2>>& arc_set);
 
-// 为节点的 Y 列生成 Arc 集合
-void GenerateYArcSetMatrix(BPNode& node, vector<int>& strip_widths);
+// 将切割方案转换为网络中的 Arc 编号 (升序)
+void ConvertPatternToArcIds(vector<int>& pattern, vector<int>& sizes,
+    const map<array<int, 2>, int>& arc_to_index, vector<int>& arc_ids);
+
+// 计算新 Y 列的规范 SP1 Arc 编号 (入池时调用一次)
+void ComputeYColumnArcIds(ProblemData& data, vector<int>& pattern, vector<int>& arc_ids);
 
-// 为节点的 X 列生成 Arc 集合
-void GenerateXArcSetMatrix(BPNode& node, vector<int>& item_lengths, int strip_type);
+// 计算新 X 列的规范 SP2 Arc 编号 (入池时调用一次)
+void ComputeXColumnArcIds(ProblemData& data, vector<int>& pattern, int strip_type,
+    vector<int>& arc_ids);
 
 // Arc Flow 解转换函数 (arc_flow.cpp)
-// 将 Y 列 LP 解转换为 SP1 Arc 流量
-void ConvertYColsToSP1ArcFlow(vector<YColumn>& y_columns, ProblemData& data,
-    map<int, tuple<int, int, double>>& arc_flow_solution);
+// 非零 X 列按条带类型分组 (计数排序，组内保持列编号升序)
+void GroupXColsByStripType(const ColumnStore& x_columns, const vector<ColumnValue>& x_cols,
+    int num_strip_types, vector<ColumnValue>& grouped, vector<int>& offsets);
 
-// 将 X 列 LP 解转换为 SP2 Arc 流量
-void ConvertXColsToSP2ArcFlow(vector<XColumn>& x_columns, int strip_type_id,
-    ProblemData& data, map<int, tuple<int, int, double>>& arc_flow_solution);
+// 将 Y 列 LP 解累加为 SP1 Arc 流量
+void CollectSP1ArcFlow(ProblemData& data, const ColumnValue* first, const ColumnValue* last,
+    ArcFlowList& flow_list);
 
-// 在 SP1 Arc 流量中寻找分数流量的 Arc (用于分支)
-bool FindBranchArcSP1(map<int, tuple<int, int, double>>& arc_flow_solution,
-    array<int, 2>& branch_arc, double& branch_flow);
+// 将同一条带类型的 X 列 LP 解累加为 SP2 Arc 流量
+void CollectSP2ArcFlow(ProblemData& data, const ColumnValue* first, const ColumnValue* last,
+    ArcFlowList& flow_list);
 
-// 在 SP2 Arc 流量中寻找分数流量的 Arc
-bool FindBranchArcSP2(map<int, tuple<int, int, double>>& arc_flow_solution,
-    array<int, 2>& branch_arc, double& branch_flow);
+// 在 Arc 流量中寻找分数流量的 Arc (用于分支)
+bool FindBranchArc(const ArcFlowList& flow_list, array<int, 2>& branch_arc, double& branch_flow);
 
 // 打印 Arc Flow 解 (调试用)
-void PrintSP1ArcFlowSolution(map<int, tuple<int, int, double>>& solution);
-void PrintSP2ArcFlowSolution(map<int, tuple<int, int, double>>& solution, int strip_type);
+void PrintSP1ArcFlowSolution(const ArcFlowList& flow_list);
+void PrintSP2ArcFlowSolution(const ArcFlowList& flow_list, int strip_type);
 
 // 输入输出函数 (input.cpp)
 void SplitString(const string& s, vector<string>& v, const string& c);
 tuple<int, int, int> LoadInput(ProblemParams& params, ProblemData& data,
                                 const string& specified_file = "");
+void BuildStripTypes(ProblemParams& params, ProblemData& data);
 void BuildLengthIndex(ProblemData& data);
 void BuildWidthIndex(ProblemData& data);
 
+// 直接索引表查找 (越界返回 -1)
+inline int LookupSizeTable(const vector<int>& table, int size) {
+    if (size < 0 || size >= static_cast<int>(table.size())) return -1;
+    return table[size];
+}
+
+// 预处理函数 (preprocess.cpp)
+// 算例约简: 合并相同子板、剔除放不下的子板、固定独占整块母板的子板
+void ReduceInstance(ProblemParams& params, ProblemData& data);
+
+// 按可达容量与 GCD 缩小母板和子板尺寸，在生成 Arc 网络之前调用
+void PreprocessDimensions(ProblemParams& params, ProblemData& data);
+
+// 计算定价子问题中每种条带 / 子板的数量上界 (尺寸缩放之后调用)
+void ComputePricingBounds(ProblemParams& params, ProblemData& data);
+
+// 恢复原始尺寸，在导出解之前调用
+void RestoreDimensions(ProblemParams& params, ProblemData& data);
+
 // 打印函数 (input.cpp)
 void PrintParams(ProblemParams& params);
 void PrintDemand(ProblemData& data);
@@ -389,11 +773,13 @@ void PrintNodeInfo(BPNode* node);
 
 // 启发式函数 (heuristic.cpp)
 // 使用贪心策略生成初始可行解，加速列生成收敛
-void RunHeuristic(ProblemParams& params, ProblemData& data, BPNode& root_node);
+void RunHeuristic(ProblemParams& params, ProblemData& data);
 
 // 根节点列生成函数 (root_node.cpp)
 // 根节点列生成主循环
 void SolveRootCG(ProblemParams& params, ProblemData& data, BPNode& root_node);
+void ExtractColumnValues(IloCplex& cplex, IloNumVarArray& vars,
+    ColumnStore& store, vector<ColumnValue>& nonzero_cols);
 
 // 构建根节点初始主问题 (复用cplex对象)
 bool SolveRootInitMP(ProblemParams& params, ProblemData& data,
@@ -401,18 +787,82 @@ bool SolveRootInitMP(ProblemParams& params, ProblemData& data,
     IloRangeArray& cons, IloNumVarArray& vars,
     IloCplex& cplex, BPNode& root_node);
 
+// 向根节点主问题添加一列并存入全局列池 (strip_type = -1 为Y列)
+void AddRootColumn(ProblemParams& params, ProblemData& data,
+    IloObjective& obj, IloRangeArray& cons, IloNumVarArray& vars,
+    NewColumn& col, int strip_type);
+
 // 更新根节点主问题 (添加新列, 复用cplex对象)
 bool SolveRootUpdateMP(ProblemParams& params, ProblemData& data,
-    IloEnv& env, IloModel& model, IloObjective& obj,
-    IloRangeArray& cons, IloNumVarArray& vars,
+    IloObjective& obj, IloRangeArray& cons, IloNumVarArray& vars,
     IloCplex& cplex, BPNode& node);
 
 // 求解根节点最终主问题并提取解 (复用cplex对象)
 bool SolveRootFinalMP(ProblemParams& params, ProblemData& data,
-    IloEnv& env, IloModel& model, IloObjective& obj,
-    IloRangeArray& cons, IloNumVarArray& vars,
+    IloObjective& obj, IloRangeArray& cons, IloNumVarArray& vars,
     IloCplex& cplex, BPNode& node);
 
+// 根节点流水线列生成 (async_cg.cpp)
+// 定价线程按最新对偶价格并行求解 SP1/SP2, 主线程批量加列并重解 RMP; 之后由同步循环判断收敛
+bool RunAsyncRootCG(ProblemParams& params, ProblemData& data,
+    IloObjective& obj, IloRangeArray& cons, IloNumVarArray& vars,
+    IloCplex& cplex, BPNode& root_node);
+
+// CPLEX 参数配置 (cplex_profile.cpp)
+void ApplyCplexProfile(IloCplex& cplex, const CplexProfile& profile);
+// 求解主问题: 按阶段 (CplexPhase) 设置参数并记录耗时, --tune 时轮换候选 LP 算法
+bool SolveMasterLP(ProblemParams& params, IloCplex& cplex, int phase);
+bool LoadCplexProfiles(const string& path, ProblemParams& params);
+bool SaveCplexProfiles(const string& path, const ProblemParams& params);
+// 输出各阶段求解统计; --tune 时写出调参结果
+void ReportCplexProfiles(ProblemParams& params);
+
+// 列生成迭代记录 (cg_trace.cpp)
+// 每次迭代一条记录; 未求解的子问题取值为 NaN
+struct CGIterTrace {
+    bool active_ = false;               // 已打开记录文件
+    int node_id_ = -1;
+    int iter_ = 0;
+    double rmp_obj_ = NAN;              // 迭代开始时的 RMP 目标值 (本次定价所用对偶价格)
+    int rmp_rows_ = 0;
+    int rmp_cols_ = 0;
+    int master_solves_ = 0;             // 本次迭代加列后的 RMP 重解次数
+    double master_ms_ = 0.0;
+    int sp1_added_ = 0;
+    double sp1_rc_ = NAN;               // SP1 最小 reduced cost = 1 - Σ v_j a_j
+    double sp1_ms_ = NAN;
+    vector<int> sp2_added_;             // 按条带类型
+    vector<double> sp2_rc_;             // SP2 最小 reduced cost = v_j - Σ π_i b_i
+    vector<double> sp2_ms_;
+    bool same_duals_ = true;            // 所有子问题都按迭代开始时的对偶价格求解
+};
+
+// 打开记录文件: 扩展名为 .jsonl / .json 时写 JSON Lines, 否则写 CSV
+bool OpenCGTrace(const string& path, ProblemParams& params, ProblemData& data);
+void CloseCGTrace();
+// 开始一次迭代的记录 (RMP 须已求解); 未打开记录文件时不做任何事
+void BeginCGIterTrace(CGIterTrace& trace, ProblemParams& params, int node_id, int iter,
+    IloCplex& cplex, IloRangeArray& cons, IloNumVarArray& vars);
+// 记录子问题结果, start_ns 为求解开始时刻 (ProfileNow)
+void TraceSP1(CGIterTrace& trace, const BPNode& node, bool converged, int64_t start_ns);
+void TraceSP2(CGIterTrace& trace, const BPNode& node, int strip_type_id,
+    bool converged, int64_t start_ns);
+// 记录一次加列后的 RMP 重解
+void TraceMasterSolve(CGIterTrace& trace, int64_t start_ns);
+void WriteCGIterTrace(CGIterTrace& trace);
+
+// 分支定价树事件记录 (tree_log.cpp)，JSON Lines; 未打开记录文件时各函数不做任何事
+bool OpenTreeLog(const string& path);
+void CloseTreeLog();
+void LogTreeCreated(ProblemParams& params, const BPNode* node);
+void LogTreeSelected(ProblemParams& params, const BPNode* node, int num_open);
+// cg_ms: 节点列生成耗时 (毫秒), NaN 表示未计时
+void LogTreeSolved(ProblemParams& params, const BPNode* node, double cg_ms);
+void LogTreeBranched(ProblemParams& params, const BPNode* node);
+// reason: bound / prescreen / infeasible / timeout / integer
+void LogTreePruned(ProblemParams& params, int node_id, double lower_bound, const char* reason);
+void LogTreeIncumbent(ProblemParams& params, const BPNode* node);
+
 // 根节点子问题函数 (root_node_sub.cpp)
 // SP1: 宽度背包问题 - 选择条带放置在母板上
 // 数学模型: max sum(v_j * G_j), s.t. sum(w_j * G_j) <= W
@@ -431,19 +881,29 @@ bool SolveRootSP2ArcFlow(ProblemParams& params, ProblemData& data,
     BPNode& node, int strip_type_id);
 bool SolveRootSP2DP(ProblemParams& params, ProblemData& data,
     BPNode& node, int strip_type_id);
+bool SolveRootSP2Implicit(ProblemParams& params, ProblemData& data,
+    BPNode& node, int strip_type_id);
 
 // 非根节点列生成函数 (new_node.cpp)
 // 非根节点需要考虑从父节点继承的 Arc 约束
 int SolveNodeCG(ProblemParams& params, ProblemData& data, BPNode* node);
+void ExtractNodeArcDuals(ProblemData& data, IloCplex& cplex,
+    IloRangeArray& cons, BPNode* node);
+void ExtractNodeCutDuals(IloCplex& cplex, IloRangeArray& cons, BPNode* node);
+
+// 为 node->cut_ids_[first..] 添加割行 (系数覆盖列池中全部 X 列)
+void AddNodeCutRows(ProblemData& data, IloEnv& env, IloModel& model,
+    IloRangeArray& cons, IloNumVarArray& vars, BPNode* node, int first);
 bool SolveNodeInitMP(ProblemParams& params, ProblemData& data,
     IloEnv& env, IloModel& model, IloObjective& obj,
-    IloRangeArray& cons, IloNumVarArray& vars, BPNode* node);
+    IloRangeArray& cons, IloNumVarArray& vars,
+    IloCplex& cplex, BPNode* node);
 bool SolveNodeUpdateMP(ProblemParams& params, ProblemData& data,
-    IloEnv& env, IloModel& model, IloObjective& obj,
-    IloRangeArray& cons, IloNumVarArray& vars, BPNode* node);
+    IloObjective& obj, IloRangeArray& cons, IloNumVarArray& vars,
+    IloCplex& cplex, BPNode* node);
 bool SolveNodeFinalMP(ProblemParams& params, ProblemData& data,
-    IloEnv& env, IloModel& model, IloObjective& obj,
-    IloRangeArray& cons, IloNumVarArray& vars, BPNode* node);
+    IloObjective& obj, IloRangeArray& cons, IloNumVarArray& vars,
+    IloCplex& cplex, BPNode* node);
 
 // 非根节点子问题函数 (new_node_sub.cpp)
 // 与根节点类似，但需要应用该节点累积的 Arc 约束
@@ -456,6 +916,24 @@ bool SolveNodeSP2ArcFlow(ProblemParams& params, ProblemData& data,
     BPNode* node, int strip_type_id);
 bool SolveNodeSP2DP(ProblemParams& params, ProblemData& data,
     BPNode* node, int strip_type_id);
+bool SolveNodeSP2Implicit(ProblemParams& params, ProblemData& data,
+    BPNode* node, int strip_type_id);
+bool SolveNodeSP2Labels(ProblemParams& params, ProblemData& data,
+    BPNode* node, int strip_type_id);
+
+// 秩1割函数 (cuts.cpp)
+// 割系数 ceil(Σ_{i∈S} a_i / q): 按切割方案 / 按列池中的列
+int CutPatternCoef(const RankOneCut& cut, const vector<int>& pattern);
+int CutColumnCoef(const RankOneCut& cut, const ColumnStore& store, int col);
+
+// 在割池中查找相同的割，没有则追加，返回割池下标 (割池已满时返回 -1)
+int FindOrAddCut(ProblemData& data, const RankOneCut& cut);
+
+// 在节点 LP 解上分离秩1割并追加到 node->cut_ids_，返回新加入的割数
+int SeparateRankOneCuts(ProblemParams& params, ProblemData& data, BPNode* node);
+
+// 只保留对偶价格为正的割 (节点列生成结束时调用，子节点继承 cut_ids_)
+void DropSlackCuts(BPNode* node);
 
 // 列生成调度函数 (column_generation.cpp)
 // 根据配置的求解方法调用对应的子问题求解函数
@@ -466,12 +944,16 @@ bool SolveNodeSP1(ProblemParams& params, ProblemData& data, BPNode* node);
 bool SolveNodeSP2(ProblemParams& params, ProblemData& data,
     BPNode* node, int strip_type_id);
 
+// DP 子问题共用: 向背包 DP 表加入一种物品，数量不超过 max_count
+void AddKnapsackItem(vector<double>& dp, vector<vector<int>>& choice,
+    int type, int size, double value, int max_count);
+
 // 分支定价函数 (branch_and_price.cpp)
 // 检查 LP 解是否为整数解
 bool IsIntegerSolution(NodeSolution& solution);
 
 // 选择分支变量 (变量分支，已废弃)
-int SelectBranchVar(BPNode* node);
+int SelectBranchVar(ProblemData& data, BPNode* node);
 
 // 选择分支 Arc (Arc 流量分支)
 // 优先检查 SP1 Arc，若全整数再检查 SP2 Arc
@@ -483,11 +965,64 @@ void CreateLeftChild(BPNode* parent, int new_id, BPNode* child);
 // 创建右子节点 (Arc >= ceil)
 void CreateRightChild(BPNode* parent, int new_id, BPNode* child);
 
+// 子节点预筛: 以父节点下界 (右子节点加上分支 Arc 的定价下界增量) 判断子节点能否改进
+// 当前最优整数解, 不能则直接剪枝 (不做列生成)
+bool PrescreenChild(ProblemParams& params, ProblemData& data, const BPNode* parent,
+    BPNode* child);
+
 // 选择待分支节点 (选择下界最小的未剪枝节点)
 BPNode* SelectBranchNode(BPNode* head);
 
-// 分支定价主循环
-int RunBranchAndPrice(ProblemParams& params, ProblemData& data, BPNode* root);
+// 选择待分支节点 (深度优先，内存超预算时使用)
+BPNode* SelectDeepestNode(BPNode* head);
+
+// 分支定价主循环 (resume 非空时从检查点继续)
+int RunBranchAndPrice(ProblemParams& params, ProblemData& data, BPNode* root,
+    BPCheckpoint* resume = nullptr);
+
+// 未找到整数解时, 以根节点 LP 解向上取整作为可行解
+void RoundRootSolution(ProblemParams& params, const BPNode* root);
+
+// 节点池函数 (node_pool.cpp)
+BPNode* AllocNode(NodePool& pool);
+void ReleaseNode(NodePool& pool, BPNode* node);
+double GetPeakRssMB();
+double GetCurrentRssMB();
+void LogNodePoolStats(const NodePool& pool);
+
+// 节点溢出: 写入节点记录并登记偏移 / 按登记下标读回并移除登记 / 剪掉下界不小于 ub 的登记
+bool SpillNode(NodeSpill& spill, const BPNode& node);
+bool ReloadSpilledNode(NodeSpill& spill, int entry_idx, BPNode& node);
+bool PeekSpilledNode(NodeSpill& spill, int entry_idx, BPNode& node);
+int DropSpilledNodes(NodeSpill& spill, double ub);
+void CloseNodeSpill(NodeSpill& spill);
+
+// 节点序列化 (serialize.cpp)
+// 只写出继续分支所需的字段 (标识、下界、待分支 Arc、累积 Arc 约束、非零列)
+void WriteNodeRecord(ostream& out, const BPNode& node);
+bool ReadNodeRecord(istream& in, BPNode& node);
+
+// 列区间: 写出 [begin, num_cols_) 的列 / 读回并追加到列池末尾 (begin 输出发送方起始列号)
+void WriteColumnRange(ostream& out, const ColumnStore& store, int begin);
+bool ReadColumnRange(istream& in, ColumnStore& store, int& begin);
+
+// 割区间: 写出 cuts[begin..] / 读回并追加到 cuts 末尾 (begin 输出发送方起始下标)
+void WriteCutRange(ostream& out, const vector<RankOneCut>& cuts, int begin);
+bool ReadCutRange(istream& in, vector<RankOneCut>& cuts, int& begin);
+
+// 算例指纹 (预处理后的母板尺寸与子板尺寸/需求)，检查点与分布式握手时校验
+vector<int32_t> InstanceFingerprint(const ProblemParams& params, const ProblemData& data);
+
+// 检查点: 写出 / 读回 (读回须在数据读取、预处理与建网之后)
+bool SaveCheckpoint(const string& path, const ProblemParams& params, const ProblemData& data,
+    const BPNode& root, const vector<const BPNode*>& open_nodes, const BPCheckpoint& stats);
+bool LoadCheckpoint(const string& path, ProblemParams& params, ProblemData& data,
+    BPNode& root, BPCheckpoint& checkpoint);
+
+// 分布式分支定价 (distributed.cpp)
+// 协调进程: 监听 port, 把待分支节点派发给工作进程; 工作进程: 连接 host:port 处理分支任务
+int RunDistributedBP(ProblemParams& params, ProblemData& data, BPNode* root, int port);
+int RunBPWorker(ProblemParams& params, ProblemData& data, const string& address);
 
 // 输出函数 (output.cpp)
 void ExportSolution(ProblemParams& params, ProblemData& data);
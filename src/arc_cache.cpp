@@ -0,0 +1,293 @@
+// arc_cache.cpp - Arc Flow 网络磁盘缓存
+//
+// 同一母板尺寸、同一批子板尺寸的算例反复求解时，SP1 / SP2 网络完全相同
+// 生成网络后写入缓存目录，下次启动按键值直接读取，跳过建网
+//
+// 键值: SP1 = (W, 各条带类型宽度 按条带编号), SP2 = (L, 长度种类 lengths_)
+// 文件名为键值的 FNV-1a 哈希，文件内另存完整键值，读取时逐项比对，哈希碰撞不会读错网络
+//
+// 文件格式 (小端, 全部为 int32):
+//   [头部] 魔数, 版本, 网络类型 (1 = SP1, 2 = SP2), 键值长度 K, Arc 数 A
+//   [键值] K 个整数
+//   [Arc]  A 对 (起点, 终点)
+//   [标签] A 个整数 (SP1: arc_strip_index_, SP2: arc_length_index_)
+// 版本号或格式不符时视为未命中，重新生成并覆盖
+//
+// 读取使用内存映射 (Windows: MapViewOfFile, 其他: mmap)，只拷贝一次到网络数组
+// 节点分类与入出弧列表按 Arc 列表 O(A) 重建，不写入缓存
+
+#include "2DBP.h"
+
+#include <cstring>  // for memcpy
+#include <random>   // for random_device
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+constexpr int32_t kArcCacheMagic = 0x41524343;  // "ARCC"
+constexpr int32_t kArcCacheVersion = 1;         // 格式变化时递增
+constexpr int32_t kArcCacheSP1 = 1;
+constexpr int32_t kArcCacheSP2 = 2;
+constexpr int kArcCacheHeaderSize = 5;          // 头部整数个数
+
+namespace {
+
+// 只读内存映射文件
+class MappedFile {
+public:
+    ~MappedFile() { Close(); }
+
+    bool Open(const string& path) {
+#ifdef _WIN32
+        file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file_, &file_size) || file_size.QuadPart == 0) return false;
+        size_ = static_cast<size_t>(file_size.QuadPart);
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_ == nullptr) return false;
+        data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        return data_ != nullptr;
+#else
+        fd_ = open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) return false;
+        struct stat st;
+        if (fstat(fd_, &st) != 0 || st.st_size == 0) return false;
+        size_ = static_cast<size_t>(st.st_size);
+        void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (addr == MAP_FAILED) return false;
+        data_ = static_cast<const char*>(addr);
+        return true;
+#endif
+    }
+
+    void Close() {
+#ifdef _WIN32
+        if (data_ != nullptr) UnmapViewOfFile(data_);
+        if (mapping_ != nullptr) CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+        mapping_ = nullptr;
+        file_ = INVALID_HANDLE_VALUE;
+#else
+        if (data_ != nullptr) munmap(const_cast<char*>(data_), size_);
+        if (fd_ >= 0) close(fd_);
+        fd_ = -1;
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    const int32_t* Ints() const { return reinterpret_cast<const int32_t*>(data_); }
+    size_t NumInts() const { return size_ / sizeof(int32_t); }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+};
+
+}  // namespace
+
+// 键值的 FNV-1a 哈希 (64 位)，用作文件名
+static uint64_t HashKey(int32_t kind, const vector<int32_t>& key) {
+    uint64_t h = 1469598103934665603ULL;
+    auto mix = [&h](int32_t v) {
+        uint32_t u = static_cast<uint32_t>(v);
+        for (int b = 0; b < 4; b++) {
+            h ^= (u >> (8 * b)) & 0xFF;
+            h *= 1099511628211ULL;
+        }
+    };
+    mix(kArcCacheVersion);
+    mix(kind);
+    for (int32_t v : key) mix(v);
+    return h;
+}
+
+static string CachePath(const string& dir, int32_t kind, const vector<int32_t>& key) {
+    ostringstream oss;
+    oss << (kind == kArcCacheSP1 ? "sp1_" : "sp2_")
+        << hex << setw(16) << setfill('0') << HashKey(kind, key) << ".bin";
+    return (filesystem::path(dir) / oss.str()).string();
+}
+
+static vector<int32_t> SP1Key(const ProblemData& data, const ProblemParams& params) {
+    vector<int32_t> key = {params.stock_width_};
+    for (const auto& strip : data.strip_types_) key.push_back(strip.width_);
+    return key;
+}
+
+static vector<int32_t> SP2Key(const ProblemData& data, const ProblemParams& params) {
+    vector<int32_t> key = {params.stock_length_};
+    key.insert(key.end(), data.sp2_arc_data_.lengths_.begin(), data.sp2_arc_data_.lengths_.end());
+    return key;
+}
+
+// 读取缓存文件: 校验头部与键值后输出 Arc 列表与标签
+static bool ReadCache(const string& path, int32_t kind, const vector<int32_t>& key,
+    vector<array<int, 2>>& arc_list, vector<int>& labels) {
+
+    MappedFile file;
+    if (!file.Open(path)) return false;
+
+    const int32_t* p = file.Ints();
+    size_t n = file.NumInts();
+    if (n < kArcCacheHeaderSize) return false;
+    if (p[0] != kArcCacheMagic || p[1] != kArcCacheVersion || p[2] != kind) return false;
+
+    size_t key_len = static_cast<size_t>(p[3]);
+    size_t num_arcs = static_cast<size_t>(p[4]);
+    if (key_len != key.size()) return false;
+    if (n != kArcCacheHeaderSize + key_len + 3 * num_arcs) return false;
+    if (memcmp(p + kArcCacheHeaderSize, key.data(), key_len * sizeof(int32_t)) != 0) return false;
+
+    const int32_t* arcs = p + kArcCacheHeaderSize + key_len;
+    arc_list.resize(num_arcs);
+    memcpy(arc_list.data(), arcs, num_arcs * 2 * sizeof(int32_t));
+    labels.resize(num_arcs);
+    memcpy(labels.data(), arcs + 2 * num_arcs, num_arcs * sizeof(int32_t));
+    return true;
+}
+
+// 本进程专用的临时文件名: 同时启动的多个进程 (如本机 --worker) 各写各的，不会互相截断
+static string TempCachePath(const string& path) {
+#ifdef _WIN32
+    unsigned long pid = GetCurrentProcessId();
+#else
+    unsigned long pid = static_cast<unsigned long>(getpid());
+#endif
+    random_device rd;
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), ".%lu.%08x.tmp", pid, rd());
+    return path + suffix;
+}
+
+// 写入缓存文件: 先写本进程的临时文件再改名，避免并发运行读到半个文件
+// 改名失败 (另一进程同时写入同一网络) 时丢弃临时文件即可，缓存内容相同
+static void WriteCache(const string& path, int32_t kind, const vector<int32_t>& key,
+    const vector<array<int, 2>>& arc_list, const vector<int>& labels) {
+
+    error_code ec;
+    filesystem::create_directories(filesystem::path(path).parent_path(), ec);
+    if (ec) {
+        LOG_FMT("[Arc缓存] 无法创建缓存目录: %s\n", ec.message().c_str());
+        return;
+    }
+
+    string tmp_path = TempCachePath(path);
+    {
+        ofstream fout(tmp_path, ios::binary | ios::trunc);
+        if (!fout) {
+            LOG_FMT("[Arc缓存] 无法写入: %s\n", tmp_path.c_str());
+            return;
+        }
+        int32_t header[kArcCacheHeaderSize] = {
+            kArcCacheMagic, kArcCacheVersion, kind,
+            static_cast<int32_t>(key.size()), static_cast<int32_t>(arc_list.size())
+        };
+        fout.write(reinterpret_cast<const char*>(header), sizeof(header));
+        fout.write(reinterpret_cast<const char*>(key.data()), key.size() * sizeof(int32_t));
+        fout.write(reinterpret_cast<const char*>(arc_list.data()),
+            arc_list.size() * 2 * sizeof(int32_t));
+        fout.write(reinterpret_cast<const char*>(labels.data()), labels.size() * sizeof(int32_t));
+        if (!fout) {
+            LOG_FMT("[Arc缓存] 写入失败: %s\n", tmp_path.c_str());
+            fout.close();
+            filesystem::remove(tmp_path, ec);
+            return;
+        }
+    }
+
+    filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+        LOG_DEBUG_FMT("[Arc缓存] 改名失败 (%s), 沿用其他进程写入的缓存: %s\n",
+            ec.message().c_str(), path.c_str());
+        filesystem::remove(tmp_path, ec);
+        return;
+    }
+    LOG_FMT("[Arc缓存] 已写入: %s (%d 条Arc)\n", path.c_str(), (int)arc_list.size());
+}
+
+// 由 Arc 列表重建 arc_to_index_
+// 先按端点排序再顺序带提示插入，均摊 O(A)
+static void BuildArcIndex(const vector<array<int, 2>>& arc_list,
+    map<array<int, 2>, int>& arc_to_index) {
+    vector<int> order(arc_list.size());
+    for (int i = 0; i < (int)order.size(); i++) order[i] = i;
+    if (!is_sorted(order.begin(), order.end(),
+            [&](int a, int b) { return arc_list[a] < arc_list[b]; })) {
+        sort(order.begin(), order.end(),
+            [&](int a, int b) { return arc_list[a] < arc_list[b]; });
+    }
+    arc_to_index.clear();
+    for (int idx : order) {
+        arc_to_index.emplace_hint(arc_to_index.end(), arc_list[idx], idx);
+    }
+}
+
+// 读取 SP1 网络缓存，命中时填充 arc_list_ / arc_to_index_ / arc_strip_index_
+bool LoadSP1ArcCache(ProblemData& data, ProblemParams& params) {
+    if (params.arc_cache_dir_.empty()) return false;
+
+    SP1ArcFlowData& arc_data = data.sp1_arc_data_;
+    vector<int32_t> key = SP1Key(data, params);
+    string path = CachePath(params.arc_cache_dir_, kArcCacheSP1, key);
+    if (!ReadCache(path, kArcCacheSP1, key, arc_data.arc_list_, arc_data.arc_strip_index_)) {
+        return false;
+    }
+    BuildArcIndex(arc_data.arc_list_, arc_data.arc_to_index_);
+    LOG_FMT("[Arc缓存] 命中SP1: %s\n", path.c_str());
+    return true;
+}
+
+// 写入 SP1 网络缓存
+void SaveSP1ArcCache(const ProblemData& data, const ProblemParams& params) {
+    if (params.arc_cache_dir_.empty()) return;
+
+    const SP1ArcFlowData& arc_data = data.sp1_arc_data_;
+    vector<int32_t> key = SP1Key(data, params);
+    WriteCache(CachePath(params.arc_cache_dir_, kArcCacheSP1, key), kArcCacheSP1, key,
+        arc_data.arc_list_, arc_data.arc_strip_index_);
+}
+
+// 读取 SP2 网络缓存 (需先确定 lengths_)，命中时填充 arc_list_ / arc_to_index_ / arc_length_index_
+bool LoadSP2ArcCache(ProblemData& data, ProblemParams& params) {
+    if (params.arc_cache_dir_.empty()) return false;
+
+    SP2ArcFlowData& arc_data = data.sp2_arc_data_;
+    vector<int32_t> key = SP2Key(data, params);
+    string path = CachePath(params.arc_cache_dir_, kArcCacheSP2, key);
+    if (!ReadCache(path, kArcCacheSP2, key, arc_data.arc_list_, arc_data.arc_length_index_)) {
+        return false;
+    }
+    BuildArcIndex(arc_data.arc_list_, arc_data.arc_to_index_);
+    LOG_FMT("[Arc缓存] 命中SP2: %s\n", path.c_str());
+    return true;
+}
+
+// 写入 SP2 网络缓存
+void SaveSP2ArcCache(const ProblemData& data, const ProblemParams& params) {
+    if (params.arc_cache_dir_.empty()) return;
+
+    const SP2ArcFlowData& arc_data = data.sp2_arc_data_;
+    vector<int32_t> key = SP2Key(data, params);
+    WriteCache(CachePath(params.arc_cache_dir_, kArcCacheSP2, key), kArcCacheSP2, key,
+        arc_data.arc_list_, arc_data.arc_length_index_);
+}
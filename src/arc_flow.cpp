@@ -9,8 +9,6 @@
 
 #include "2DBP.h"
 
-#include <climits>  // for INT_MAX
-
 using namespace std;
 
 // 生成 SP1 的 Arc Flow 网络 (宽度方向)
@@ -28,6 +26,9 @@ void GenerateSP1Arcs(ProblemData& data, ProblemParams& params) {
     // 清空现有数据，准备重新生成
     arc_data.arc_list_.clear();
     arc_data.arc_to_index_.clear();
+    arc_data.arc_strip_index_.clear();
+    arc_data.arc_duals_.clear();
+    arc_data.touched_arcs_.clear();
     arc_data.begin_nodes_.clear();
     arc_data.end_nodes_.clear();
     arc_data.mid_nodes_.clear();
@@ -46,44 +47,57 @@ void GenerateSP1Arcs(ProblemData& data, ProblemParams& params) {
         node_set.insert(t);
     }
 
-    // 1. 生成物品弧 A^{item}
-    // 对于每个起点位置 start，尝试放置每种条带
+    // 相同 (W, 条带宽度) 的网络可直接从磁盘缓存读取
     int num_item_arcs = 0;
-    for (int start = 0; start < stock_width; start++) {
-        for (int j = 0; j < num_strip_types; j++) {
-            int strip_width = data.strip_types_[j].width_;
-            int end = start + strip_width;
-
-            // 检查终点是否超出母板宽度
-            if (end <= stock_width) {
-                array<int, 2> arc = {start, end};
-
-                // 避免重复添加相同的 Arc
-                // 不同条带类型可能有相同宽度，会产生相同的 Arc
-                if (arc_data.arc_to_index_.find(arc) == arc_data.arc_to_index_.end()) {
-                    int idx = static_cast<int>(arc_data.arc_list_.size());
-                    arc_data.arc_to_index_[arc] = idx;
-                    arc_data.arc_list_.push_back(arc);
-                    num_item_arcs++;
+    int num_loss_arcs = 0;
+    bool cached = LoadSP1ArcCache(data, params);
+    if (!cached) {
+        // 1. 生成物品弧 A^{item}
+        // 对于每个起点位置 start，尝试放置每种条带
+        for (int start = 0; start < stock_width; start++) {
+            for (int j = 0; j < num_strip_types; j++) {
+                int strip_width = data.strip_types_[j].width_;
+                int end = start + strip_width;
+
+                // 检查终点是否超出母板宽度
+                if (end <= stock_width) {
+                    array<int, 2> arc = {start, end};
+
+                    // 避免重复添加相同的 Arc
+                    // 不同条带类型可能有相同宽度，会产生相同的 Arc
+                    if (arc_data.arc_to_index_.find(arc) == arc_data.arc_to_index_.end()) {
+                        int idx = static_cast<int>(arc_data.arc_list_.size());
+                        arc_data.arc_to_index_[arc] = idx;
+                        arc_data.arc_list_.push_back(arc);
+                        num_item_arcs++;
+                    }
                 }
             }
         }
-    }
 
-    // 2. 生成损耗弧 A^{loss} = {(t, t+1) : t = 0, ..., W-1}
-    // 损耗弧保证 Arc-Flow 与 "<=" 背包严格等价
-    int num_loss_arcs = 0;
-    for (int t = 0; t < stock_width; t++) {
-        array<int, 2> loss_arc = {t, t + 1};
+        // 2. 生成损耗弧 A^{loss} = {(t, t+1) : t = 0, ..., W-1}
+        // 损耗弧保证 Arc-Flow 与 "<=" 背包严格等价
+        for (int t = 0; t < stock_width; t++) {
+            array<int, 2> loss_arc = {t, t + 1};
+
+            // 损耗弧可能与某些长度为1的物品弧重合，需检查
+            if (arc_data.arc_to_index_.find(loss_arc) == arc_data.arc_to_index_.end()) {
+                int idx = static_cast<int>(arc_data.arc_list_.size());
+                arc_data.arc_to_index_[loss_arc] = idx;
+                arc_data.arc_list_.push_back(loss_arc);
+                num_loss_arcs++;
+            }
+        }
 
-        // 损耗弧可能与某些长度为1的物品弧重合，需检查
-        if (arc_data.arc_to_index_.find(loss_arc) == arc_data.arc_to_index_.end()) {
-            int idx = static_cast<int>(arc_data.arc_list_.size());
-            arc_data.arc_to_index_[loss_arc] = idx;
-            arc_data.arc_list_.push_back(loss_arc);
-            num_loss_arcs++;
+        // 预计算每条 Arc 的条带类型标签 (定价时按下标读取，不再查 map)
+        // 损耗弧若与宽度为1的物品弧重合，则视为物品弧
+        arc_data.arc_strip_index_.resize(arc_data.arc_list_.size());
+        for (int idx = 0; idx < static_cast<int>(arc_data.arc_list_.size()); idx++) {
+            int arc_width = arc_data.arc_list_[idx][1] - arc_data.arc_list_[idx][0];
+            arc_data.arc_strip_index_[idx] = LookupSizeTable(data.width_to_strip_table_, arc_width);
         }
     }
+    arc_data.arc_duals_.assign(arc_data.arc_list_.size(), 0.0);
 
     // 将节点分为三类: 起点、终点、中间节点
     arc_data.begin_nodes_.push_back(0);
@@ -101,7 +115,13 @@ void GenerateSP1Arcs(ProblemData& data, ProblemParams& params) {
     arc_data.mid_in_arcs_.resize(num_mid);
     arc_data.mid_out_arcs_.resize(num_mid);
 
-    // 遍历所有 Arc，将其分类到对应的列表中
+    // 位置 -> 中间节点下标 (-1 表示起点/终点)
+    vector<int> mid_index(stock_width + 1, -1);
+    for (int i = 0; i < num_mid; i++) {
+        mid_index[arc_data.mid_nodes_[i]] = i;
+    }
+
+    // 遍历所有 Arc，将其分类到对应的列表中 (按位置直接定位中间节点, O(Arc数))
     for (int idx = 0; idx < static_cast<int>(arc_data.arc_list_.size()); idx++) {
         int start = arc_data.arc_list_[idx][0];
         int end = arc_data.arc_list_[idx][1];
@@ -117,117 +137,117 @@ void GenerateSP1Arcs(ProblemData& data, ProblemParams& params) {
         }
 
         // 对于中间节点，记录其入弧和出弧
-        for (int i = 0; i < num_mid; i++) {
-            int mid_node = arc_data.mid_nodes_[i];
-            if (end == mid_node) {
-                arc_data.mid_in_arcs_[i].push_back(idx);  // 该 Arc 进入中间节点 i
-            }
-            if (start == mid_node) {
-                arc_data.mid_out_arcs_[i].push_back(idx); // 该 Arc 离开中间节点 i
-            }
+        if (mid_index[end] >= 0) {
+            arc_data.mid_in_arcs_[mid_index[end]].push_back(idx);     // 该 Arc 进入中间节点
+        }
+        if (mid_index[start] >= 0) {
+            arc_data.mid_out_arcs_[mid_index[start]].push_back(idx);  // 该 Arc 离开中间节点
         }
     }
 
     LOG_FMT("  节点数: %d (起点1, 终点1, 中间%d)\n",
         (int)node_set.size(), num_mid);
-    LOG_FMT("  Arc数: %d (物品弧%d, 损耗弧%d)\n",
-        (int)arc_data.arc_list_.size(), num_item_arcs, num_loss_arcs);
+    if (cached) {
+        LOG_FMT("  Arc数: %d (缓存)\n", (int)arc_data.arc_list_.size());
+    } else {
+        LOG_FMT("  Arc数: %d (物品弧%d, 损耗弧%d)\n",
+            (int)arc_data.arc_list_.size(), num_item_arcs, num_loss_arcs);
+        SaveSP1ArcCache(data, params);
+    }
 }
 
 // 生成 SP2 的 Arc Flow 网络 (长度方向)
-// 每种条带类型有独立的 SP2 网络，因为不同条带可放置不同的子板
+// 所有条带类型共享一个基础网络: 各条带的网络都覆盖 0..L, 只在允许放入的子板上不同
 // 网络结构 (符合数学模型 Section 7.4):
 //   节点: 条带长度方向上的位置 (0 到 stock_length)
-//   物品弧 A^{item}: 放置一种子板，Arc 长度等于子板长度
+//   物品弧 A^{item}: 放置一种子板，Arc 长度等于子板长度 (按全部子板长度生成)
 //   损耗弧 A^{loss}: (t, t+1) 表示浪费1单位长度，保证与背包等价
-// 约束: 只有宽度不超过条带宽度的子板才能放入该条带
-void GenerateSP2Arcs(ProblemData& data, ProblemParams& params, int strip_type_id) {
-    LOG_FMT("[Arc Flow] 生成SP2网络 (条带类型%d, 含loss arcs)\n", strip_type_id);
-
-    // 确保 sp2_arc_data_ 数组足够大
-    while ((int)data.sp2_arc_data_.size() <= strip_type_id) {
-        data.sp2_arc_data_.push_back(SP2ArcFlowData());
-    }
+// 每条 Arc 只记录长度种类, 条带类型 j 上对应的子板由 sp2_strip_data_[j].length_items_ 给出
+// 约束 "子板宽度不超过条带宽度" 在定价时按条带类型过滤 (见 SP2ArcAllowed)
+void GenerateSP2Arcs(ProblemData& data, ProblemParams& params) {
+    LOG("[Arc Flow] 生成SP2共享网络 (含loss arcs)");
 
-    SP2ArcFlowData& arc_data = data.sp2_arc_data_[strip_type_id];
-    arc_data.strip_type_id_ = strip_type_id;
+    SP2ArcFlowData& arc_data = data.sp2_arc_data_;
 
     // 清空现有数据
-    arc_data.arc_list_.clear();
-    arc_data.arc_to_index_.clear();
-    arc_data.begin_nodes_.clear();
-    arc_data.end_nodes_.clear();
-    arc_data.mid_nodes_.clear();
-    arc_data.begin_arc_indices_.clear();
-    arc_data.end_arc_indices_.clear();
-    arc_data.mid_in_arcs_.clear();
-    arc_data.mid_out_arcs_.clear();
+    arc_data = SP2ArcFlowData();
 
     int stock_length = params.stock_length_;
-    int strip_width = data.strip_types_[strip_type_id].width_;
     int num_item_types = params.num_item_types_;
+    int num_strip_types = params.num_strip_types_;
 
-    // 收集所有可能的节点位置
-    // 有了 loss arcs 后，所有位置 0..stock_length 都是有效节点
-    set<int> node_set;
-    for (int t = 0; t <= stock_length; t++) {
-        node_set.insert(t);
+    // Arc 长度种类: 能放入条带的子板长度去重, 无长度为1的子板时追加损耗弧长度
+    set<int> length_set;
+    for (int i = 0; i < num_item_types; i++) {
+        if (data.item_types_[i].length_ <= stock_length) {
+            length_set.insert(data.item_types_[i].length_);
+        }
+    }
+    length_set.insert(1);
+    arc_data.lengths_.assign(length_set.begin(), length_set.end());
+    int num_kinds = static_cast<int>(arc_data.lengths_.size());
+
+    // 长度 -> 长度种类下标
+    map<int, int> length_index;
+    for (int d = 0; d < num_kinds; d++) {
+        length_index[arc_data.lengths_[d]] = d;
     }
 
-    // 1. 生成物品弧 A^{item} (仅考虑宽度匹配的子板)
-    int num_item_arcs = 0;
-    for (int start = 0; start < stock_length; start++) {
+    // 各条带类型: 每种长度对应的子板 (同长度取第一个宽度合适的子板, -1 表示该条带不可放)
+    data.sp2_strip_data_.assign(num_strip_types, SP2StripData());
+    for (int j = 0; j < num_strip_types; j++) {
+        int strip_width = data.strip_types_[j].width_;
+        auto& length_items = data.sp2_strip_data_[j].length_items_;
+        length_items.assign(num_kinds, -1);
         for (int i = 0; i < num_item_types; i++) {
-            int item_width = data.item_types_[i].width_;
-            int item_length = data.item_types_[i].length_;
-
-            // 关键条件: 子板宽度必须不超过条带宽度
-            // 这是两阶段切割的约束，子板只能放入宽度匹配的条带
-            if (item_width <= strip_width) {
-                int end = start + item_length;
+            const auto& item = data.item_types_[i];
+            if (item.width_ > strip_width || item.length_ > stock_length) continue;
+            int d = length_index[item.length_];
+            if (length_items[d] < 0) length_items[d] = i;
+        }
+    }
 
-                // 检查终点是否超出条带长度
-                if (end <= stock_length) {
-                    array<int, 2> arc = {start, end};
+    // 条带长度: 显式与隐式网络都需要 (标签定价按位置 0..L 建标签桶)
+    arc_data.capacity_ = stock_length;
 
-                    // 避免重复添加相同的 Arc
-                    if (arc_data.arc_to_index_.find(arc) == arc_data.arc_to_index_.end()) {
-                        int idx = static_cast<int>(arc_data.arc_list_.size());
-                        arc_data.arc_to_index_[arc] = idx;
-                        arc_data.arc_list_.push_back(arc);
-                        num_item_arcs++;
-                    }
-                }
-            }
-        }
+    // 长条带: 隐式网络, Arc 编号 = 起点 * 种类数 + 长度种类
+    if (stock_length > kImplicitArcMinLength) {
+        arc_data.implicit_ = true;
+        LOG_FMT("  隐式网络: L=%d, Arc种类数: %d\n", stock_length, num_kinds);
+        return;
     }
 
-    // 2. 生成损耗弧 A^{loss} = {(t, t+1) : t = 0, ..., L-1}
-    // 损耗弧保证 Arc-Flow 与 "<=" 背包严格等价
+    // 1. 物品弧与损耗弧: 每个起点按长度种类生成 (长度为1的种类兼作损耗弧)
+    // 相同 (L, 长度种类) 的网络可直接从磁盘缓存读取
+    int num_item_arcs = 0;
     int num_loss_arcs = 0;
-    for (int t = 0; t < stock_length; t++) {
-        array<int, 2> loss_arc = {t, t + 1};
+    bool cached = LoadSP2ArcCache(data, params);
+    for (int start = 0; start < stock_length && !cached; start++) {
+        for (int d = 0; d < num_kinds; d++) {
+            int end = start + arc_data.lengths_[d];
+            if (end > stock_length) break;  // 长度升序
 
-        // 损耗弧可能与某些长度为1的物品弧重合，需检查
-        if (arc_data.arc_to_index_.find(loss_arc) == arc_data.arc_to_index_.end()) {
+            array<int, 2> arc = {start, end};
             int idx = static_cast<int>(arc_data.arc_list_.size());
-            arc_data.arc_to_index_[loss_arc] = idx;
-            arc_data.arc_list_.push_back(loss_arc);
-            num_loss_arcs++;
+            arc_data.arc_to_index_.emplace_hint(arc_data.arc_to_index_.end(), arc, idx);
+            arc_data.arc_list_.push_back(arc);
+            arc_data.arc_length_index_.push_back(d);
+            if (arc_data.lengths_[d] == 1) {
+                num_loss_arcs++;
+            } else {
+                num_item_arcs++;
+            }
         }
     }
 
-    // 分类节点
+    // 2. 分类节点 (所有位置 0..L 都是有效节点)
     arc_data.begin_nodes_.push_back(0);
     arc_data.end_nodes_.push_back(stock_length);
-
-    for (int node : node_set) {
-        if (node != 0 && node != stock_length) {
-            arc_data.mid_nodes_.push_back(node);
-        }
+    for (int node = 1; node < stock_length; node++) {
+        arc_data.mid_nodes_.push_back(node);
     }
 
-    // 为中间节点建立入弧和出弧列表
+    // 为中间节点建立入弧和出弧列表 (中间节点 i 即位置 i+1, 按位置直接定位)
     int num_mid = static_cast<int>(arc_data.mid_nodes_.size());
     arc_data.mid_in_arcs_.resize(num_mid);
     arc_data.mid_out_arcs_.resize(num_mid);
@@ -238,45 +258,456 @@ void GenerateSP2Arcs(ProblemData& data, ProblemParams& params, int strip_type_id
 
         if (start == 0) {
             arc_data.begin_arc_indices_.push_back(idx);
+        } else {
+            arc_data.mid_out_arcs_[start - 1].push_back(idx);
         }
 
         if (end == stock_length) {
             arc_data.end_arc_indices_.push_back(idx);
-        }
-
-        for (int i = 0; i < num_mid; i++) {
-            int mid_node = arc_data.mid_nodes_[i];
-            if (end == mid_node) {
-                arc_data.mid_in_arcs_[i].push_back(idx);
-            }
-            if (start == mid_node) {
-                arc_data.mid_out_arcs_[i].push_back(idx);
-            }
+        } else {
+            arc_data.mid_in_arcs_[end - 1].push_back(idx);
         }
     }
 
-    LOG_FMT("  节点数: %d, Arc数: %d (物品弧%d, 损耗弧%d)\n",
-        (int)node_set.size(), (int)arc_data.arc_list_.size(),
-        num_item_arcs, num_loss_arcs);
+    if (cached) {
+        LOG_FMT("  节点数: %d, Arc数: %d (缓存), 条带类型数: %d\n",
+            stock_length + 1, (int)arc_data.arc_list_.size(), num_strip_types);
+    } else {
+        LOG_FMT("  节点数: %d, Arc数: %d (物品弧%d, 损耗弧%d), 条带类型数: %d\n",
+            stock_length + 1, (int)arc_data.arc_list_.size(),
+            num_item_arcs, num_loss_arcs, num_strip_types);
+        SaveSP2ArcCache(data, params);
+    }
 }
 
 // 生成所有 Arc Flow 网络
-// 包括一个 SP1 网络和多个 SP2 网络 (每种条带类型一个)
+// 包括一个 SP1 网络和一个各条带类型共享的 SP2 网络
 void GenerateAllArcs(ProblemData& data, ProblemParams& params) {
+    PROFILE_ZONE("arcs.generate");
+
     LOG("[Arc Flow] 生成所有网络");
 
     // SP1 网络 (宽度方向，母板 -> 条带)
     GenerateSP1Arcs(data, params);
 
     // SP2 网络 (长度方向，条带 -> 子板)
-    // 每种条带类型有独立的网络
-    for (int j = 0; j < params.num_strip_types_; j++) {
-        GenerateSP2Arcs(data, params, j);
-    }
+    // 所有条带类型共享, 条带差异在定价时按 sp2_strip_data_ 过滤
+    GenerateSP2Arcs(data, params);
 
     LOG("[Arc Flow] 网络生成完成");
 }
 
+// 查找 Arc 分支行所在网络中的 Arc 编号
+// strip_type = -1 表示 SP1 网络，否则为 SP2 条带类型
+// 返回 -1 表示该 Arc 不在网络中 (此时其对偶价格不影响定价)
+int FindArcIndex(ProblemData& data, int strip_type, const array<int, 2>& arc) {
+    if (strip_type >= static_cast<int>(data.sp2_strip_data_.size())) {
+        return -1;
+    }
+    if (strip_type >= 0) {
+        return GetSP2ArcId(data.sp2_arc_data_, arc);
+    }
+    const auto& arc_to_index = data.sp1_arc_data_.arc_to_index_;
+    auto it = arc_to_index.find(arc);
+    return (it != arc_to_index.end()) ? it->second : -1;
+}
+
+// SP2 Arc 端点 -> 编号
+// 隐式网络: 编号 = 起点 * 种类数 + 种类 (按长度二分查找种类)
+int GetSP2ArcId(const SP2ArcFlowData& arc_data, const array<int, 2>& arc) {
+    if (!arc_data.implicit_) {
+        auto it = arc_data.arc_to_index_.find(arc);
+        return (it != arc_data.arc_to_index_.end()) ? it->second : -1;
+    }
+    int start = arc[0];
+    int length = arc[1] - arc[0];
+    if (start < 0 || length <= 0 || arc[1] > arc_data.capacity_) return -1;
+    const auto& lengths = arc_data.lengths_;
+    auto it = lower_bound(lengths.begin(), lengths.end(), length);
+    if (it == lengths.end() || *it != length) return -1;
+    int num_kinds = static_cast<int>(lengths.size());
+    return start * num_kinds + static_cast<int>(it - lengths.begin());
+}
+
+// SP2 Arc 编号 -> 端点
+array<int, 2> GetSP2Arc(const SP2ArcFlowData& arc_data, int arc_id) {
+    if (!arc_data.implicit_) {
+        return arc_data.arc_list_[arc_id];
+    }
+    int num_kinds = static_cast<int>(arc_data.lengths_.size());
+    int start = arc_id / num_kinds;
+    return {start, start + arc_data.lengths_[arc_id % num_kinds]};
+}
+
+// 当前线程的路径定价缓冲区 (根节点流水线定价线程与主线程各一份)
+PathWorkspace& ThreadPathWorkspace() {
+    thread_local PathWorkspace ws;
+    return ws;
+}
+
+// 隐式 SP2 网络最长路定价
+// 网络为 DAG (0 .. L)，按起点升序扫描，best[p] 为到达位置 p 的最大收益
+// Arc 收益 = 子板对偶价格 π_i (损耗弧为 0) + 分支行对偶价格 μ_a，禁用 Arc 及该条带不可用的 Arc 跳过
+// 扫描顺序与 Arc 编号顺序一致，禁用集合与 μ_a 均按编号有序，用单调指针合并，无需查找
+// 时间 O(L x 种类数)，内存 O(L)
+double SolveSP2ImplicitPath(const SP2ArcFlowData& arc_data, const SP2StripData& strip_data,
+    const vector<double>& profits, const vector<int>& forbidden,
+    vector<int>& pattern, vector<int>& arc_ids, PathWorkspace& ws) {
+
+    int capacity = arc_data.capacity_;
+    int num_kinds = static_cast<int>(arc_data.lengths_.size());
+    const auto& length_items = strip_data.length_items_;
+
+    // 该条带可用的长度种类及其收益
+    vector<int>& kinds = ws.kinds_;
+    vector<double>& kind_profit = ws.kind_profit_;
+    kinds.clear();
+    kind_profit.assign(num_kinds, 0.0);
+    for (int k = 0; k < num_kinds; k++) {
+        if (length_items[k] >= 0) {
+            kind_profit[k] = profits[length_items[k]];
+        } else if (arc_data.lengths_[k] != 1) {
+            continue;
+        }
+        kinds.push_back(k);
+    }
+
+    const double kUnreached = -INFINITY;
+    vector<double>& best = ws.best_;
+    vector<int>& pred_arc = ws.pred_arc_;       // 到达该位置的最优入弧编号
+    best.assign(capacity + 1, kUnreached);
+    pred_arc.assign(capacity + 1, -1);
+    best[0] = 0.0;
+
+    auto forbid_it = forbidden.begin();
+    auto dual_it = strip_data.arc_duals_.begin();
+    for (int start = 0; start < capacity; start++) {
+        if (best[start] == kUnreached) continue;
+        for (int k : kinds) {
+            int end = start + arc_data.lengths_[k];
+            if (end > capacity) break;  // 种类按长度升序
+
+            int id = start * num_kinds + k;
+            while (forbid_it != forbidden.end() && *forbid_it < id) ++forbid_it;
+            if (forbid_it != forbidden.end() && *forbid_it == id) continue;
+
+            double profit = kind_profit[k];
+            while (dual_it != strip_data.arc_duals_.end() && dual_it->first < id) ++dual_it;
+            if (dual_it != strip_data.arc_duals_.end() && dual_it->first == id) {
+                profit += dual_it->second;
+            }
+
+            if (best[start] + profit > best[end]) {
+                best[end] = best[start] + profit;
+                pred_arc[end] = id;
+            }
+        }
+    }
+
+    pattern.assign(profits.size(), 0);
+    arc_ids.clear();
+    if (best[capacity] == kUnreached) return kUnreached;
+
+    for (int pos = capacity; pos > 0;) {
+        int id = pred_arc[pos];
+        int k = id % num_kinds;
+        arc_ids.push_back(id);
+        if (length_items[k] >= 0) pattern[length_items[k]]++;
+        pos -= arc_data.lengths_[k];
+    }
+    reverse(arc_ids.begin(), arc_ids.end());
+    return best[capacity];
+}
+
+// SP2 标签定价 (节点 RMP 含秩1割)
+// 割 c = (S, q) 的列系数 ceil(Σ_{i∈S} a_i / q) 不能拆到 Arc 上, 最长路 DP 不再精确:
+//   标签 = (位置, 收益, 各割已放入 S 中子板数 mod q), 放入 S 中子板且余数为 0 时收益加 ρ_c
+// 支配: 同一位置上, A 的收益减去 A 余数较差的各割 ρ_c 之和仍不小于 B 的收益时 A 支配 B
+//   余数优劣: 0 最好 (下一个即得 ρ_c), 其余越接近 q 越好; 两标签此后得到 ρ_c 的次数至多差 1
+// Arc 按起点升序、同起点内编号升序遍历, 禁用 Arc 与 μ_a 的合并方式同 SolveSP2ImplicitPath
+// 显式网络的 arc_list_ 按起点升序生成 (缓存读取时顺序不变), 直接顺序扫描
+double SolveSP2LabelPath(const SP2ArcFlowData& arc_data, const SP2StripData& strip_data,
+    const vector<double>& profits, const vector<int>& forbidden,
+    const vector<const RankOneCut*>& cuts, const vector<double>& cut_duals,
+    vector<int>& pattern, vector<int>& arc_ids, PathWorkspace& ws) {
+
+    int capacity = arc_data.capacity_;
+    int num_kinds = static_cast<int>(arc_data.lengths_.size());
+    int num_cuts = static_cast<int>(cuts.size());
+    const auto& length_items = strip_data.length_items_;
+
+    // 各长度种类: 是否可用、子板收益、子板所在的割
+    vector<int>& kinds = ws.kinds_;
+    vector<char>& kind_allowed = ws.kind_allowed_;
+    vector<double>& kind_profit = ws.kind_profit_;
+    vector<vector<int>>& kind_cuts = ws.kind_cuts_;
+    kinds.clear();
+    kind_allowed.assign(num_kinds, 0);
+    kind_profit.assign(num_kinds, 0.0);
+    if ((int)kind_cuts.size() < num_kinds) kind_cuts.resize(num_kinds);
+    for (int k = 0; k < num_kinds; k++) {
+        kind_cuts[k].clear();
+        int item = length_items[k];
+        if (item >= 0) {
+            kind_profit[k] = profits[item];
+            for (int c = 0; c < num_cuts; c++) {
+                const auto& items = cuts[c]->items_;
+                if (binary_search(items.begin(), items.end(), item)) kind_cuts[k].push_back(c);
+            }
+        } else if (arc_data.lengths_[k] != 1) {
+            continue;
+        }
+        kind_allowed[k] = 1;
+        kinds.push_back(k);
+    }
+
+    // 标签池: 收益、前驱标签、入弧编号, 余数按标签连续存放 (每个标签 num_cuts 项)
+    // 标签池与各位置的标签桶在工作区中复用, 只清空不释放
+    vector<double>& label_profit = ws.label_profit_;
+    vector<int>& label_pred = ws.label_pred_;
+    vector<int>& label_arc = ws.label_arc_;
+    vector<uint8_t>& label_res = ws.label_res_;
+    vector<vector<int>>& buckets = ws.buckets_;         // 各位置上未被支配的标签
+    label_profit.assign(1, 0.0);
+    label_pred.assign(1, -1);
+    label_arc.assign(1, -1);
+    label_res.assign(num_cuts, 0);
+    if ((int)buckets.size() < capacity + 1) buckets.resize(capacity + 1);
+    for (int pos = 0; pos <= capacity; pos++) buckets[pos].clear();
+    buckets[0].push_back(0);
+
+    auto rank = [&](int c, int r) { return r == 0 ? cuts[c]->denom_ : r; };
+    auto dominates = [&](int a, int b) {
+        double slack = label_profit[a] - label_profit[b];
+        if (slack < 0) return false;
+        const uint8_t* res_a = label_res.data() + static_cast<size_t>(a) * num_cuts;
+        const uint8_t* res_b = label_res.data() + static_cast<size_t>(b) * num_cuts;
+        for (int c = 0; c < num_cuts; c++) {
+            if (rank(c, res_a[c]) < rank(c, res_b[c])) {
+                slack -= cut_duals[c];
+                if (slack < 0) return false;
+            }
+        }
+        return true;
+    };
+
+    // 在 end 位置加入新标签 (已写入标签池末尾): 被支配则丢弃, 否则删去被它支配的标签
+    auto settle_label = [&](int end) {
+        int label = static_cast<int>(label_profit.size()) - 1;
+        auto& bucket = buckets[end];
+        for (int other : bucket) {
+            if (dominates(other, label)) {
+                label_profit.pop_back();
+                label_pred.pop_back();
+                label_arc.pop_back();
+                label_res.resize(label_res.size() - num_cuts);
+                return;
+            }
+        }
+        bucket.erase(remove_if(bucket.begin(), bucket.end(),
+            [&](int other) { return dominates(label, other); }), bucket.end());
+        bucket.push_back(label);
+    };
+
+    // 本起点出发的 Arc (编号, 长度种类)
+    vector<pair<int, int>>& out_arcs = ws.out_arcs_;
+    vector<uint8_t>& res = ws.res_;
+    vector<int>& labels = ws.labels_;
+    res.assign(num_cuts, 0);
+    int num_list_arcs = arc_data.implicit_ ? 0 : static_cast<int>(arc_data.arc_list_.size());
+    int next_arc = 0;
+
+    auto forbid_it = forbidden.begin();
+    auto dual_it = strip_data.arc_duals_.begin();
+    for (int start = 0; start < capacity; start++) {
+        if (buckets[start].empty()) continue;
+
+        out_arcs.clear();
+        if (arc_data.implicit_) {
+            for (int k : kinds) {
+                if (start + arc_data.lengths_[k] > capacity) break;  // 种类按长度升序
+                out_arcs.push_back({start * num_kinds + k, k});
+            }
+        } else {
+            while (next_arc < num_list_arcs && arc_data.arc_list_[next_arc][0] < start) next_arc++;
+            for (; next_arc < num_list_arcs && arc_data.arc_list_[next_arc][0] == start; next_arc++) {
+                int k = arc_data.arc_length_index_[next_arc];
+                if (kind_allowed[k]) out_arcs.push_back({next_arc, k});
+            }
+        }
+
+        labels.swap(buckets[start]);
+        buckets[start].clear();
+        for (const auto& [id, k] : out_arcs) {
+            while (forbid_it != forbidden.end() && *forbid_it < id) ++forbid_it;
+            if (forbid_it != forbidden.end() && *forbid_it == id) continue;
+
+            double profit = kind_profit[k];
+            while (dual_it != strip_data.arc_duals_.end() && dual_it->first < id) ++dual_it;
+            if (dual_it != strip_data.arc_duals_.end() && dual_it->first == id) {
+                profit += dual_it->second;
+            }
+
+            int end = start + arc_data.lengths_[k];
+            for (int label : labels) {
+                double new_profit = label_profit[label] + profit;
+                copy_n(label_res.begin() + static_cast<size_t>(label) * num_cuts, num_cuts,
+                    res.begin());
+                for (int c : kind_cuts[k]) {
+                    if (res[c] == 0) new_profit += cut_duals[c];
+                    res[c] = static_cast<uint8_t>((res[c] + 1) % cuts[c]->denom_);
+                }
+                label_res.insert(label_res.end(), res.begin(), res.end());
+                label_profit.push_back(new_profit);
+                label_pred.push_back(label);
+                label_arc.push_back(id);
+                settle_label(end);
+            }
+        }
+    }
+
+    pattern.assign(profits.size(), 0);
+    arc_ids.clear();
+    int best = -1;
+    for (int label : buckets[capacity]) {
+        if (best < 0 || label_profit[label] > label_profit[best]) best = label;
+    }
+    if (best < 0) return -INFINITY;
+
+    for (int label = best; label_pred[label] >= 0; label = label_pred[label]) {
+        int id = label_arc[label];
+        int item = GetSP2ArcItem(arc_data, strip_data, id);
+        arc_ids.push_back(id);
+        if (item >= 0) pattern[item]++;
+    }
+    reverse(arc_ids.begin(), arc_ids.end());
+    return label_profit[best];
+}
+
+// 经过指定 Arc 的最长路 (子节点预筛的定价下界使用)
+// for_each_out(start, visit) 对从 start 出发的每条 Arc 调用 visit(终点, 收益)
+// 前向 best[p] = 0 -> p 的最大收益，后向 rest[p] = p -> capacity 的最大收益，
+// 结果为 best[起点] + 收益 + rest[终点]；没有路径经过该 Arc 时返回 -INFINITY
+template <typename ForEachOut>
+static double LongestPathThrough(int capacity, const array<int, 2>& arc, double arc_profit,
+    ForEachOut for_each_out) {
+    const double kUnreached = -INFINITY;
+    vector<double> best(capacity + 1, kUnreached);
+    vector<double> rest(capacity + 1, kUnreached);
+    best[0] = 0.0;
+    rest[capacity] = 0.0;
+
+    for (int start = 0; start < arc[0]; start++) {
+        if (best[start] == kUnreached) continue;
+        for_each_out(start, [&](int end, double profit) {
+            best[end] = max(best[end], best[start] + profit);
+        });
+    }
+    for (int start = capacity - 1; start >= arc[1]; start--) {
+        for_each_out(start, [&](int end, double profit) {
+            if (rest[end] != kUnreached) rest[start] = max(rest[start], profit + rest[end]);
+        });
+    }
+
+    if (best[arc[0]] == kUnreached || rest[arc[1]] == kUnreached) return kUnreached;
+    return best[arc[0]] + arc_profit + rest[arc[1]];
+}
+
+// 经过 SP1 Arc arc_idx 的最优切割方案的收益
+// Arc 收益与 SP1 定价相同: 条带对偶价格 v_j (损耗弧为 0) + arc_duals_ 中的分支行对偶价格
+double SP1PathValueThrough(const SP1ArcFlowData& arc_data, const vector<double>& duals,
+    int arc_idx) {
+    int capacity = arc_data.end_nodes_[0];
+    int num_arcs = static_cast<int>(arc_data.arc_list_.size());
+
+    // Arc 列表先物品弧后损耗弧，不按起点有序，先按起点分组
+    vector<double> arc_profit(num_arcs);
+    vector<vector<int>> out_arcs(capacity);
+    for (int a = 0; a < num_arcs; a++) {
+        int strip_idx = arc_data.arc_strip_index_[a];
+        arc_profit[a] = (strip_idx >= 0 ? duals[strip_idx] : 0.0) + arc_data.arc_duals_[a];
+        out_arcs[arc_data.arc_list_[a][0]].push_back(a);
+    }
+
+    return LongestPathThrough(capacity, arc_data.arc_list_[arc_idx], arc_profit[arc_idx],
+        [&](int start, auto visit) {
+            for (int a : out_arcs[start]) visit(arc_data.arc_list_[a][1], arc_profit[a]);
+        });
+}
+
+// 经过 SP2 Arc arc_id 的最优切割方案的收益 (不含割收益)
+// 参数与 Arc 收益同 SolveSP2ImplicitPath，显式与隐式网络均可使用
+double SP2PathValueThrough(const SP2ArcFlowData& arc_data, const SP2StripData& strip_data,
+    const vector<double>& profits, int arc_id) {
+    if (!SP2ArcAllowed(arc_data, strip_data, arc_id)) return -INFINITY;
+
+    auto arc_profit = [&](int id) {
+        int item = GetSP2ArcItem(arc_data, strip_data, id);
+        double profit = item >= 0 ? profits[item] : 0.0;
+        auto it = strip_data.arc_duals_.find(id);
+        return it != strip_data.arc_duals_.end() ? profit + it->second : profit;
+    };
+
+    int capacity = arc_data.capacity_;
+    array<int, 2> arc = GetSP2Arc(arc_data, arc_id);
+    if (arc_data.implicit_) {
+        int num_kinds = static_cast<int>(arc_data.lengths_.size());
+        return LongestPathThrough(capacity, arc, arc_profit(arc_id),
+            [&](int start, auto visit) {
+                for (int k = 0; k < num_kinds; k++) {
+                    int end = start + arc_data.lengths_[k];
+                    if (end > capacity) break;  // 种类按长度升序
+                    int id = start * num_kinds + k;
+                    if (SP2ArcAllowed(arc_data, strip_data, id)) visit(end, arc_profit(id));
+                }
+            });
+    }
+
+    // 显式网络 Arc 列表按起点有序
+    vector<int> first_arc(capacity + 1, 0);
+    for (const auto& a : arc_data.arc_list_) first_arc[a[0] + 1]++;
+    for (int p = 0; p < capacity; p++) first_arc[p + 1] += first_arc[p];
+    return LongestPathThrough(capacity, arc, arc_profit(arc_id),
+        [&](int start, auto visit) {
+            for (int id = first_arc[start]; id < first_arc[start + 1]; id++) {
+                if (SP2ArcAllowed(arc_data, strip_data, id)) {
+                    visit(arc_data.arc_list_[id][1], arc_profit(id));
+                }
+            }
+        });
+}
+
+// 将节点 Arc 行的对偶价格写入定价使用的结构
+// 每次 RMP 求解后调用一次 (同一 Arc 上的多条分支行对偶价格相加):
+//   - SP1: 稠密数组 arc_duals_，先按 touched_arcs_ 把上一轮的非零项清零
+//   - SP2: 各条带类型的 arc_duals_ (按 Arc 编号的稀疏表)，共享网络不存条带相关的对偶价格
+// 之后定价循环直接读 arc_duals_，不再遍历分支行
+void ScatterArcDuals(ProblemData& data, const BPNode* node) {
+    SP1ArcFlowData& sp1_data = data.sp1_arc_data_;
+    for (int idx : sp1_data.touched_arcs_) {
+        sp1_data.arc_duals_[idx] = 0.0;
+    }
+    sp1_data.touched_arcs_.clear();
+    for (auto& strip_data : data.sp2_strip_data_) {
+        strip_data.arc_duals_.clear();
+    }
+
+    for (const auto& con_row : node->arc_con_rows_) {
+        if (con_row.arc_idx_ < 0 || con_row.dual_ == 0.0) continue;
+
+        if (con_row.strip_type_ >= 0) {
+            data.sp2_strip_data_[con_row.strip_type_].arc_duals_[con_row.arc_idx_] +=
+                con_row.dual_;
+            continue;
+        }
+
+        if (sp1_data.arc_duals_[con_row.arc_idx_] == 0.0) {
+            sp1_data.touched_arcs_.push_back(con_row.arc_idx_);
+        }
+        sp1_data.arc_duals_[con_row.arc_idx_] += con_row.dual_;
+    }
+}
+
 // 将切割方案 (pattern) 转换为 Arc 集合
 // pattern: 每种类型的数量，如 [2, 0, 1] 表示类型0放2个，类型1放0个，类型2放1个
 // sizes: 对应的尺寸列表，如 [100, 80, 60]
@@ -299,227 +730,221 @@ void ConvertPatternToArcSet(vector<int>& pattern, vector<int>& sizes,
     }
 }
 
-// 生成节点 Y 列的 Arc 集合矩阵
-// 将每个 Y 列的 pattern 转换为对应的 SP1 Arc 集合
-void GenerateYArcSetMatrix(BPNode& node, vector<int>& strip_widths) {
-    node.y_arc_sets_.clear();
+// 将切割方案转换为网络中的 Arc 编号 (升序)
+// 放置顺序与 ConvertPatternToArcSet 相同，不在网络中的 Arc 被忽略
+void ConvertPatternToArcIds(vector<int>& pattern, vector<int>& sizes,
+    const map<array<int, 2>, int>& arc_to_index, vector<int>& arc_ids) {
 
-    for (int col = 0; col < (int)node.y_columns_.size(); col++) {
-        set<array<int, 2>> arc_set;
-        ConvertPatternToArcSet(node.y_columns_[col].pattern_, strip_widths, arc_set);
-        node.y_arc_sets_.push_back(arc_set);
-        node.y_columns_[col].arc_set_ = arc_set;
+    set<array<int, 2>> arc_set;
+    ConvertPatternToArcSet(pattern, sizes, arc_set);
+
+    arc_ids.clear();
+    for (const auto& arc : arc_set) {
+        auto it = arc_to_index.find(arc);
+        if (it != arc_to_index.end()) {
+            arc_ids.push_back(it->second);
+        }
     }
+    sort(arc_ids.begin(), arc_ids.end());
+}
+
+// 计算 Y 列的规范 SP1 Arc 编号
+// 列的 Arc 集合只由 pattern 决定，在列加入列池时计算一次并存入 CSR，之后不再重建
+void ComputeYColumnArcIds(ProblemData& data, vector<int>& pattern, vector<int>& arc_ids) {
+    ConvertPatternToArcIds(pattern, data.strip_widths_,
+        data.sp1_arc_data_.arc_to_index_, arc_ids);
 }
 
-// 生成节点 X 列的 Arc 集合矩阵
-// 将指定条带类型的 X 列的 pattern 转换为对应的 SP2 Arc 集合
-void GenerateXArcSetMatrix(BPNode& node, vector<int>& item_lengths, int strip_type) {
-    for (int col = 0; col < (int)node.x_columns_.size(); col++) {
-        // 只处理指定条带类型的 X 列
-        if (node.x_columns_[col].strip_type_id_ == strip_type) {
-            set<array<int, 2>> arc_set;
-            ConvertPatternToArcSet(node.x_columns_[col].pattern_, item_lengths, arc_set);
-            node.x_arc_sets_.push_back(arc_set);
-            node.x_columns_[col].arc_set_ = arc_set;
+// 计算 X 列的规范 SP2 Arc 编号 (strip_type 为该列所属条带类型)
+void ComputeXColumnArcIds(ProblemData& data, vector<int>& pattern, int strip_type,
+    vector<int>& arc_ids) {
+    if ((int)data.sp2_strip_data_.size() <= strip_type) {
+        arc_ids.clear();
+        return;
+    }
+    const SP2ArcFlowData& arc_data = data.sp2_arc_data_;
+    if (arc_data.implicit_) {
+        set<array<int, 2>> arc_set;
+        ConvertPatternToArcSet(pattern, data.item_lengths_, arc_set);
+        arc_ids.clear();
+        for (const auto& arc : arc_set) {
+            int id = GetSP2ArcId(arc_data, arc);
+            if (id >= 0) arc_ids.push_back(id);
         }
+        sort(arc_ids.begin(), arc_ids.end());
+        return;
     }
+    ConvertPatternToArcIds(pattern, data.item_lengths_, arc_data.arc_to_index_, arc_ids);
 }
 
-// 将 Y 列 LP 解转换为 SP1 Arc 流量
-// 输入: Y 列集合，每列有 pattern (切割方案) 和 value (LP 解值)
-// 输出: arc_flow_solution[arc_idx] = (起点, 终点, 总流量)
-// 转换逻辑: 每个 Y 列的解值贡献到其包含的所有 Arc
-// 例如: 若 Y 列解值为 2.5，包含 Arc (0,30)，则该 Arc 流量增加 2.5
-void ConvertYColsToSP1ArcFlow(vector<YColumn>& y_columns, ProblemData& data,
-    map<int, tuple<int, int, double>>& arc_flow_solution) {
+// 非零 X 列按条带类型分组 (计数排序，组内保持列编号升序)
+// 分支选择对 X 列只扫描一次，各条带类型的 SP2 流量只累加本组的列
+void GroupXColsByStripType(const ColumnStore& x_columns, const vector<ColumnValue>& x_cols,
+    int num_strip_types, vector<ColumnValue>& grouped, vector<int>& offsets) {
 
-    arc_flow_solution.clear();
-    SP1ArcFlowData& arc_data = data.sp1_arc_data_;
+    offsets.assign(num_strip_types + 1, 0);
+    for (const auto& entry : x_cols) {
+        offsets[x_columns.strip_types_[entry.col_] + 1]++;
+    }
+    for (int j = 0; j < num_strip_types; j++) {
+        offsets[j + 1] += offsets[j];
+    }
 
-    for (int col = 0; col < (int)y_columns.size(); col++) {
-        double col_value = y_columns[col].value_;
+    grouped.resize(x_cols.size());
+    vector<int> next(offsets.begin(), offsets.end() - 1);
+    for (const auto& entry : x_cols) {
+        grouped[next[x_columns.strip_types_[entry.col_]]++] = entry;
+    }
+}
 
-        // 跳过解值为 0 的列
-        if (col_value < kZeroTolerance) continue;
+// 将列的解值累加到稠密数组 flow_[a]，再按 Arc 编号升序收集为紧凑数组并把 flow_ 清零
+// num_arc_ids: 网络的 Arc 编号上界
+static void AccumulateArcFlow(const ColumnStore& store, const ColumnValue* first,
+    const ColumnValue* last, size_t num_arc_ids, ArcFlowList& flow_list) {
 
-        // 获取该列的 Arc 集合
-        set<array<int, 2>>& arc_set = y_columns[col].arc_set_;
+    vector<double>& flow = flow_list.flow_;
+    vector<int>& touched = flow_list.touched_;
+    if (flow.size() < num_arc_ids) flow.resize(num_arc_ids, 0.0);
+    touched.clear();
 
-        // 如果 arc_set 为空，需要根据 pattern 生成
-        if (arc_set.empty()) {
-            ConvertPatternToArcSet(y_columns[col].pattern_,
-                data.strip_widths_, arc_set);
-        }
+    for (const ColumnValue* entry = first; entry != last; ++entry) {
+        double col_value = entry->value_;
 
-        // 将该列的解值累加到每个 Arc 的流量
-        for (const auto& arc : arc_set) {
-            // 检查该 Arc 是否在网络中
-            if (arc_data.arc_to_index_.count(arc) == 0) continue;
-            int arc_idx = arc_data.arc_to_index_[arc];
+        // 跳过解值为 0 的列
+        if (col_value < kZeroTolerance) continue;
 
-            if (arc_flow_solution.find(arc_idx) == arc_flow_solution.end()) {
-                // 第一次遇到该 Arc，初始化流量
-                arc_flow_solution[arc_idx] = make_tuple(arc[0], arc[1], col_value);
-            } else {
-                // 累加流量
-                get<2>(arc_flow_solution[arc_idx]) += col_value;
-            }
+        // 该列的规范 Arc 编号 (CSR 区间，入池时已计算)
+        const int* it = store.arc_ids_.data() + store.arc_offsets_[entry->col_];
+        const int* end = store.arc_ids_.data() + store.arc_offsets_[entry->col_ + 1];
+        for (; it != end; ++it) {
+            if (flow[*it] == 0.0) touched.push_back(*it);
+            flow[*it] += col_value;
         }
     }
+
+    // 按编号升序输出 (与候选选择的编号 tie-break 一致)
+    sort(touched.begin(), touched.end());
+    flow_list.arc_ids_.clear();
+    flow_list.flows_.clear();
+    for (int arc_idx : touched) {
+        flow_list.arc_ids_.push_back(arc_idx);
+        flow_list.flows_.push_back(flow[arc_idx]);
+        flow[arc_idx] = 0.0;
+    }
 }
 
-// 将 X 列 LP 解转换为 SP2 Arc 流量 (指定条带类型)
-// 输入: X 列集合，条带类型 ID
-// 输出: arc_flow_solution[arc_idx] = (起点, 终点, 总流量)
-// 只处理属于指定条带类型的 X 列
-void ConvertXColsToSP2ArcFlow(vector<XColumn>& x_columns, int strip_type_id,
-    ProblemData& data, map<int, tuple<int, int, double>>& arc_flow_solution) {
+// 将 Y 列 LP 解累加为 SP1 Arc 流量
+// 每个 Y 列的解值贡献到其包含的所有 Arc
+// 例如: 若 Y 列解值为 2.5，包含 Arc (0,30)，则该 Arc 流量增加 2.5
+void CollectSP1ArcFlow(ProblemData& data, const ColumnValue* first, const ColumnValue* last,
+    ArcFlowList& flow_list) {
 
-    arc_flow_solution.clear();
+    const SP1ArcFlowData& arc_data = data.sp1_arc_data_;
+    AccumulateArcFlow(data.y_columns_, first, last, arc_data.arc_list_.size(), flow_list);
 
-    // 确保该条带类型的 Arc 网络已生成
-    if ((int)data.sp2_arc_data_.size() <= strip_type_id) {
-        return;
+    flow_list.arcs_.clear();
+    for (int arc_idx : flow_list.arc_ids_) {
+        flow_list.arcs_.push_back(arc_data.arc_list_[arc_idx]);
     }
-    SP2ArcFlowData& arc_data = data.sp2_arc_data_[strip_type_id];
-
-    for (int col = 0; col < (int)x_columns.size(); col++) {
-        // 只处理该条带类型的 X 列
-        if (x_columns[col].strip_type_id_ != strip_type_id) continue;
+}
 
-        double col_value = x_columns[col].value_;
-        if (col_value < kZeroTolerance) continue;
+// 将同一条带类型的 X 列 LP 解累加为 SP2 Arc 流量
+// 隐式网络的 Arc 编号为 起点 x 种类数 + 种类，编号上界为 L x 种类数
+void CollectSP2ArcFlow(ProblemData& data, const ColumnValue* first, const ColumnValue* last,
+    ArcFlowList& flow_list) {
 
-        // 获取该列的 Arc 集合
-        set<array<int, 2>>& arc_set = x_columns[col].arc_set_;
+    flow_list.arc_ids_.clear();
+    flow_list.arcs_.clear();
+    flow_list.flows_.clear();
 
-        // 如果 arc_set 为空，需要根据 pattern 生成
-        if (arc_set.empty()) {
-            ConvertPatternToArcSet(x_columns[col].pattern_,
-                data.item_lengths_, arc_set);
-        }
+    // 确保 SP2 网络已生成
+    if (data.sp2_strip_data_.empty()) return;
 
-        // 累加每个 Arc 的流量
-        for (const auto& arc : arc_set) {
-            if (arc_data.arc_to_index_.count(arc) == 0) continue;
-            int arc_idx = arc_data.arc_to_index_[arc];
+    const SP2ArcFlowData& arc_data = data.sp2_arc_data_;
+    size_t num_arc_ids = arc_data.implicit_
+        ? static_cast<size_t>(arc_data.capacity_) * arc_data.lengths_.size()
+        : arc_data.arc_list_.size();
+    AccumulateArcFlow(data.x_columns_, first, last, num_arc_ids, flow_list);
 
-            if (arc_flow_solution.find(arc_idx) == arc_flow_solution.end()) {
-                arc_flow_solution[arc_idx] = make_tuple(arc[0], arc[1], col_value);
-            } else {
-                get<2>(arc_flow_solution[arc_idx]) += col_value;
-            }
-        }
+    for (int arc_idx : flow_list.arc_ids_) {
+        flow_list.arcs_.push_back(GetSP2Arc(arc_data, arc_idx));
     }
 }
 
-// 在 SP1 Arc 流量中寻找非整数流量的 Arc (用于分支)
+// 在 Arc 流量中寻找非整数流量的 Arc (用于分支)
 // 候选弧选择准则 (符合数学模型 Section 9.2):
 //   1. |frac(F_a) - 0.5| 最小 (最接近0.5)
 //   2. |F_a| 最大 (tie-break)
 //   3. 弧编号最小 (固定tie-break)
 // 不对损耗弧分支 (损耗弧长度为1)
+// 第一遍在紧凑数组上计算各 Arc 到 0.5 的距离 (无分支, 可向量化), 第二遍只比较分数 Arc
 // 返回: true = 找到非整数 Arc，false = 所有 Arc 流量都是整数
-bool FindBranchArcSP1(map<int, tuple<int, int, double>>& arc_flow_solution,
-    array<int, 2>& branch_arc, double& branch_flow) {
+bool FindBranchArc(const ArcFlowList& flow_list, array<int, 2>& branch_arc, double& branch_flow) {
+    int num_arcs = static_cast<int>(flow_list.flows_.size());
+    const double* flows = flow_list.flows_.data();
+    const array<int, 2>* arcs = flow_list.arcs_.data();
+
+    // 距离 |frac - 0.5|; 整数流量 (|x - round(x)| <= kIntTolerance) 与损耗弧记为 1, 不参与选择
+    vector<double> dist_to_half(num_arcs);
+    for (int k = 0; k < num_arcs; k++) {
+        double frac = flows[k] - floor(flows[k]);
+        bool fractional = min(frac, 1.0 - frac) > kIntTolerance;
+        bool loss_arc = (arcs[k][1] - arcs[k][0] == 1);
+        dist_to_half[k] = (fractional && !loss_arc) ? fabs(frac - 0.5) : 1.0;
+    }
 
     bool found = false;
     double best_dist_to_half = 1.0;  // 越小越好
     double best_flow_abs = 0.0;      // tie-break: 越大越好
-    int best_arc_idx = INT_MAX;      // tie-break: 越小越好
-
-    for (const auto& item : arc_flow_solution) {
-        int arc_idx = item.first;
-        int arc_start = get<0>(item.second);
-        int arc_end = get<1>(item.second);
-        double flow = get<2>(item.second);
-
-        // 不对损耗弧分支 (损耗弧长度为1)
-        int arc_length = arc_end - arc_start;
-        if (arc_length == 1) continue;
-
-        // 整数判别: |x - round(x)| <= kIntTolerance
-        double rounded = round(flow);
-        double frac_part = fabs(flow - rounded);
-
-        // 检查是否为非整数流量
-        if (frac_part > kIntTolerance) {
-            // 计算小数部分 (用于0.5距离计算)
-            double frac = flow - floor(flow);
-            double dist_to_half = fabs(frac - 0.5);
-            double flow_abs = fabs(flow);
-
-            // 应用选择准则
-            bool is_better = false;
-            if (!found) {
-                is_better = true;
-            } else if (dist_to_half < best_dist_to_half - kZeroTolerance) {
-                // 规则1: 更接近0.5
-                is_better = true;
-            } else if (fabs(dist_to_half - best_dist_to_half) <= kZeroTolerance) {
-                // 规则2: 流量绝对值更大
-                if (flow_abs > best_flow_abs + kZeroTolerance) {
-                    is_better = true;
-                } else if (fabs(flow_abs - best_flow_abs) <= kZeroTolerance) {
-                    // 规则3: 弧编号更小
-                    if (arc_idx < best_arc_idx) {
-                        is_better = true;
-                    }
-                }
-            }
 
-            if (is_better) {
-                found = true;
-                best_dist_to_half = dist_to_half;
-                best_flow_abs = flow_abs;
-                best_arc_idx = arc_idx;
-                branch_arc[0] = arc_start;
-                branch_arc[1] = arc_end;
-                branch_flow = flow;
-            }
+    // 按 Arc 编号升序扫描, 规则3 (编号更小) 自然成立
+    for (int k = 0; k < num_arcs; k++) {
+        double dist = dist_to_half[k];
+        if (dist >= 1.0) continue;
+        double flow_abs = fabs(flows[k]);
+
+        bool is_better = false;
+        if (!found) {
+            is_better = true;
+        } else if (dist < best_dist_to_half - kZeroTolerance) {
+            // 规则1: 更接近0.5
+            is_better = true;
+        } else if (fabs(dist - best_dist_to_half) <= kZeroTolerance) {
+            // 规则2: 流量绝对值更大
+            is_better = flow_abs > best_flow_abs + kZeroTolerance;
+        }
+
+        if (is_better) {
+            found = true;
+            best_dist_to_half = dist;
+            best_flow_abs = flow_abs;
+            branch_arc = arcs[k];
+            branch_flow = flows[k];
         }
     }
 
     return found;
 }
 
-// 在 SP2 Arc 流量中寻找非整数流量的 Arc
-// 候选弧选择准则与 SP1 相同 (符合数学模型 Section 9.2)
-// 不对损耗弧分支
-bool FindBranchArcSP2(map<int, tuple<int, int, double>>& arc_flow_solution,
-    array<int, 2>& branch_arc, double& branch_flow) {
-    // 复用 SP1 的选择逻辑
-    return FindBranchArcSP1(arc_flow_solution, branch_arc, branch_flow);
-}
-
 // 打印 SP1 Arc Flow 解 (调试用)
-void PrintSP1ArcFlowSolution(map<int, tuple<int, int, double>>& solution) {
-    LOG("[SP1 Arc Flow 解]");
-    for (const auto& item : solution) {
-        int arc_idx = item.first;
-        auto arc_info = item.second;
-        double flow = get<2>(arc_info);
-
+void PrintSP1ArcFlowSolution(const ArcFlowList& flow_list) {
+    LOG_DEBUG("[SP1 Arc Flow 解]");
+    for (size_t k = 0; k < flow_list.arc_ids_.size(); k++) {
         // 只打印非零流量的 Arc
-        if (flow > kZeroTolerance) {
-            LOG_FMT("  Arc %d: [%d,%d] 流量=%.4f\n",
-                arc_idx, get<0>(arc_info), get<1>(arc_info), flow);
+        if (flow_list.flows_[k] > kZeroTolerance) {
+            LOG_TRACE_FMT("  Arc %d: [%d,%d] 流量=%.4f\n", flow_list.arc_ids_[k],
+                flow_list.arcs_[k][0], flow_list.arcs_[k][1], flow_list.flows_[k]);
         }
     }
 }
 
 // 打印 SP2 Arc Flow 解 (调试用)
-void PrintSP2ArcFlowSolution(map<int, tuple<int, int, double>>& solution, int strip_type) {
-    LOG_FMT("[SP2 Arc Flow 解] 条带类型 %d\n", strip_type);
-    for (const auto& item : solution) {
-        int arc_idx = item.first;
-        auto arc_info = item.second;
-        double flow = get<2>(arc_info);
-
-        if (flow > kZeroTolerance) {
-            LOG_FMT("  Arc %d: [%d,%d] 流量=%.4f\n",
-                arc_idx, get<0>(arc_info), get<1>(arc_info), flow);
+void PrintSP2ArcFlowSolution(const ArcFlowList& flow_list, int strip_type) {
+    LOG_DEBUG_FMT("[SP2 Arc Flow 解] 条带类型 %d\n", strip_type);
+    for (size_t k = 0; k < flow_list.arc_ids_.size(); k++) {
+        if (flow_list.flows_[k] > kZeroTolerance) {
+            LOG_TRACE_FMT("  Arc %d: [%d,%d] 流量=%.4f\n", flow_list.arc_ids_[k],
+                flow_list.arcs_[k][0], flow_list.arcs_[k][1], flow_list.flows_[k]);
         }
     }
 }
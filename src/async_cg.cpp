@@ -0,0 +1,270 @@
+// async_cg.cpp - 根节点流水线列生成
+//
+// 同步列生成中 RMP 求解与定价严格交替, 多核机器上大部分核在等待
+// 流水线模式 (--cg-threads <n>):
+// - n 个定价线程反复取最新发布的对偶价格, 求解 SP1 与各条带类型的 SP2,
+//   改进列推入无锁队列 (多生产者单消费者)
+// - 主线程取出队列中的全部列, 按当前对偶价格复核约化成本后批量加入 RMP,
+//   重新求解并发布新的对偶价格快照
+// - 所有定价线程都已用最新对偶价格完整扫描一轮, 且找到的列都已复核 (没有触发新的求解) 时结束流水线
+//
+// 流水线结束后由 SolveRootCG 的同步循环做最终收敛判断, 根节点下界只来自同步轮
+// 定价线程各用一个本地 BPNode 存放对偶价格与新列, 子问题各自创建 CPLEX 环境,
+// 共享数据只读 (Arc 网络已在列生成前生成); 列池与 RMP 只由主线程修改
+
+#include "2DBP.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace std;
+
+constexpr int kAsyncPollMicros = 200;       // 队列为空时主线程的轮询间隔 (微秒)
+
+// 对偶价格快照 (主线程发布, 定价线程只读)
+struct DualSnapshot {
+    vector<double> duals_;
+    int version_ = 0;                       // 每次 RMP 求解后加 1
+};
+
+// 定价线程找到的改进列
+struct PricedColumn {
+    NewColumn col_;
+    int strip_type_ = -1;                   // -1 = Y列, 否则为X列所属条带类型
+    PricedColumn* next_ = nullptr;
+};
+
+namespace {
+
+// 无锁列队列 (多生产者单消费者)
+// 生产者以 CAS 压入链表头; 消费者一次取走整条链并反转为先进先出顺序
+class ColumnQueue {
+public:
+    ~ColumnQueue() {
+        for (PricedColumn* item : Drain()) delete item;
+    }
+
+    void Push(PricedColumn* item) {
+        item->next_ = head_.load(memory_order_relaxed);
+        while (!head_.compare_exchange_weak(item->next_, item,
+            memory_order_release, memory_order_relaxed)) {
+        }
+    }
+
+    vector<PricedColumn*> Drain() {
+        vector<PricedColumn*> items;
+        for (PricedColumn* item = head_.exchange(nullptr, memory_order_acquire);
+             item != nullptr; item = item->next_) {
+            items.push_back(item);
+        }
+        reverse(items.begin(), items.end());
+        return items;
+    }
+
+private:
+    atomic<PricedColumn*> head_{nullptr};
+};
+
+}  // namespace
+
+// 主线程与定价线程共享的状态
+struct AsyncCGState {
+    shared_ptr<const DualSnapshot> snapshot_;   // 以 atomic_load / atomic_store 读写
+    ColumnQueue queue_;
+    atomic<bool> stop_{false};
+    unique_ptr<atomic<int>[]> done_version_;    // 各线程最近一次完整扫描所用的快照版本
+    atomic<int> num_priced_{0};                 // 已求解的子问题数
+};
+
+// 发布新的对偶价格快照
+static void PublishDuals(AsyncCGState& state, const vector<double>& duals, int version) {
+    auto snapshot = make_shared<DualSnapshot>();
+    snapshot->duals_ = duals;
+    snapshot->version_ = version;
+    atomic_store(&state.snapshot_, shared_ptr<const DualSnapshot>(move(snapshot)));
+}
+
+// 定价线程: 子问题 0 为 SP1, 子问题 1+j 为条带类型 j 的 SP2, 按线程编号轮流分配
+static void RunPricingWorker(ProblemParams& params, ProblemData& data,
+    const BPNode& root_node, AsyncCGState& state, int worker_id, int num_workers) {
+
+    int num_tasks = params.num_strip_types_ + 1;
+    SetProfileThreadName("pricing-" + to_string(worker_id));
+
+    BPNode local;
+    local.id_ = root_node.id_;
+    local.sp1_method_ = root_node.sp1_method_;
+    local.sp2_method_ = root_node.sp2_method_;
+
+    int last_version = 0;
+    while (!state.stop_.load(memory_order_acquire)) {
+        shared_ptr<const DualSnapshot> snapshot = atomic_load(&state.snapshot_);
+        if (snapshot->version_ == last_version) {
+            this_thread::sleep_for(chrono::microseconds(kAsyncPollMicros));
+            continue;
+        }
+        last_version = snapshot->version_;
+        local.duals_ = snapshot->duals_;
+        local.iter_ = last_version;
+
+        bool complete = true;
+        for (int task = worker_id; task < num_tasks; task += num_workers) {
+            if (state.stop_.load(memory_order_acquire)) {
+                complete = false;
+                break;
+            }
+
+            bool converged = (task == 0)
+                ? SolveRootSP1(params, data, local)
+                : SolveRootSP2(params, data, local, task - 1);
+            state.num_priced_.fetch_add(1, memory_order_relaxed);
+
+            if (!converged) {
+                auto item = new PricedColumn;
+                if (task == 0) {
+                    item->col_ = move(local.new_y_col_);
+                    local.new_y_col_ = NewColumn();
+                } else {
+                    item->col_ = move(local.new_x_col_);
+                    item->strip_type_ = task - 1;
+                    local.new_x_col_ = NewColumn();
+                }
+                state.queue_.Push(item);
+            }
+
+            // 已有更新的对偶价格时放弃本轮剩余子问题
+            if (atomic_load(&state.snapshot_)->version_ != last_version) {
+                complete = false;
+                break;
+            }
+        }
+
+        // 扫描中推入的列先于版本号对主线程可见
+        if (complete) {
+            state.done_version_[worker_id].store(last_version, memory_order_release);
+        }
+    }
+}
+
+// 按当前对偶价格计算约化成本 (Y列: Σ v_j a_j - 1; X列: Σ π_i b_i - v_j)
+static double PricedReducedCost(ProblemParams& params, const vector<double>& duals,
+    const PricedColumn& item) {
+
+    int num_strip_types = params.num_strip_types_;
+    const vector<int>& pattern = item.col_.pattern_;
+
+    double value = 0.0;
+    if (item.strip_type_ < 0) {
+        for (int j = 0; j < num_strip_types; j++) value += duals[j] * pattern[j];
+        return value - 1.0;
+    }
+    for (int i = 0; i < params.num_item_types_; i++) {
+        value += duals[num_strip_types + i] * pattern[i];
+    }
+    return value - duals[item.strip_type_];
+}
+
+// 根节点流水线列生成 (在 SolveRootInitMP 之后调用, root_node.duals_ 为初始对偶价格)
+// 返回值: true=流水线正常结束, false=RMP 不可行
+// 结束时 root_node.duals_ 为最后一次 RMP 求解的对偶价格, 由同步循环继续
+bool RunAsyncRootCG(ProblemParams& params, ProblemData& data,
+    IloObjective& obj, IloRangeArray& cons, IloNumVarArray& vars,
+    IloCplex& cplex, BPNode& root_node) {
+
+    int num_workers = params.cg_threads_;
+    int num_rows = params.num_strip_types_ + params.num_item_types_;
+    LOG_FMT("[CG] 流水线列生成开始: 定价线程%d个\n", num_workers);
+
+    AsyncCGState state;
+    state.done_version_.reset(new atomic<int>[num_workers]);
+    for (int w = 0; w < num_workers; w++) state.done_version_[w].store(0);
+
+    int version = 1;
+    PublishDuals(state, root_node.duals_, version);
+
+    vector<thread> workers;
+    for (int w = 0; w < num_workers; w++) {
+        workers.emplace_back(RunPricingWorker, ref(params), ref(data),
+            cref(root_node), ref(state), w, num_workers);
+    }
+
+    int num_added = 0;
+    int num_stale = 0;
+    bool feasible = true;
+    int max_solves = kMaxCgIter * (params.num_strip_types_ + 1);
+
+    while (true) {
+        if (IsTimeUp(params)) {
+            params.is_timeout_ = true;
+            LOG_FMT("[CG] 达到时间限制 (%d秒), 终止流水线列生成\n", params.time_limit_);
+            break;
+        }
+
+        vector<PricedColumn*> items = state.queue_.Drain();
+        if (items.empty()) {
+            // 全部线程已在当前版本下扫描完: 先读版本号再复查队列, 避免漏掉扫描中推入的列
+            bool all_done = true;
+            for (int w = 0; w < num_workers; w++) {
+                if (state.done_version_[w].load(memory_order_acquire) != version) {
+                    all_done = false;
+                    break;
+                }
+            }
+            items = state.queue_.Drain();
+            if (items.empty()) {
+                if (all_done) break;
+                this_thread::sleep_for(chrono::microseconds(kAsyncPollMicros));
+                continue;
+            }
+        }
+
+        // 按当前对偶价格复核 (旧快照下的列可能已不再改进), 同一批中的重复列只加一次
+        int batch_added = 0;
+        set<pair<int, vector<int>>> batch_patterns;
+        for (PricedColumn* item : items) {
+            bool improving = PricedReducedCost(params, root_node.duals_, *item) > kRcTolerance;
+            if (improving && batch_patterns.insert({item->strip_type_, item->col_.pattern_}).second) {
+                AddRootColumn(params, data, obj, cons, vars, item->col_, item->strip_type_);
+                batch_added++;
+            } else {
+                num_stale++;
+            }
+            delete item;
+        }
+        if (batch_added == 0) continue;
+        num_added += batch_added;
+
+        if (!SolveMasterLP(params, cplex, kCplexRootMaster)) {
+            LOG("[MP] 更新后主问题不可行");
+            feasible = false;
+            break;
+        }
+
+        root_node.duals_.clear();
+        for (int row = 0; row < num_rows; row++) {
+            double dual = cplex.getDual(cons[row]);
+            if (dual == -0.0) dual = 0.0;
+            root_node.duals_.push_back(dual);
+        }
+        PublishDuals(state, root_node.duals_, ++version);
+
+        if (version == 2 || version % 20 == 0) {
+            PROGRESS(GetElapsedTime(params),
+                "CG   | async v=%-4d obj=%-7.2f Y=%-3d X=%-3d\n",
+                version, cplex.getValue(obj),
+                data.y_columns_.num_cols_, data.x_columns_.num_cols_);
+        }
+
+        if (version >= max_solves) {
+            LOG_WARN_FMT("[CG] 警告: 流水线 RMP 求解达到 %d 次, 转入同步列生成\n", max_solves);
+            break;
+        }
+    }
+
+    state.stop_.store(true, memory_order_release);
+    for (auto& worker : workers) worker.join();
+
+    LOG_FMT("[CG] 流水线列生成结束: RMP求解%d次, 子问题%d个, 加入列%d条, 过期列%d条\n",
+        version - 1, state.num_priced_.load(), num_added, num_stale);
+    return feasible;
+}
@@ -21,13 +21,13 @@
 using namespace std;
 
 // 检查 LP 解是否为整数解 (符合数学模型 Section 10)
-// 遍历所有 Y 列和 X 列，检查解值是否都接近整数
+// 遍历解中所有非零 Y 列和 X 列，检查取值是否都接近整数
 // 整数判别: |x - round(x)| <= kIntTolerance
 // 返回: true = 整数解，false = 存在分数解
 bool IsIntegerSolution(NodeSolution& solution) {
     // 检查 Y 列 (母板切割方案)
-    for (int i = 0; i < (int)solution.y_columns_.size(); i++) {
-        double val = solution.y_columns_[i].value_;
+    for (const auto& entry : solution.y_cols_) {
+        double val = entry.value_;
 
         // 只检查非零解值
         if (val > kZeroTolerance) {
@@ -40,8 +40,8 @@ bool IsIntegerSolution(NodeSolution& solution) {
     }
 
     // 检查 X 列 (条带切割方案)
-    for (int i = 0; i < (int)solution.x_columns_.size(); i++) {
-        double val = solution.x_columns_[i].value_;
+    for (const auto& entry : solution.x_cols_) {
+        double val = entry.value_;
 
         if (val > kZeroTolerance) {
             double rounded = round(val);
@@ -56,15 +56,16 @@ bool IsIntegerSolution(NodeSolution& solution) {
 
 // 选择分支变量 (变量分支策略，已废弃)
 // 选择分数部分最大的变量进行分支
+// 变量索引与 RMP 一致: Y 列为列编号，X 列为 Y 列总数 + 列编号
 // 返回: 待分支变量索引，-1 表示无需分支 (整数解)
-int SelectBranchVar(BPNode* node) {
+int SelectBranchVar(ProblemData& data, BPNode* node) {
     double max_frac = 0;
     int branch_idx = -1;
 
     // 检查 Y 列
-    int y_count = static_cast<int>(node->solution_.y_columns_.size());
-    for (int i = 0; i < y_count; i++) {
-        double val = node->solution_.y_columns_[i].value_;
+    int y_count = data.y_columns_.num_cols_;
+    for (const auto& entry : node->solution_.y_cols_) {
+        double val = entry.value_;
 
         if (val > kZeroTolerance) {
             double frac = val - floor(val);
@@ -73,7 +74,7 @@ int SelectBranchVar(BPNode* node) {
             if (frac > kZeroTolerance && frac < 1 - kZeroTolerance) {
                 if (frac > max_frac) {
                     max_frac = frac;
-                    branch_idx = i;
+                    branch_idx = entry.col_;
                     node->branch_var_val_ = val;
                 }
             }
@@ -81,8 +82,8 @@ int SelectBranchVar(BPNode* node) {
     }
 
     // 检查 X 列
-    for (int i = 0; i < (int)node->solution_.x_columns_.size(); i++) {
-        double val = node->solution_.x_columns_[i].value_;
+    for (const auto& entry : node->solution_.x_cols_) {
+        double val = entry.value_;
 
         if (val > kZeroTolerance) {
             double frac = val - floor(val);
@@ -90,7 +91,7 @@ int SelectBranchVar(BPNode* node) {
             if (frac > kZeroTolerance && frac < 1 - kZeroTolerance) {
                 if (frac > max_frac) {
                     max_frac = frac;
-                    branch_idx = y_count + i;
+                    branch_idx = y_count + entry.col_;
                     node->branch_var_val_ = val;
                 }
             }
@@ -115,6 +116,8 @@ int SelectBranchVar(BPNode* node) {
 // 策略: 将 LP 解转换为 Arc 流量，选择流量最接近 0.5 的分数 Arc
 // 返回: 分支类型 (kBranchNone / kBranchSP1Arc / kBranchSP2Arc)
 int SelectBranchArc(ProblemParams& params, ProblemData& data, BPNode* node) {
+    PROFILE_ZONE("branch.select");
+
     // 重置分支信息
     node->branch_type_ = kBranchNone;
     node->branch_arc_ = {-1, -1};
@@ -125,12 +128,19 @@ int SelectBranchArc(ProblemParams& params, ProblemData& data, BPNode* node) {
     double branch_flow;
 
     // 步骤 1: 主分支 - 检查 SP2 Arc (长度方向)
-    // 需要遍历所有条带类型，因为每种条带有独立的 SP2 网络
+    // 每种条带有独立的 SP2 流量: 非零 X 列先按条带类型分组 (一次扫描), 再逐类型累加本组的列
+    ArcFlowList& flow_list = data.branch_flow_;
+    vector<ColumnValue>& grouped = data.branch_x_cols_;
+    vector<int>& offsets = data.branch_x_offsets_;
+    GroupXColsByStripType(data.x_columns_, node->solution_.x_cols_, params.num_strip_types_,
+        grouped, offsets);
+
     for (int j = 0; j < params.num_strip_types_; j++) {
-        map<int, tuple<int, int, double>> sp2_arc_flow;
-        ConvertXColsToSP2ArcFlow(node->solution_.x_columns_, j, data, sp2_arc_flow);
+        if (offsets[j] == offsets[j + 1]) continue;
+        CollectSP2ArcFlow(data, grouped.data() + offsets[j], grouped.data() + offsets[j + 1],
+            flow_list);
 
-        if (FindBranchArcSP2(sp2_arc_flow, branch_arc, branch_flow)) {
+        if (FindBranchArc(flow_list, branch_arc, branch_flow)) {
             // 找到分数 Arc，记录条带类型
             node->branch_type_ = kBranchSP2Arc;
             node->branch_arc_ = branch_arc;
@@ -143,11 +153,11 @@ int SelectBranchArc(ProblemParams& params, ProblemData& data, BPNode* node) {
     }
 
     // 步骤 2: 备用分支 - 检查 SP1 Arc (宽度方向)
-    // 将所有 Y 列的 LP 解转换为 SP1 Arc 流量
-    map<int, tuple<int, int, double>> sp1_arc_flow;
-    ConvertYColsToSP1ArcFlow(node->solution_.y_columns_, data, sp1_arc_flow);
+    // 将所有 Y 列的 LP 解累加为 SP1 Arc 流量
+    const vector<ColumnValue>& y_cols = node->solution_.y_cols_;
+    CollectSP1ArcFlow(data, y_cols.data(), y_cols.data() + y_cols.size(), flow_list);
 
-    if (FindBranchArcSP1(sp1_arc_flow, branch_arc, branch_flow)) {
+    if (FindBranchArc(flow_list, branch_arc, branch_flow)) {
         // 找到分数 Arc，设置分支信息
         node->branch_type_ = kBranchSP1Arc;
         node->branch_arc_ = branch_arc;
@@ -169,14 +179,11 @@ void CreateLeftChild(BPNode* parent, int new_id, BPNode* child) {
     // 复制基本信息
     child->id_ = new_id;
     child->parent_id_ = parent->id_;
+    child->depth_ = parent->depth_ + 1;
     child->branch_dir_ = 1;  // 标记为左分支
     child->sp1_method_ = parent->sp1_method_;
     child->sp2_method_ = parent->sp2_method_;
 
-    // 复制父节点的列集合作为初始解
-    child->y_columns_ = parent->y_columns_;
-    child->x_columns_ = parent->x_columns_;
-
     // 继承父节点的所有 Arc 约束
     // 这是分支定价的关键: 子节点必须满足祖先节点的所有约束
     child->sp1_zero_arcs_ = parent->sp1_zero_arcs_;
@@ -190,6 +197,9 @@ void CreateLeftChild(BPNode* parent, int new_id, BPNode* child) {
     child->sp2_greater_arcs_ = parent->sp2_greater_arcs_;
     child->sp2_greater_bounds_ = parent->sp2_greater_bounds_;
 
+    // 继承父节点的秩1割 (割对整数解全局有效, 可直接沿用)
+    child->cut_ids_ = parent->cut_ids_;
+
     // 添加新的分支约束 (Arc <= floor)
     if (parent->branch_type_ == kBranchSP1Arc) {
         // SP1 分支: 限制宽度方向的 Arc
@@ -198,13 +208,13 @@ void CreateLeftChild(BPNode* parent, int new_id, BPNode* child) {
         if (bound == 0) {
             // 特殊情况: floor(流量) = 0 意味着禁用该 Arc
             child->sp1_zero_arcs_.insert(parent->branch_arc_);
-            LOG_FMT("[Branch] 左子节点 %d: SP1 Arc[%d,%d] = 0 (禁用)\n",
+            LOG_DEBUG_FMT("[Branch] 左子节点 %d: SP1 Arc[%d,%d] = 0 (禁用)\n",
                 new_id, parent->branch_arc_[0], parent->branch_arc_[1]);
         } else {
             // 添加上界约束: Arc <= bound
             child->sp1_lower_arcs_.push_back(parent->branch_arc_);
             child->sp1_lower_bounds_.push_back(bound);
-            LOG_FMT("[Branch] 左子节点 %d: SP1 Arc[%d,%d] <= %d\n",
+            LOG_DEBUG_FMT("[Branch] 左子节点 %d: SP1 Arc[%d,%d] <= %d\n",
                 new_id, parent->branch_arc_[0], parent->branch_arc_[1], bound);
         }
     } else if (parent->branch_type_ == kBranchSP2Arc) {
@@ -214,12 +224,12 @@ void CreateLeftChild(BPNode* parent, int new_id, BPNode* child) {
 
         if (bound == 0) {
             child->sp2_zero_arcs_[strip_type].insert(parent->branch_arc_);
-            LOG_FMT("[Branch] 左子节点 %d: SP2 Arc[%d,%d] 条带%d = 0 (禁用)\n",
+            LOG_DEBUG_FMT("[Branch] 左子节点 %d: SP2 Arc[%d,%d] 条带%d = 0 (禁用)\n",
                 new_id, parent->branch_arc_[0], parent->branch_arc_[1], strip_type);
         } else {
             child->sp2_lower_arcs_[strip_type].push_back(parent->branch_arc_);
             child->sp2_lower_bounds_[strip_type].push_back(bound);
-            LOG_FMT("[Branch] 左子节点 %d: SP2 Arc[%d,%d] 条带%d <= %d\n",
+            LOG_DEBUG_FMT("[Branch] 左子节点 %d: SP2 Arc[%d,%d] 条带%d <= %d\n",
                 new_id, parent->branch_arc_[0], parent->branch_arc_[1], strip_type, bound);
         }
     }
@@ -231,14 +241,11 @@ void CreateRightChild(BPNode* parent, int new_id, BPNode* child) {
     // 复制基本信息
     child->id_ = new_id;
     child->parent_id_ = parent->id_;
+    child->depth_ = parent->depth_ + 1;
     child->branch_dir_ = 2;  // 标记为右分支
     child->sp1_method_ = parent->sp1_method_;
     child->sp2_method_ = parent->sp2_method_;
 
-    // 复制父节点的列集合
-    child->y_columns_ = parent->y_columns_;
-    child->x_columns_ = parent->x_columns_;
-
     // 继承父节点的所有 Arc 约束
     child->sp1_zero_arcs_ = parent->sp1_zero_arcs_;
     child->sp1_lower_arcs_ = parent->sp1_lower_arcs_;
@@ -251,23 +258,108 @@ void CreateRightChild(BPNode* parent, int new_id, BPNode* child) {
     child->sp2_greater_arcs_ = parent->sp2_greater_arcs_;
     child->sp2_greater_bounds_ = parent->sp2_greater_bounds_;
 
+    // 继承父节点的秩1割 (割对整数解全局有效, 可直接沿用)
+    child->cut_ids_ = parent->cut_ids_;
+
     // 添加新的分支约束 (Arc >= ceil)
     if (parent->branch_type_ == kBranchSP1Arc) {
         int bound = static_cast<int>(ceil(parent->branch_arc_flow_));
         child->sp1_greater_arcs_.push_back(parent->branch_arc_);
         child->sp1_greater_bounds_.push_back(bound);
-        LOG_FMT("[Branch] 右子节点 %d: SP1 Arc[%d,%d] >= %d\n",
+        LOG_DEBUG_FMT("[Branch] 右子节点 %d: SP1 Arc[%d,%d] >= %d\n",
             new_id, parent->branch_arc_[0], parent->branch_arc_[1], bound);
     } else if (parent->branch_type_ == kBranchSP2Arc) {
         int strip_type = parent->branch_arc_strip_type_;
         int bound = static_cast<int>(ceil(parent->branch_arc_flow_));
         child->sp2_greater_arcs_[strip_type].push_back(parent->branch_arc_);
         child->sp2_greater_bounds_[strip_type].push_back(bound);
-        LOG_FMT("[Branch] 右子节点 %d: SP2 Arc[%d,%d] 条带%d >= %d\n",
+        LOG_DEBUG_FMT("[Branch] 右子节点 %d: SP2 Arc[%d,%d] 条带%d >= %d\n",
             new_id, parent->branch_arc_[0], parent->branch_arc_[1], strip_type, bound);
     }
 }
 
+// 右子节点 (Arc 流量 >= B) 的定价下界增量
+// 父节点收敛时其最终对偶价格 (v, π, μ, ρ) 下所有列的 reduced cost >= 0;
+// 子节点新增的 Arc 行取对偶价格 g = 经过该 Arc 的列的最小 reduced cost >= 0,
+// 每条路径至多经过该 Arc 一次, 所有列的 reduced cost 仍 >= 0, 对偶可行, 故
+//   z_child >= z_parent + g·B
+// 经过该 Arc 的最优列按父节点对偶价格对子问题网络定价得到 (SP1: rc = 1 - 收益, SP2: rc = v_j - 收益);
+// 忽略禁用 Arc 只会放大收益, 下界仍有效. 没有路径经过该 Arc 时子节点不可行, 返回 INFINITY
+// 父节点对偶价格不在内存中 (分布式工作进程收到的节点记录不含对偶价格),
+// 或 SP2 分支而父节点含对偶价格非零的割行 (路径定价不含割收益) 时返回 0
+static double RightChildBoundGain(ProblemParams& params, ProblemData& data,
+    const BPNode* parent) {
+    int num_strip_types = params.num_strip_types_;
+    int num_item_types = params.num_item_types_;
+    if (static_cast<int>(parent->duals_.size()) != num_strip_types + num_item_types) return 0.0;
+
+    int strip_type = parent->branch_type_ == kBranchSP1Arc ? -1 : parent->branch_arc_strip_type_;
+    int arc_idx = FindArcIndex(data, strip_type, parent->branch_arc_);
+    if (arc_idx < 0) return 0.0;
+
+    double reduced_cost;
+    if (strip_type < 0) {
+        ScatterArcDuals(data, parent);
+        reduced_cost = 1.0 - SP1PathValueThrough(data.sp1_arc_data_, parent->duals_, arc_idx);
+    } else {
+        for (const auto& cut_row : parent->cut_rows_) {
+            if (fabs(cut_row.dual_) > kZeroTolerance) return 0.0;
+        }
+        ScatterArcDuals(data, parent);
+        vector<double> profits(num_item_types, 0.0);
+        for (int i = 0; i < num_item_types; i++) {
+            profits[i] = max(parent->duals_[num_strip_types + i], 0.0);
+        }
+        reduced_cost = parent->duals_[strip_type] - SP2PathValueThrough(data.sp2_arc_data_,
+            data.sp2_strip_data_[strip_type], profits, arc_idx);
+    }
+
+    double bound = ceil(parent->branch_arc_flow_);
+    return max(reduced_cost, 0.0) * bound;
+}
+
+// 子节点预筛
+// 子节点的可行域是父节点的子集, 父节点列生成收敛时其下界也是子节点的下界
+// (左子节点: 父节点最终对偶价格在子节点中仍对偶可行, 新 Arc 行取 μ = 0);
+// 右子节点另加上按父节点对偶价格对分支 Arc 定价得到的增量 (RightChildBoundGain)
+// 目标值 (母板数) 为整数, ceil(下界) >= UB 时子节点不可能改进当前最优整数解
+// 满足时直接剪枝并返回 true, 跳过该子节点的整个列生成
+bool PrescreenChild(ProblemParams& params, ProblemData& data, const BPNode* parent,
+    BPNode* child) {
+    if (parent->cg_converged_ == 0 || params.global_best_int_ >= INFINITY) return false;
+
+    double bound = parent->lower_bound_;
+    if (child->branch_dir_ == 2) {
+        bound += RightChildBoundGain(params, data, parent);
+    }
+    if (ceil(bound - kIntTolerance) < params.global_best_int_ - kZeroTolerance) return false;
+
+    child->lower_bound_ = bound;
+    child->prune_flag_ = 1;
+    LOG_FMT("[BP] 子节点 %d 预筛剪枝 (父节点LB=%.4f, 子节点下界=%.4f, ceil >= UB=%.0f)\n",
+        child->id_, parent->lower_bound_, bound, params.global_best_int_);
+    return true;
+}
+
+// 求解子节点: 预筛通过时直接剪枝, 否则执行列生成; 并写出分支树事件
+static void SolveChildNode(ProblemParams& params, ProblemData& data,
+    const BPNode* parent, BPNode* child) {
+    LogTreeCreated(params, child);
+    if (PrescreenChild(params, data, parent, child)) {
+        LogTreePruned(params, child->id_, child->lower_bound_, "prescreen");
+        return;
+    }
+
+    // 子问题会应用该节点累积的 Arc 约束
+    int64_t cg_start = ProfileNow();
+    int status = SolveNodeCG(params, data, child);
+    LogTreeSolved(params, child, (ProfileNow() - cg_start) / 1.0e6);
+    if (child->prune_flag_ == 1) {
+        LogTreePruned(params, child->id_, child->lower_bound_,
+            status < 0 ? "infeasible" : "timeout");
+    }
+}
+
 // 选择待分支节点
 // 策略: 选择下界最小的未剪枝未分支节点 (Best-First Search)
 // 这种策略有助于更快地找到最优解并剪枝
@@ -292,10 +384,143 @@ BPNode* SelectBranchNode(BPNode* head) {
     return best;
 }
 
+// 选择待分支节点 (深度优先，内存超预算时使用)
+// 策略: 选择深度最大的未剪枝未分支节点，同深度取下界较小者
+// 沿一条路径向下搜索，待处理节点数不再增长
+BPNode* SelectDeepestNode(BPNode* head) {
+    BPNode* best = nullptr;
+
+    BPNode* curr = head;
+    while (curr != nullptr) {
+        if (curr->prune_flag_ == 0 && curr->branched_flag_ == 0) {
+            if (best == nullptr || curr->depth_ > best->depth_ ||
+                (curr->depth_ == best->depth_ && curr->lower_bound_ < best->lower_bound_)) {
+                best = curr;
+            }
+        }
+        curr = curr->next_;
+    }
+
+    return best;
+}
+
+// 内存预算检查 (params.mem_limit_mb_ > 0 时每轮分支前调用)
+// 超预算: 把下界较大的一半待处理节点 (至少保留一个) 写入溢出文件并归还节点池，
+//         搜索切换为深度优先
+// 溢出不会降低 RSS (节点外壳留在节点池, 释放的堆内存也不归还系统), 之后新建的节点复用这部分内存;
+// 因此只在 RSS 增长到上次溢出时的 kSpillRegrowRatio 倍以上后再溢出, 而恢复最优优先以内存中的
+// 待处理节点数为准:
+// 回落到上次溢出后保留数的 kSpillResumeRatio 以下 (或 RSS 回落到预算的该比例以下) 时恢复
+static void EnforceMemoryBudget(ProblemParams& params, NodePool& pool, NodeSpill& spill,
+    BPNode* head, BPNode*& tail) {
+
+    double rss = GetCurrentRssMB();
+    if (rss < 0) return;
+
+    // 待处理节点 (根节点由调用方持有, 不溢出)
+    vector<BPNode*> open_nodes;
+    for (BPNode* curr = head->next_; curr != nullptr; curr = curr->next_) {
+        if (curr->prune_flag_ == 0 && curr->branched_flag_ == 0) {
+            open_nodes.push_back(curr);
+        }
+    }
+    int num_open = static_cast<int>(open_nodes.size());
+
+    if (spill.depth_first_ && (rss < params.mem_limit_mb_ * kSpillResumeRatio ||
+            num_open < spill.spill_open_ * kSpillResumeRatio)) {
+        spill.depth_first_ = false;
+        LOG_FMT("[BP] 内存中待处理节点 %d 个 (内存 %.1f MB), 恢复最优优先搜索\n", num_open, rss);
+    }
+    if (rss <= params.mem_limit_mb_ || rss <= spill.spill_rss_mb_ * kSpillRegrowRatio) return;
+
+    if (!spill.depth_first_) {
+        spill.depth_first_ = true;
+        LOG_FMT("[BP] 内存 %.1f MB 超过预算 %d MB, 切换为深度优先\n", rss, params.mem_limit_mb_);
+    }
+    spill.spill_rss_mb_ = rss;
+
+    int num_spill = num_open / 2;
+    spill.spill_open_ = num_open - num_spill;
+    if (num_spill == 0) return;
+
+    // 下界最大的节点最不可能被继续选中
+    sort(open_nodes.begin(), open_nodes.end(),
+        [](const BPNode* a, const BPNode* b) { return a->lower_bound_ > b->lower_bound_; });
+    set<BPNode*> to_spill;
+    for (int k = 0; k < num_spill; k++) {
+        if (!SpillNode(spill, *open_nodes[k])) break;
+        to_spill.insert(open_nodes[k]);
+    }
+
+    // 移出链表并归还
+    BPNode* prev = head;
+    BPNode* curr = head->next_;
+    while (curr != nullptr) {
+        BPNode* next = curr->next_;
+        if (to_spill.count(curr)) {
+            prev->next_ = next;
+            if (curr == tail) tail = prev;
+            ReleaseNode(pool, curr);
+        } else {
+            prev = curr;
+        }
+        curr = next;
+    }
+    LOG_FMT("[BP] 溢出 %d 个节点到磁盘 (磁盘上共 %d 个)\n",
+        (int)to_spill.size(), (int)spill.entries_.size());
+}
+
+// 未找到整数解时的兜底: 根节点 LP 解向上取整作为可行解 (非最优)
+void RoundRootSolution(ProblemParams& params, const BPNode* root) {
+    LOG("[BP] 未找到整数解, 使用根节点 LP 解向上取整");
+
+    // 对 Y 列取整 (向上取整确保可行性)
+    params.global_best_sol_ = root->solution_;
+    double rounded_obj = 0.0;
+    for (auto& entry : params.global_best_sol_.y_cols_) {
+        if (entry.value_ > kZeroTolerance) {
+            entry.value_ = ceil(entry.value_);
+            rounded_obj += entry.value_;
+        }
+    }
+
+    // 对 X 列取整
+    for (auto& entry : params.global_best_sol_.x_cols_) {
+        if (entry.value_ > kZeroTolerance) {
+            entry.value_ = ceil(entry.value_);
+        }
+    }
+
+    params.global_best_sol_.obj_val_ = rounded_obj;
+    params.global_best_int_ = rounded_obj;
+    LOG_FMT("[BP] 取整后目标值: %.4f (非最优)\n", params.global_best_int_);
+}
+
+// 写出检查点: 根节点 + 链表中的待处理节点 + 磁盘上的溢出节点 (读出后写入, 登记保留)
+static void WriteBPCheckpoint(ProblemParams& params, ProblemData& data, BPNode* root,
+    NodeSpill& spill, BPCheckpoint& stats, double prior_elapsed) {
+
+    vector<const BPNode*> open_nodes;
+    for (BPNode* curr = root->next_; curr != nullptr; curr = curr->next_) {
+        if (curr->prune_flag_ == 0 && curr->branched_flag_ == 0) {
+            open_nodes.push_back(curr);
+        }
+    }
+    vector<BPNode> spilled(spill.entries_.size());
+    for (int k = 0; k < (int)spilled.size(); k++) {
+        if (!PeekSpilledNode(spill, k, spilled[k])) return;
+        open_nodes.push_back(&spilled[k]);
+    }
+
+    stats.elapsed_sec_ = prior_elapsed + GetElapsedTime(params);
+    SaveCheckpoint(params.checkpoint_file_, params, data, *root, open_nodes, stats);
+}
+
 // 分支定价主循环
-// 输入: 根节点 (已完成列生成)
+// 输入: 根节点 (已完成列生成); resume 非空时为检查点读回的待处理节点与统计
 // 输出: 最优整数解存储在 params 中
-int RunBranchAndPrice(ProblemParams& params, ProblemData& data, BPNode* root) {
+int RunBranchAndPrice(ProblemParams& params, ProblemData& data, BPNode* root,
+    BPCheckpoint* resume) {
     LOG("[BP] 分支定价开始 (Arc 分支策略)");
     if (params.time_limit_ > 0) {
         LOG_FMT("[BP] 时间限制: %d 秒\n", params.time_limit_);
@@ -312,31 +537,62 @@ int RunBranchAndPrice(ProblemParams& params, ProblemData& data, BPNode* root) {
         GenerateAllArcs(data, params);
     }
 
-    // 为根节点解生成 Arc 集合
-    // 用于后续的 Arc 流量分析
-    GenerateYArcSetMatrix(*root, data.strip_widths_);
-    for (int j = 0; j < params.num_strip_types_; j++) {
-        GenerateXArcSetMatrix(*root, data.item_lengths_, j);
-    }
-
-    // 初始化节点链表 (用于存储所有节点)
+    // 初始化节点链表 (只保存待处理节点与根节点)
+    // 子节点由节点池分配, 剪枝、得到整数解或完成分支后移出链表并归还
+    NodePool pool;
+    NodeSpill spill;                    // 内存超预算时的节点溢出文件
     BPNode* head = root;
     BPNode* tail = root;
     int node_count = 1;
+    int released_pruned = 0;            // 已归还的剪枝节点数
+    double released_lb = INFINITY;      // 已归还的未剪枝节点下界最小值 (计算间隙用)
+
+    // 从检查点继续: 待处理节点重新放入链表, 沿用此前的回收统计
+    BPCheckpoint checkpoint_stats;
+    double prior_elapsed = 0.0;         // 此前各次运行的累计时间
+    if (resume != nullptr) {
+        for (BPNode& saved : resume->open_nodes_) {
+            BPNode* node = AllocNode(pool);
+            *node = move(saved);
+            tail->next_ = node;
+            tail = node;
+        }
+        released_pruned = resume->released_pruned_;
+        released_lb = resume->released_lb_;
+        prior_elapsed = resume->elapsed_sec_;
+        LOG_FMT("[BP] 从检查点继续: 待处理节点%d, 根节点%s\n",
+            (int)resume->open_nodes_.size(), root->branched_flag_ ? "已分支" : "未分支");
+        resume->open_nodes_.clear();
+    }
 
-    // 检查根节点是否已经是整数解
-    int branch_type = SelectBranchArc(params, data, root);
+    // 检查根节点是否已经是整数解 (从检查点继续且根节点已分支时跳过)
+    int branch_type = (root->branched_flag_ == 1) ? root->branch_type_
+                                                  : SelectBranchArc(params, data, root);
+    if (resume == nullptr) {
+        LogTreeCreated(params, root);
+        LogTreeSolved(params, root, NAN);
+    }
     if (branch_type == kBranchNone) {
         // Arc 流量全整数，根节点即为最优解
         params.global_best_int_ = root->solution_.obj_val_;
-        params.global_best_y_cols_ = root->solution_.y_columns_;
-        params.global_best_x_cols_ = root->solution_.x_columns_;
+        params.global_best_sol_ = root->solution_;
+        LogTreeIncumbent(params, root);
+        LogTreePruned(params, root->id_, root->lower_bound_, "integer");
         LOG("[BP] 根节点 Arc 流量全整数, 即为最优解");
         PROGRESS(GetElapsedTime(params), "BP   | 根节点即整数解 obj=%.0f\n",
             params.global_best_int_);
         return 0;
     }
 
+    // 检查点: 开始时写一次, 之后每 checkpoint_interval_ 秒写一次
+    bool use_checkpoint = !params.checkpoint_file_.empty();
+    double last_checkpoint_time = GetElapsedTime(params);
+    if (use_checkpoint) {
+        checkpoint_stats.released_lb_ = released_lb;
+        checkpoint_stats.released_pruned_ = released_pruned;
+        WriteBPCheckpoint(params, data, root, spill, checkpoint_stats, prior_elapsed);
+    }
+
     // 分支定价主循环
     int loop_iter = 0;
     while (true) {
@@ -355,8 +611,44 @@ int RunBranchAndPrice(ProblemParams& params, ProblemData& data, BPNode* root) {
             break;
         }
 
-        // 选择待分支节点 (下界最小的未处理节点)
-        BPNode* parent = SelectBranchNode(head);
+        // 定期检查点
+        if (use_checkpoint &&
+            GetElapsedTime(params) - last_checkpoint_time >= params.checkpoint_interval_) {
+            checkpoint_stats.released_lb_ = released_lb;
+            checkpoint_stats.released_pruned_ = released_pruned;
+            WriteBPCheckpoint(params, data, root, spill, checkpoint_stats, prior_elapsed);
+            last_checkpoint_time = GetElapsedTime(params);
+        }
+
+        // 内存预算: 超出时溢出部分待处理节点并切换为深度优先
+        if (params.mem_limit_mb_ > 0) {
+            EnforceMemoryBudget(params, pool, spill, head, tail);
+        }
+
+        // 选择待分支节点 (下界最小的未处理节点; 深度优先模式下取最深节点)
+        BPNode* parent = spill.depth_first_ ? SelectDeepestNode(head) : SelectBranchNode(head);
+
+        // 溢出节点按需读回: 内存中已无待处理节点, 或 (最优优先时) 磁盘上有下界更小的节点
+        int spilled_idx = -1;
+        for (int k = 0; k < (int)spill.entries_.size(); k++) {
+            if (spilled_idx < 0 ||
+                spill.entries_[k].lower_bound_ < spill.entries_[spilled_idx].lower_bound_) {
+                spilled_idx = k;
+            }
+        }
+        if (spilled_idx >= 0 && (parent == nullptr ||
+                (!spill.depth_first_ &&
+                 spill.entries_[spilled_idx].lower_bound_ < parent->lower_bound_))) {
+            BPNode* reloaded = AllocNode(pool);
+            if (ReloadSpilledNode(spill, spilled_idx, *reloaded)) {
+                tail->next_ = reloaded;
+                tail = reloaded;
+                parent = reloaded;
+            } else {
+                ReleaseNode(pool, reloaded);
+                continue;
+            }
+        }
 
         // 检查终止条件: 无可分支节点
         if (parent == nullptr) {
@@ -367,9 +659,9 @@ int RunBranchAndPrice(ProblemParams& params, ProblemData& data, BPNode* root) {
         LOG_FMT("[BP] 选择节点 %d 进行分支 (LB=%.4f)\n",
             parent->id_, parent->lower_bound_);
 
-        // 统计活动节点数和已剪枝节点数
-        int active_count = 0;
-        int pruned_count = 0;
+        // 统计活动节点数和已剪枝节点数 (含已归还的剪枝节点与磁盘上的节点)
+        int active_count = static_cast<int>(spill.entries_.size());
+        int pruned_count = released_pruned;
         BPNode* stat_node = head;
         while (stat_node != nullptr) {
             if (stat_node->prune_flag_ == 1) {
@@ -379,6 +671,8 @@ int RunBranchAndPrice(ProblemParams& params, ProblemData& data, BPNode* root) {
             }
             stat_node = stat_node->next_;
         }
+        LogTreeSelected(params, parent, active_count);
+        LogTreeBranched(params, parent);
 
         // 控制台进度: 每个节点都输出 (带时间戳和详细信息)
         double lb = parent->lower_bound_;
@@ -395,14 +689,13 @@ int RunBranchAndPrice(ProblemParams& params, ProblemData& data, BPNode* root) {
         }
 
         // 创建并求解左子节点
-        BPNode* left = new BPNode();
+        BPNode* left = AllocNode(pool);
         node_count++;
         params.node_counter_++;
         CreateLeftChild(parent, params.node_counter_, left);
 
-        // 求解左子节点的列生成
-        // 子问题会应用该节点累积的 Arc 约束
-        SolveNodeCG(params, data, left);
+        // 求解左子节点的列生成 (父节点下界已无法改进最优整数解时跳过)
+        SolveChildNode(params, data, parent, left);
 
         // 将左子节点加入链表
         tail->next_ = left;
@@ -410,12 +703,6 @@ int RunBranchAndPrice(ProblemParams& params, ProblemData& data, BPNode* root) {
 
         // 检查左子节点
         if (left->prune_flag_ == 0) {
-            // 节点可行，为解生成 Arc 集合
-            GenerateYArcSetMatrix(*left, data.strip_widths_);
-            for (int j = 0; j < params.num_strip_types_; j++) {
-                GenerateXArcSetMatrix(*left, data.item_lengths_, j);
-            }
-
             // 检查是否为整数解
             int left_branch_type = SelectBranchArc(params, data, left);
             if (left_branch_type == kBranchNone) {
@@ -423,22 +710,24 @@ int RunBranchAndPrice(ProblemParams& params, ProblemData& data, BPNode* root) {
                 if (left->solution_.obj_val_ < params.global_best_int_) {
                     // 更新全局最优整数解
                     params.global_best_int_ = left->solution_.obj_val_;
-                    params.global_best_y_cols_ = left->solution_.y_columns_;
-                    params.global_best_x_cols_ = left->solution_.x_columns_;
+                    params.global_best_sol_ = left->solution_;
                     LOG_FMT("[BP] 找到新整数解, 目标值=%.4f\n", params.global_best_int_);
+                    LogTreeIncumbent(params, left);
                 }
+                LogTreePruned(params, left->id_, left->lower_bound_, "integer");
                 left->branched_flag_ = 1;  // 整数解无需再分支
             }
             // 否则 left->branch_type_ 已由 SelectBranchArc 设置，等待后续分支
         }
 
         // 创建并求解右子节点
-        BPNode* right = new BPNode();
+        BPNode* right = AllocNode(pool);
         node_count++;
         params.node_counter_++;
         CreateRightChild(parent, params.node_counter_, right);
 
-        SolveNodeCG(params, data, right);
+        // 左子节点可能刚更新了最优整数解, 右子节点再预筛一次
+        SolveChildNode(params, data, parent, right);
 
         // 将右子节点加入链表
         tail->next_ = right;
@@ -446,19 +735,15 @@ int RunBranchAndPrice(ProblemParams& params, ProblemData& data, BPNode* root) {
 
         // 检查右子节点
         if (right->prune_flag_ == 0) {
-            GenerateYArcSetMatrix(*right, data.strip_widths_);
-            for (int j = 0; j < params.num_strip_types_; j++) {
-                GenerateXArcSetMatrix(*right, data.item_lengths_, j);
-            }
-
             int right_branch_type = SelectBranchArc(params, data, right);
             if (right_branch_type == kBranchNone) {
                 if (right->solution_.obj_val_ < params.global_best_int_) {
                     params.global_best_int_ = right->solution_.obj_val_;
-                    params.global_best_y_cols_ = right->solution_.y_columns_;
-                    params.global_best_x_cols_ = right->solution_.x_columns_;
+                    params.global_best_sol_ = right->solution_;
                     LOG_FMT("[BP] 找到新整数解, 目标值=%.4f\n", params.global_best_int_);
+                    LogTreeIncumbent(params, right);
                 }
+                LogTreePruned(params, right->id_, right->lower_bound_, "integer");
                 right->branched_flag_ = 1;
             }
         }
@@ -475,11 +760,41 @@ int RunBranchAndPrice(ProblemParams& params, ProblemData& data, BPNode* root) {
                     curr->prune_flag_ = 1;
                     LOG_FMT("[BP] 节点 %d 被剪枝 (LB=%.4f >= UB=%.4f)\n",
                         curr->id_, curr->lower_bound_, params.global_best_int_);
+                    LogTreePruned(params, curr->id_, curr->lower_bound_, "bound");
                 }
             }
             curr = curr->next_;
         }
 
+        // 磁盘上的溢出节点同样按下界剪枝
+        for (const auto& entry : spill.entries_) {
+            if (entry.lower_bound_ >= params.global_best_int_ - kZeroTolerance) {
+                LogTreePruned(params, entry.id_, entry.lower_bound_, "bound");
+            }
+        }
+        released_pruned += DropSpilledNodes(spill, params.global_best_int_);
+
+        // 回收: 已剪枝、整数解或已分支的节点不再需要, 移出链表并归还节点池
+        // 根节点由调用方持有, 始终保留在链表头
+        BPNode* prev = head;
+        curr = head->next_;
+        while (curr != nullptr) {
+            BPNode* next = curr->next_;
+            if (curr->prune_flag_ == 1 || curr->branched_flag_ == 1) {
+                if (curr->prune_flag_ == 1) {
+                    released_pruned++;
+                } else {
+                    released_lb = min(released_lb, curr->lower_bound_);
+                }
+                prev->next_ = next;
+                if (curr == tail) tail = prev;
+                ReleaseNode(pool, curr);
+            } else {
+                prev = curr;
+            }
+            curr = next;
+        }
+
         // 检查时间限制 (使用用户设置的时间限制)
         if (params.time_limit_ > 0 && IsTimeUp(params)) {
             params.is_timeout_ = true;
@@ -494,35 +809,24 @@ int RunBranchAndPrice(ProblemParams& params, ProblemData& data, BPNode* root) {
         }
     }
 
+    // 结束时的检查点 (在根节点取整之前写出, 继续求解时不会把取整解当作上界)
+    if (use_checkpoint) {
+        checkpoint_stats.released_lb_ = released_lb;
+        checkpoint_stats.released_pruned_ = released_pruned;
+        WriteBPCheckpoint(params, data, root, spill, checkpoint_stats, prior_elapsed);
+    }
+
     // 如果未找到整数解，使用根节点 LP 解的向上取整作为可行解
     if (params.global_best_int_ >= INFINITY) {
-        LOG("[BP] 未找到整数解, 使用根节点 LP 解向上取整");
-
-        // 对 Y 列取整 (向上取整确保可行性)
-        params.global_best_y_cols_ = root->solution_.y_columns_;
-        double rounded_obj = 0.0;
-        for (auto& y_col : params.global_best_y_cols_) {
-            if (y_col.value_ > kZeroTolerance) {
-                y_col.value_ = ceil(y_col.value_);
-                rounded_obj += y_col.value_;
-            }
-        }
-
-        // 对 X 列取整
-        params.global_best_x_cols_ = root->solution_.x_columns_;
-        for (auto& x_col : params.global_best_x_cols_) {
-            if (x_col.value_ > kZeroTolerance) {
-                x_col.value_ = ceil(x_col.value_);
-            }
-        }
-
-        params.global_best_int_ = rounded_obj;
-        LOG_FMT("[BP] 取整后目标值: %.4f (非最优)\n", params.global_best_int_);
+        RoundRootSolution(params, root);
     }
 
     // 计算最优性间隙
-    // gap = (UB - LB) / UB，其中 LB 是所有未剪枝节点下界的最小值
-    double best_lb = INFINITY;
+    // gap = (UB - LB) / UB，其中 LB 是所有未剪枝节点 (含已归还节点) 下界的最小值
+    double best_lb = released_lb;
+    for (const auto& entry : spill.entries_) {
+        best_lb = min(best_lb, entry.lower_bound_);
+    }
     BPNode* curr = head;
     while (curr != nullptr) {
         if (curr->prune_flag_ == 0 && curr->lower_bound_ < best_lb) {
@@ -531,12 +835,18 @@ int RunBranchAndPrice(ProblemParams& params, ProblemData& data, BPNode* root) {
         curr = curr->next_;
     }
 
+    params.optimal_lb_ = best_lb;
     if (params.global_best_int_ < INFINITY && best_lb < INFINITY) {
         params.gap_ = (params.global_best_int_ - best_lb) / params.global_best_int_;
     }
 
     LOG_FMT("[BP] 分支定价结束, 最优解=%.4f, 间隙=%.2f%%\n",
         params.global_best_int_, params.gap_ * 100);
+    LogNodePoolStats(pool);
+    if (!data.cut_pool_.empty()) {
+        LOG_FMT("[BP] 割池: %d 条秩1割\n", (int)data.cut_pool_.size());
+    }
+    CloseNodeSpill(spill);
 
     return 0;
 }
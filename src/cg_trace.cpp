@@ -0,0 +1,185 @@
+// cg_trace.cpp - 列生成逐次迭代记录 (--cg-trace <file>)
+//
+// 根节点同步列生成和各分支节点的列生成, 每次迭代写出一条记录, 供离线分析收敛过程:
+//   node, iter               节点编号, 迭代次数
+//   rmp_obj                  迭代开始时的 RMP 目标值
+//   lagrangian_bound         按本次迭代 reduced cost 计算的 Lagrange 下界 (见下)
+//   rmp_rows, rmp_cols       RMP 行数 / 列数
+//   master_solves, master_ms 本次迭代加列后的 RMP 重解次数与耗时
+//   sp1_added, sp1_rc, sp1_ms            SP1 加列数、最小 reduced cost、求解耗时
+//   sp2_added_j, sp2_rc_j, sp2_ms_j      各条带类型 SP2 的同上三项
+// SP1 找到改进列的迭代不求解 SP2, 对应字段为空 (JSON 中为 null)
+//
+// Lagrange 下界: 任一可行解满足 z = Σ rc·x + y·b >= z_RMP + Σ rc·x, 且 Y 列数 = z,
+// j 型条带数 <= n_j·z (n_j = 一块母板上 j 型条带的最大数量), 因此
+//   z* >= z_RMP / (1 - min(0, rc_SP1) - Σ_j n_j·min(0, rc_SP2_j))
+// 要求所有子问题按同一组对偶价格求解, 即本次迭代 SP1 收敛且扫描 SP2 期间没有重解 RMP;
+// 否则该字段为空
+// 流水线列生成阶段 (--cg-threads) 不记录
+
+#include "2DBP.h"
+
+using namespace std;
+
+static ofstream g_cg_trace;
+static bool g_cg_trace_jsonl = false;
+static vector<int> g_cg_trace_max_strips;   // n_j
+
+// 追加一个数值字段, NaN 写为空 (CSV) 或 null (JSON)
+static void AppendValue(string& line, double value, const char* format) {
+    if (isnan(value)) {
+        if (g_cg_trace_jsonl) line += "null";
+        return;
+    }
+    char buf[64];
+    snprintf(buf, sizeof(buf), format, value);
+    line += buf;
+}
+
+bool OpenCGTrace(const string& path, ProblemParams& params, ProblemData& data) {
+    g_cg_trace.open(path);
+    if (!g_cg_trace) {
+        LOG_WARN_FMT("[错误] 无法写入列生成记录文件: %s\n", path.c_str());
+        return false;
+    }
+
+    string ext = filesystem::path(path).extension().string();
+    g_cg_trace_jsonl = ext == ".jsonl" || ext == ".json";
+    g_cg_trace_max_strips = data.strip_max_per_plate_;
+
+    if (!g_cg_trace_jsonl) {
+        g_cg_trace << "node,iter,rmp_obj,lagrangian_bound,rmp_rows,rmp_cols,"
+                   << "master_solves,master_ms,sp1_added,sp1_rc,sp1_ms";
+        for (int j = 0; j < params.num_strip_types_; j++) {
+            g_cg_trace << ",sp2_added_" << j << ",sp2_rc_" << j << ",sp2_ms_" << j;
+        }
+        g_cg_trace << "\n";
+    }
+
+    LOG_FMT("[系统] 列生成记录: %s (%s)\n", path.c_str(), g_cg_trace_jsonl ? "JSONL" : "CSV");
+    return true;
+}
+
+void CloseCGTrace() {
+    if (g_cg_trace.is_open()) g_cg_trace.close();
+}
+
+void BeginCGIterTrace(CGIterTrace& trace, ProblemParams& params, int node_id, int iter,
+    IloCplex& cplex, IloRangeArray& cons, IloNumVarArray& vars) {
+    trace.active_ = g_cg_trace.is_open();
+    if (!trace.active_) return;
+
+    int num_strip_types = params.num_strip_types_;
+    trace.node_id_ = node_id;
+    trace.iter_ = iter;
+    trace.rmp_obj_ = cplex.getObjValue();
+    trace.rmp_rows_ = static_cast<int>(cons.getSize());
+    trace.rmp_cols_ = static_cast<int>(vars.getSize());
+    trace.master_solves_ = 0;
+    trace.master_ms_ = 0.0;
+    trace.sp1_added_ = 0;
+    trace.sp1_rc_ = NAN;
+    trace.sp1_ms_ = NAN;
+    trace.sp2_added_.assign(num_strip_types, 0);
+    trace.sp2_rc_.assign(num_strip_types, NAN);
+    trace.sp2_ms_.assign(num_strip_types, NAN);
+    trace.same_duals_ = true;
+}
+
+void TraceSP1(CGIterTrace& trace, const BPNode& node, bool converged, int64_t start_ns) {
+    if (!trace.active_) return;
+    trace.sp1_ms_ = (ProfileNow() - start_ns) / 1.0e6;
+    trace.sp1_rc_ = 1.0 - node.price_value_;
+    trace.sp1_added_ = converged ? 0 : 1;
+}
+
+void TraceSP2(CGIterTrace& trace, const BPNode& node, int strip_type_id,
+    bool converged, int64_t start_ns) {
+    if (!trace.active_) return;
+    trace.sp2_ms_[strip_type_id] = (ProfileNow() - start_ns) / 1.0e6;
+    trace.sp2_rc_[strip_type_id] = node.duals_[strip_type_id] - node.price_value_;
+    trace.sp2_added_[strip_type_id] = converged ? 0 : 1;
+    if (trace.master_solves_ > 0) trace.same_duals_ = false;
+}
+
+void TraceMasterSolve(CGIterTrace& trace, int64_t start_ns) {
+    if (!trace.active_) return;
+    trace.master_solves_++;
+    trace.master_ms_ += (ProfileNow() - start_ns) / 1.0e6;
+}
+
+// Lagrange 下界, 条件不满足时返回 NaN
+static double LagrangianBound(const CGIterTrace& trace) {
+    if (!trace.same_duals_ || isnan(trace.sp1_rc_)) return NAN;
+    double denom = 1.0 - min(0.0, trace.sp1_rc_);
+    for (size_t j = 0; j < trace.sp2_rc_.size(); j++) {
+        if (isnan(trace.sp2_rc_[j])) return NAN;
+        denom -= g_cg_trace_max_strips[j] * min(0.0, trace.sp2_rc_[j]);
+    }
+    return trace.rmp_obj_ / denom;
+}
+
+// SP2 加列数, 本次迭代未求解时为 NaN
+static double SP2Added(const CGIterTrace& trace, size_t j) {
+    return isnan(trace.sp2_ms_[j]) ? NAN : trace.sp2_added_[j];
+}
+
+void WriteCGIterTrace(CGIterTrace& trace) {
+    if (!trace.active_) return;
+    trace.active_ = false;  // 每次迭代只写一次
+
+    string line;
+    double bound = LagrangianBound(trace);
+    if (g_cg_trace_jsonl) {
+        line += "{\"node\":" + to_string(trace.node_id_) + ",\"iter\":" + to_string(trace.iter_);
+        line += ",\"rmp_obj\":";
+        AppendValue(line, trace.rmp_obj_, "%.6f");
+        line += ",\"lagrangian_bound\":";
+        AppendValue(line, bound, "%.6f");
+        line += ",\"rmp_rows\":" + to_string(trace.rmp_rows_);
+        line += ",\"rmp_cols\":" + to_string(trace.rmp_cols_);
+        line += ",\"master_solves\":" + to_string(trace.master_solves_);
+        line += ",\"master_ms\":";
+        AppendValue(line, trace.master_ms_, "%.3f");
+        line += ",\"sp1\":{\"added\":" + to_string(trace.sp1_added_) + ",\"rc\":";
+        AppendValue(line, trace.sp1_rc_, "%.6f");
+        line += ",\"ms\":";
+        AppendValue(line, trace.sp1_ms_, "%.3f");
+        line += "},\"sp2\":[";
+        for (size_t j = 0; j < trace.sp2_rc_.size(); j++) {
+            line += j == 0 ? "" : ",";
+            line += "{\"added\":";
+            AppendValue(line, SP2Added(trace, j), "%.0f");
+            line += ",\"rc\":";
+            AppendValue(line, trace.sp2_rc_[j], "%.6f");
+            line += ",\"ms\":";
+            AppendValue(line, trace.sp2_ms_[j], "%.3f");
+            line += "}";
+        }
+        line += "]}\n";
+    } else {
+        line += to_string(trace.node_id_) + "," + to_string(trace.iter_) + ",";
+        AppendValue(line, trace.rmp_obj_, "%.6f");
+        line += ",";
+        AppendValue(line, bound, "%.6f");
+        line += "," + to_string(trace.rmp_rows_) + "," + to_string(trace.rmp_cols_);
+        line += "," + to_string(trace.master_solves_) + ",";
+        AppendValue(line, trace.master_ms_, "%.3f");
+        line += "," + to_string(trace.sp1_added_) + ",";
+        AppendValue(line, trace.sp1_rc_, "%.6f");
+        line += ",";
+        AppendValue(line, trace.sp1_ms_, "%.3f");
+        for (size_t j = 0; j < trace.sp2_rc_.size(); j++) {
+            line += ",";
+            AppendValue(line, SP2Added(trace, j), "%.0f");
+            line += ",";
+            AppendValue(line, trace.sp2_rc_[j], "%.6f");
+            line += ",";
+            AppendValue(line, trace.sp2_ms_[j], "%.3f");
+        }
+        line += "\n";
+    }
+
+    // 逐条刷新: 超时或异常退出时已写出的迭代仍完整
+    g_cg_trace << line << flush;
+}
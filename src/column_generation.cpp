@@ -1,6 +1,6 @@
 // column_generation.cpp - 列生成方法选择与调度
 //
-// 本文件实现子问题求解方法的选择和调度
+// 本文件实现子问题求解方法的选择和调度, 并按方法计时 (profiler.h)
 // 支持三种子问题求解方法:
 // - kCplexIP (0): 使用CPLEX求解整数背包问题 (默认方法)
 // - kArcFlow (1): 使用Arc Flow网络流模型 (支持Arc分支)
@@ -21,18 +21,25 @@ using namespace std;
 // 返回值: true=列生成收敛, false=找到改进列
 bool SolveRootSP1(ProblemParams& params, ProblemData& data, BPNode& node) {
     int method = node.sp1_method_;
+    node.price_value_ = NAN;  // 子问题不可行时保持 NaN
 
     switch (method) {
-        case kArcFlow:
+        case kArcFlow: {
             // Arc Flow: 支持Arc分支约束
+            PROFILE_ZONE("sp1.root.arcflow");
             return SolveRootSP1ArcFlow(params, data, node);
-        case kDP:
+        }
+        case kDP: {
             // 动态规划: 快速但不支持Arc约束
+            PROFILE_ZONE("sp1.root.dp");
             return SolveRootSP1DP(params, data, node);
+        }
         case kCplexIP:
-        default:
+        default: {
             // CPLEX整数规划: 通用方法
+            PROFILE_ZONE("sp1.root.knapsack");
             return SolveRootSP1Knapsack(params, data, node);
+        }
     }
 }
 
@@ -46,15 +53,27 @@ bool SolveRootSP2(ProblemParams& params, ProblemData& data,
     BPNode& node, int strip_type_id) {
 
     int method = node.sp2_method_;
+    node.price_value_ = NAN;
 
     switch (method) {
-        case kArcFlow:
+        case kArcFlow: {
+            // 长条带使用隐式网络, 以最长路代替 Arc Flow 模型
+            if (data.sp2_arc_data_.implicit_) {
+                PROFILE_ZONE("sp2.root.implicit");
+                return SolveRootSP2Implicit(params, data, node, strip_type_id);
+            }
+            PROFILE_ZONE("sp2.root.arcflow");
             return SolveRootSP2ArcFlow(params, data, node, strip_type_id);
-        case kDP:
+        }
+        case kDP: {
+            PROFILE_ZONE("sp2.root.dp");
             return SolveRootSP2DP(params, data, node, strip_type_id);
+        }
         case kCplexIP:
-        default:
+        default: {
+            PROFILE_ZONE("sp2.root.knapsack");
             return SolveRootSP2Knapsack(params, data, node, strip_type_id);
+        }
     }
 }
 
@@ -63,37 +82,101 @@ bool SolveRootSP2(ProblemParams& params, ProblemData& data,
 // 注意: 若有Arc分支约束, 应使用Arc Flow方法
 bool SolveNodeSP1(ProblemParams& params, ProblemData& data, BPNode* node) {
     int method = node->sp1_method_;
+    node->price_value_ = NAN;
 
     switch (method) {
-        case kArcFlow:
+        case kArcFlow: {
             // Arc Flow: 在函数内部应用sp1_*_arcs_约束
+            PROFILE_ZONE("sp1.node.arcflow");
             return SolveNodeSP1ArcFlow(params, data, node);
-        case kDP:
+        }
+        case kDP: {
             // DP不支持Arc约束, 可能导致分支无效
+            PROFILE_ZONE("sp1.node.dp");
             return SolveNodeSP1DP(params, data, node);
+        }
         case kCplexIP:
-        default:
+        default: {
             // CPLEX背包不包含Arc约束
+            PROFILE_ZONE("sp1.node.knapsack");
             return SolveNodeSP1Knapsack(params, data, node);
+        }
     }
 }
 
 // 非根节点SP2子问题方法选择
 // 功能: 与根节点类似, 但使用指针访问节点
 // 注意: Arc约束按条带类型索引存储在sp2_*_arcs_中
+// 节点含对偶价格为正的割行时, 以下各方法都不含割收益, 统一改用标签定价
 bool SolveNodeSP2(ProblemParams& params, ProblemData& data,
     BPNode* node, int strip_type_id) {
 
+    node->price_value_ = NAN;
+    for (const auto& cut_row : node->cut_rows_) {
+        if (cut_row.dual_ > kZeroTolerance) {
+            PROFILE_ZONE("sp2.node.labels");
+            return SolveNodeSP2Labels(params, data, node, strip_type_id);
+        }
+    }
+
     int method = node->sp2_method_;
 
     switch (method) {
-        case kArcFlow:
+        case kArcFlow: {
             // Arc Flow: 在函数内部应用sp2_*_arcs_[strip_type_id]约束
+            // 长条带使用隐式网络, 禁用Arc在最长路中跳过
+            if (data.sp2_arc_data_.implicit_) {
+                PROFILE_ZONE("sp2.node.implicit");
+                return SolveNodeSP2Implicit(params, data, node, strip_type_id);
+            }
+            PROFILE_ZONE("sp2.node.arcflow");
             return SolveNodeSP2ArcFlow(params, data, node, strip_type_id);
-        case kDP:
+        }
+        case kDP: {
+            PROFILE_ZONE("sp2.node.dp");
             return SolveNodeSP2DP(params, data, node, strip_type_id);
+        }
         case kCplexIP:
-        default:
+        default: {
+            PROFILE_ZONE("sp2.node.knapsack");
             return SolveNodeSP2Knapsack(params, data, node, strip_type_id);
+        }
+    }
+}
+
+// 向背包 DP 表加入一种物品 (DP 子问题共用)
+// dp[c] / choice[c]: 容量 c 下的最大价值及对应方案, type 为物品在方案中的下标
+// max_count 不小于 容量 / size 时按完全背包从小到大转移;
+// 否则按二进制拆分 (1, 2, 4, ..., 余数) 做若干次 0-1 背包转移, 保证数量不超过 max_count
+void AddKnapsackItem(vector<double>& dp, vector<vector<int>>& choice,
+    int type, int size, double value, int max_count) {
+
+    int capacity = static_cast<int>(dp.size()) - 1;
+    if (size <= 0 || size > capacity || max_count <= 0) return;
+
+    if (max_count >= capacity / size) {
+        for (int c = size; c <= capacity; c++) {
+            if (dp[c - size] + value > dp[c]) {
+                dp[c] = dp[c - size] + value;
+                choice[c] = choice[c - size];
+                choice[c][type]++;
+            }
+        }
+        return;
+    }
+
+    int remaining = max_count;
+    for (int chunk = 1; remaining > 0; chunk *= 2) {
+        int count = min(chunk, remaining);
+        remaining -= count;
+        int chunk_size = count * size;
+        double chunk_value = count * value;
+        for (int c = capacity; c >= chunk_size; c--) {
+            if (dp[c - chunk_size] + chunk_value > dp[c]) {
+                dp[c] = dp[c - chunk_size] + chunk_value;
+                choice[c] = choice[c - chunk_size];
+                choice[c][type] += count;
+            }
+        }
     }
 }
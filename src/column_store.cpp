@@ -0,0 +1,87 @@
+// column_store.cpp - 列池存储 (SoA 布局)
+//
+// 全部 Y 列 / X 列分别存放在一个 ColumnStore 中:
+// - 切割方案为一块行优先的连续系数矩阵 (int16 或 int32)
+// - 取值、条带类型、变量索引各为连续数组
+// - Arc 集合按 CSR (偏移 + 编号) 存储
+// 与逐列分配 vector/set 的方式相比, 列数很多时内存更紧凑,
+// 扫描列 (约化成本、Arc流量转换、导出) 时访存连续
+
+#include "2DBP.h"
+
+using namespace std;
+
+// 初始化空列池
+// width: 每列系数个数 (Y列 = 条带类型数, X列 = 子板类型数)
+// max_coef: 系数上界, 不超过 int16 范围时使用 int16 存储
+void InitColumnStore(ColumnStore& store, int width, int max_coef) {
+    store.width_ = width;
+    store.num_cols_ = 0;
+    store.wide_ = (max_coef > INT16_MAX);
+
+    store.patterns16_.clear();
+    store.patterns32_.clear();
+    store.values_.clear();
+    store.strip_types_.clear();
+    store.var_indices_.clear();
+    store.arc_offsets_.assign(1, 0);
+    store.arc_ids_.clear();
+}
+
+// 追加一列
+// pattern: 长度为 width_ 的系数向量
+// strip_type: X 列所属条带类型, Y 列传 -1
+// arc_ids: 该列的规范 Arc 编号 (升序, 由 ComputeY/XColumnArcIds 给出)
+// 返回值: 新列的编号
+int AppendColumn(ColumnStore& store, const vector<int>& pattern,
+    int strip_type, const vector<int>& arc_ids) {
+
+    for (int row = 0; row < store.width_; row++) {
+        if (store.wide_) {
+            store.patterns32_.push_back(static_cast<int32_t>(pattern[row]));
+        } else {
+            store.patterns16_.push_back(static_cast<int16_t>(pattern[row]));
+        }
+    }
+    store.values_.push_back(0.0);
+    store.strip_types_.push_back(strip_type);
+    store.var_indices_.push_back(-1);
+    store.arc_ids_.insert(store.arc_ids_.end(), arc_ids.begin(), arc_ids.end());
+    store.arc_offsets_.push_back(static_cast<int>(store.arc_ids_.size()));
+
+    return store.num_cols_++;
+}
+
+// 截断列池，只保留前 num_cols 列 (分布式工作进程丢弃已回传的新列)
+void TruncateColumnStore(ColumnStore& store, int num_cols) {
+    if (num_cols >= store.num_cols_) return;
+    size_t num_coefs = static_cast<size_t>(num_cols) * store.width_;
+    if (store.wide_) {
+        store.patterns32_.resize(num_coefs);
+    } else {
+        store.patterns16_.resize(num_coefs);
+    }
+    store.values_.resize(num_cols);
+    store.strip_types_.resize(num_cols);
+    store.var_indices_.resize(num_cols);
+    store.arc_ids_.resize(store.arc_offsets_[num_cols]);
+    store.arc_offsets_.resize(num_cols + 1);
+    store.num_cols_ = num_cols;
+}
+
+// 读取第 col 列的完整切割方案
+void GetColumnPattern(const ColumnStore& store, int col, vector<int>& pattern) {
+    pattern.resize(store.width_);
+    for (int row = 0; row < store.width_; row++) {
+        pattern[row] = GetPatternCoef(store, col, row);
+    }
+}
+
+// 判断第 col 列是否使用编号为 arc_id 的 Arc
+// 列内 Arc 编号升序存储, 二分查找
+bool ColumnUsesArc(const ColumnStore& store, int col, int arc_id) {
+    if (arc_id < 0) return false;
+    auto first = store.arc_ids_.begin() + store.arc_offsets_[col];
+    auto last = store.arc_ids_.begin() + store.arc_offsets_[col + 1];
+    return binary_search(first, last, arc_id);
+}
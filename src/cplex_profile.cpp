@@ -0,0 +1,248 @@
+// cplex_profile.cpp - 各求解阶段的 CPLEX 参数配置与自动调参
+//
+// 主问题与子问题默认全部使用 CPLEX 默认参数, 但各阶段的求解特点不同:
+// - 根节点 RMP: 每次只加入新列, 原基仍原始可行, 原始单纯形热启动最快
+// - 节点 RMP 建立 / 加入割行后: 新行使原基对偶可行, 适合对偶单纯形
+// - 节点 RMP 加列后: 同根节点, 原始单纯形
+// - 子问题: 小规模 MIP, 多线程启动开销常大于收益
+// 每个阶段一组参数 (LP 算法、线程数、并行模式), 可从配置文件读入 (--cplex-config <file>):
+//   [root_master]        # 节/阶段名: root_master, node_rows, node_columns, pricing
+//   algorithm = primal   # auto, primal, dual, network, barrier, sifting, concurrent
+//   threads = 0          # 0 = CPLEX 自动
+//   parallel = auto      # auto, deterministic, opportunistic
+//
+// 自动调参 (--tune <file>): 各主问题阶段的前若干次求解轮流尝试候选 LP 算法并计时,
+// 采样完成后该阶段改用平均耗时最短的算法, 程序结束时把结果写成配置文件供后续运行读入
+// 所有主问题求解都记录耗时, 结束时按阶段输出求解次数与平均耗时
+
+#include "2DBP.h"
+
+using namespace std;
+
+// 阶段名 (配置文件节名)
+static const char* kCplexPhaseNames[kNumCplexPhases] = {
+    "root_master", "node_rows", "node_columns", "pricing"
+};
+
+// 各主问题阶段 LP 求解的计时区域名 (子问题 MIP 的耗时由 sp1.* / sp2.* 区域记录)
+static const char* kCplexSolveZones[kNumMasterPhases] = {
+    "lp.root_master", "lp.node_rows", "lp.node_columns"
+};
+
+// LP 算法名, 下标为 CPLEX RootAlg 参数值
+static const char* kLpAlgorithmNames[kNumLpAlgorithms] = {
+    "auto", "primal", "dual", "network", "barrier", "sifting", "concurrent"
+};
+
+// 调参候选算法
+static const int kTuneAlgorithms[] = {kLpPrimal, kLpDual, kLpBarrier, kLpAuto};
+constexpr int kNumTuneAlgorithms = sizeof(kTuneAlgorithms) / sizeof(kTuneAlgorithms[0]);
+
+// 各阶段默认参数
+array<CplexProfile, kNumCplexPhases> DefaultCplexProfiles() {
+    array<CplexProfile, kNumCplexPhases> profiles;
+    profiles[kCplexRootMaster].algorithm_ = kLpPrimal;
+    profiles[kCplexNodeRows].algorithm_ = kLpDual;
+    profiles[kCplexNodeColumns].algorithm_ = kLpPrimal;
+    profiles[kCplexPricing].threads_ = 1;
+    profiles[kCplexPricing].parallel_mode_ = kParallelDeterministic;
+    return profiles;
+}
+
+// 设置 CPLEX 参数
+void ApplyCplexProfile(IloCplex& cplex, const CplexProfile& profile) {
+    cplex.setParam(IloCplex::Param::RootAlgorithm, profile.algorithm_);
+    cplex.setParam(IloCplex::Param::Threads, profile.threads_);
+    cplex.setParam(IloCplex::Param::Parallel, profile.parallel_mode_);
+}
+
+// 求解主问题: 按阶段设置参数 (调参时轮换候选算法) 并记录耗时
+// phase 为主问题阶段 (< kNumMasterPhases)
+bool SolveMasterLP(ProblemParams& params, IloCplex& cplex, int phase) {
+    CplexProfile profile = params.cplex_profiles_[phase];
+    CplexPhaseStats& stats = params.cplex_stats_[phase];
+
+    // 调参采样: 候选算法轮流使用, 每个算法 kTuneSamples 次
+    int sample_alg = -1;
+    if (params.cplex_tune_ && stats.tune_done_ == 0) {
+        int sample = stats.tune_samples_;
+        if (sample < kNumTuneAlgorithms * kTuneSamples) {
+            sample_alg = kTuneAlgorithms[sample % kNumTuneAlgorithms];
+            profile.algorithm_ = sample_alg;
+        }
+    }
+
+    ApplyCplexProfile(cplex, profile);
+    int64_t start_ns = ProfileNow();
+    bool feasible = cplex.solve();
+    int64_t end_ns = ProfileNow();
+    RecordProfileZone(kCplexSolveZones[phase], start_ns, end_ns);
+    double ms = (end_ns - start_ns) / 1.0e6;
+
+    stats.num_solves_++;
+    stats.total_ms_ += ms;
+
+    if (sample_alg >= 0) {
+        stats.tune_ms_[sample_alg] += ms;
+        stats.tune_count_[sample_alg]++;
+        stats.tune_samples_++;
+
+        // 采样完成: 改用平均耗时最短的算法
+        if (stats.tune_samples_ == kNumTuneAlgorithms * kTuneSamples) {
+            int best_alg = -1;
+            double best_ms = 0.0;
+            for (int alg : kTuneAlgorithms) {
+                double mean = stats.tune_ms_[alg] / stats.tune_count_[alg];
+                if (best_alg < 0 || mean < best_ms) {
+                    best_alg = alg;
+                    best_ms = mean;
+                }
+            }
+            params.cplex_profiles_[phase].algorithm_ = best_alg;
+            stats.tune_done_ = 1;
+            LOG_FMT("[CPLEX] 调参: %s 选用 %s (平均 %.3f ms)\n",
+                kCplexPhaseNames[phase], kLpAlgorithmNames[best_alg], best_ms);
+        }
+    }
+    return feasible;
+}
+
+static string TrimString(const string& s) {
+    size_t first = s.find_first_not_of(" \t\r");
+    if (first == string::npos) return "";
+    size_t last = s.find_last_not_of(" \t\r");
+    return s.substr(first, last - first + 1);
+}
+
+static int FindName(const char* const* names, int count, const string& name) {
+    for (int k = 0; k < count; k++) {
+        if (name == names[k]) return k;
+    }
+    return -1;
+}
+
+// 读取配置文件, 文件中未出现的阶段和参数保持原值
+// 返回值: true=成功, false=文件无法打开或格式错误
+bool LoadCplexProfiles(const string& path, ProblemParams& params) {
+    ifstream in(path);
+    if (!in) {
+        LOG_WARN_FMT("[错误] 无法打开CPLEX配置文件: %s\n", path.c_str());
+        return false;
+    }
+
+    int phase = -1;
+    string line;
+    for (int line_no = 1; getline(in, line); line_no++) {
+        size_t comment = line.find_first_of("#;");
+        if (comment != string::npos) line.erase(comment);
+        line = TrimString(line);
+        if (line.empty()) continue;
+
+        if (line.front() == '[' && line.back() == ']') {
+            string name = TrimString(line.substr(1, line.size() - 2));
+            phase = FindName(kCplexPhaseNames, kNumCplexPhases, name);
+            if (phase < 0) {
+                LOG_WARN_FMT("[错误] CPLEX配置 %s:%d 未知阶段 [%s]\n", path.c_str(), line_no, name.c_str());
+                return false;
+            }
+            continue;
+        }
+
+        size_t eq = line.find('=');
+        if (phase < 0 || eq == string::npos) {
+            LOG_WARN_FMT("[错误] CPLEX配置 %s:%d 格式错误\n", path.c_str(), line_no);
+            return false;
+        }
+        string key = TrimString(line.substr(0, eq));
+        string value = TrimString(line.substr(eq + 1));
+        CplexProfile& profile = params.cplex_profiles_[phase];
+
+        bool valid = true;
+        if (key == "algorithm") {
+            int alg = FindName(kLpAlgorithmNames, kNumLpAlgorithms, value);
+            valid = alg >= 0;
+            if (valid) profile.algorithm_ = alg;
+        } else if (key == "threads") {
+            valid = !value.empty() && value.find_first_not_of("0123456789") == string::npos;
+            if (valid) profile.threads_ = stoi(value);
+        } else if (key == "parallel") {
+            if (value == "auto") {
+                profile.parallel_mode_ = kParallelAuto;
+            } else if (value == "deterministic") {
+                profile.parallel_mode_ = kParallelDeterministic;
+            } else if (value == "opportunistic") {
+                profile.parallel_mode_ = kParallelOpportunistic;
+            } else {
+                valid = false;
+            }
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            LOG_WARN_FMT("[错误] CPLEX配置 %s:%d 无效参数 %s = %s\n",
+                path.c_str(), line_no, key.c_str(), value.c_str());
+            return false;
+        }
+    }
+
+    LOG_FMT("[系统] CPLEX配置: %s\n", path.c_str());
+    return true;
+}
+
+// 写出配置文件 (调参结果)
+bool SaveCplexProfiles(const string& path, const ProblemParams& params) {
+    ofstream out(path);
+    if (!out) {
+        LOG_WARN_FMT("[错误] 无法写入CPLEX配置文件: %s\n", path.c_str());
+        return false;
+    }
+
+    out << "# CS-2D-BP-Arc CPLEX 参数配置 (--tune 生成)\n";
+    out << "# 算例: " << params.instance_file_ << "\n";
+    for (int phase = 0; phase < kNumCplexPhases; phase++) {
+        const CplexProfile& profile = params.cplex_profiles_[phase];
+        const char* parallel = profile.parallel_mode_ == kParallelDeterministic ? "deterministic"
+            : profile.parallel_mode_ == kParallelOpportunistic ? "opportunistic" : "auto";
+        out << "\n[" << kCplexPhaseNames[phase] << "]\n";
+        out << "algorithm = " << kLpAlgorithmNames[profile.algorithm_] << "\n";
+        out << "threads = " << profile.threads_ << "\n";
+        out << "parallel = " << parallel << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+// 输出各阶段主问题的求解次数与平均耗时; 调参时写出配置文件
+void ReportCplexProfiles(ProblemParams& params) {
+    for (int phase = 0; phase < kNumMasterPhases; phase++) {
+        const CplexPhaseStats& stats = params.cplex_stats_[phase];
+        if (stats.num_solves_ == 0) continue;
+        LOG_FMT("[CPLEX] %-12s %s: 求解%d次, 平均 %.3f ms\n", kCplexPhaseNames[phase],
+            kLpAlgorithmNames[params.cplex_profiles_[phase].algorithm_],
+            stats.num_solves_, stats.total_ms_ / stats.num_solves_);
+    }
+
+    if (!params.cplex_tune_) return;
+
+    // 采样未完成的阶段按已有样本取平均耗时最短的算法
+    for (int phase = 0; phase < kNumMasterPhases; phase++) {
+        CplexPhaseStats& stats = params.cplex_stats_[phase];
+        if (stats.tune_done_ || stats.tune_samples_ == 0) continue;
+        int best_alg = -1;
+        double best_ms = 0.0;
+        for (int alg : kTuneAlgorithms) {
+            if (stats.tune_count_[alg] == 0) continue;
+            double mean = stats.tune_ms_[alg] / stats.tune_count_[alg];
+            if (best_alg < 0 || mean < best_ms) {
+                best_alg = alg;
+                best_ms = mean;
+            }
+        }
+        params.cplex_profiles_[phase].algorithm_ = best_alg;
+        LOG_FMT("[CPLEX] 调参: %s 样本不足 (%d次), 选用 %s\n", kCplexPhaseNames[phase],
+            stats.tune_samples_, kLpAlgorithmNames[best_alg]);
+    }
+
+    if (SaveCplexProfiles(params.cplex_tune_file_, params)) {
+        LOG_FMT("[CPLEX] 调参结果已写入 %s\n", params.cplex_tune_file_.c_str());
+    }
+}
@@ -0,0 +1,192 @@
+// cuts.cpp - 秩1割 (子集行割 / Chvátal-Gomory 割) 的分离与割池
+//
+// 两阶段模型的 Y/X 主问题 LP 下界在部分算例上不够紧, 分支树因此膨胀
+// 非根节点列生成收敛后, 在需求行上分离秩1割, 加入 RMP 后继续列生成 (分支切割定价):
+//   割 (S, q): Σ_p ceil(Σ_{i∈S} a_ip / q) X_p >= ceil(Σ_{i∈S} d_i / q)
+// 分离的割族:
+//   - 单行 / 两行 CG 割: |S| = 1, 2, q = 2 .. kMaxCutDenom
+//   - 子集行割 SR3: |S| = 3, q = 2, 只在分数解涉及最多的 kMaxSepItems 种子板上枚举
+//
+// 割对任意整数解有效, 与分支约束无关, 全部存入全局割池 (data.cut_pool_):
+//   - 节点分离时先扫描割池中未启用的割, 再枚举新割, 每轮按违反量取前 kMaxCutsPerRound 条
+//   - 节点列生成结束后只保留对偶价格为正的割, 由子节点继承
+// 割行对偶价格 ρ_c 使列收益不再按 Arc 可加, SP2 定价改用标签算法 (SolveSP2LabelPath)
+
+#include "2DBP.h"
+
+using namespace std;
+
+// 割系数 ceil(Σ_{i∈S} a_i / q), pattern 为 X 列切割方案
+int CutPatternCoef(const RankOneCut& cut, const vector<int>& pattern) {
+    int count = 0;
+    for (int i : cut.items_) count += pattern[i];
+    return (count + cut.denom_ - 1) / cut.denom_;
+}
+
+// 割系数, 列取自列池
+int CutColumnCoef(const RankOneCut& cut, const ColumnStore& store, int col) {
+    int count = 0;
+    for (int i : cut.items_) count += GetPatternCoef(store, col, i);
+    return (count + cut.denom_ - 1) / cut.denom_;
+}
+
+// 在割池中查找相同的割, 没有则追加; 割池已满时返回 -1
+int FindOrAddCut(ProblemData& data, const RankOneCut& cut) {
+    for (int id = 0; id < (int)data.cut_pool_.size(); id++) {
+        const RankOneCut& other = data.cut_pool_[id];
+        if (other.denom_ == cut.denom_ && other.items_ == cut.items_) return id;
+    }
+    if ((int)data.cut_pool_.size() >= kMaxCutPoolSize) return -1;
+    data.cut_pool_.push_back(cut);
+    return static_cast<int>(data.cut_pool_.size()) - 1;
+}
+
+// 分离候选割
+struct CutCandidate {
+    RankOneCut cut_;
+    int pool_id_ = -1;          // 已在割池中时为割池下标
+    double violation_ = 0.0;    // rhs - lhs
+};
+
+// 节点 LP 解上分离秩1割, 追加到 node->cut_ids_, 返回新加入的割数
+// 需在 SolveNodeFinalMP 之后调用 (使用 node->solution_ 的 X 列取值)
+int SeparateRankOneCuts(ProblemParams& params, ProblemData& data, BPNode* node) {
+    PROFILE_ZONE("cuts.separate");
+
+    int num_item_types = params.num_item_types_;
+    int room = kMaxNodeCuts - static_cast<int>(node->cut_ids_.size());
+    if (room <= 0) return 0;
+
+    const ColumnStore& x_store = data.x_columns_;
+    const auto& x_cols = node->solution_.x_cols_;
+    int num_cols = static_cast<int>(x_cols.size());
+    if (num_cols == 0) return 0;
+
+    // 非零 X 列的切割方案 (按列连续存放) 及取值
+    vector<int> counts(static_cast<size_t>(num_cols) * num_item_types);
+    vector<double> values(num_cols);
+    for (int p = 0; p < num_cols; p++) {
+        values[p] = x_cols[p].value_;
+        for (int i = 0; i < num_item_types; i++) {
+            counts[static_cast<size_t>(p) * num_item_types + i] =
+                GetPatternCoef(x_store, x_cols[p].col_, i);
+        }
+    }
+    auto count_of = [&](int p, int i) {
+        return counts[static_cast<size_t>(p) * num_item_types + i];
+    };
+
+    // 割在当前解上的违反量
+    auto violation_of = [&](const RankOneCut& cut) {
+        double lhs = 0.0;
+        for (int p = 0; p < num_cols; p++) {
+            int count = 0;
+            for (int i : cut.items_) count += count_of(p, i);
+            if (count > 0) lhs += values[p] * ((count + cut.denom_ - 1) / cut.denom_);
+        }
+        return cut.rhs_ - lhs;
+    };
+    auto make_cut = [&](vector<int> items, int denom) {
+        RankOneCut cut;
+        int demand = 0;
+        for (int i : items) demand += data.item_types_[i].demand_;
+        cut.items_ = move(items);
+        cut.denom_ = denom;
+        cut.rhs_ = (demand + denom - 1) / denom;
+        return cut;
+    };
+
+    set<int> active(node->cut_ids_.begin(), node->cut_ids_.end());
+    vector<CutCandidate> candidates;
+
+    // 1. 割池中未在本节点启用的割
+    for (int id = 0; id < (int)data.cut_pool_.size(); id++) {
+        if (active.count(id)) continue;
+        double violation = violation_of(data.cut_pool_[id]);
+        if (violation > kCutViolationTol) {
+            candidates.push_back({data.cut_pool_[id], id, violation});
+        }
+    }
+
+    // 分数解涉及的子板: 按 Σ frac(x_p) * a_ip 取前 kMaxSepItems 种
+    vector<double> weight(num_item_types, 0.0);
+    for (int p = 0; p < num_cols; p++) {
+        double frac = values[p] - floor(values[p]);
+        if (frac < kIntTolerance || frac > 1.0 - kIntTolerance) continue;
+        for (int i = 0; i < num_item_types; i++) {
+            weight[i] += frac * count_of(p, i);
+        }
+    }
+    vector<int> items;
+    for (int i = 0; i < num_item_types; i++) {
+        if (weight[i] > kZeroTolerance) items.push_back(i);
+    }
+    if ((int)items.size() > kMaxSepItems) {
+        partial_sort(items.begin(), items.begin() + kMaxSepItems, items.end(),
+            [&](int a, int b) { return weight[a] > weight[b]; });
+        items.resize(kMaxSepItems);
+    }
+    sort(items.begin(), items.end());
+    int num_sep = static_cast<int>(items.size());
+
+    auto try_cut = [&](vector<int> cut_items, int denom) {
+        RankOneCut cut = make_cut(move(cut_items), denom);
+        double violation = violation_of(cut);
+        if (violation > kCutViolationTol) {
+            candidates.push_back({move(cut), -1, violation});
+        }
+    };
+
+    // 2. 单行 / 两行 CG 割 (Σ d_i 为 q 的倍数时不可能违反)
+    for (int a = 0; a < num_sep; a++) {
+        for (int q = 2; q <= kMaxCutDenom; q++) {
+            if (data.item_types_[items[a]].demand_ % q != 0) try_cut({items[a]}, q);
+        }
+        for (int b = a + 1; b < num_sep; b++) {
+            int demand = data.item_types_[items[a]].demand_ + data.item_types_[items[b]].demand_;
+            for (int q = 2; q <= kMaxCutDenom; q++) {
+                if (demand % q != 0) try_cut({items[a], items[b]}, q);
+            }
+        }
+    }
+
+    // 3. SR3 (Σ d_i 为偶数时不可能违反)
+    for (int a = 0; a < num_sep; a++) {
+        for (int b = a + 1; b < num_sep; b++) {
+            for (int c = b + 1; c < num_sep; c++) {
+                int demand = data.item_types_[items[a]].demand_ +
+                    data.item_types_[items[b]].demand_ + data.item_types_[items[c]].demand_;
+                if (demand % 2 != 0) try_cut({items[a], items[b], items[c]}, 2);
+            }
+        }
+    }
+
+    // 按违反量从大到小加入, 重复的割 (同一割池下标) 只加一次
+    sort(candidates.begin(), candidates.end(),
+        [](const CutCandidate& a, const CutCandidate& b) { return a.violation_ > b.violation_; });
+    int limit = min(room, kMaxCutsPerRound);
+    int num_added = 0;
+    for (const auto& candidate : candidates) {
+        if (num_added >= limit) break;
+        int id = candidate.pool_id_ >= 0 ? candidate.pool_id_ : FindOrAddCut(data, candidate.cut_);
+        if (id < 0 || active.count(id)) continue;
+        active.insert(id);
+        node->cut_ids_.push_back(id);
+        num_added++;
+    }
+
+    LOG_FMT("[Cut] 节点%d 分离: 候选%d条, 加入%d条 (子板%d种, 割池%d条)\n",
+        node->id_, (int)candidates.size(), num_added, num_sep, (int)data.cut_pool_.size());
+    return num_added;
+}
+
+// 节点列生成结束后只保留对偶价格为正的割, 由子节点继承
+// 松弛的割仍在割池中, 之后的节点分离时可重新启用
+void DropSlackCuts(BPNode* node) {
+    vector<int> kept;
+    for (const auto& cut_row : node->cut_rows_) {
+        if (cut_row.dual_ > kZeroTolerance) kept.push_back(cut_row.cut_id_);
+    }
+    node->cut_ids_ = kept;
+    node->cut_rows_.clear();
+}
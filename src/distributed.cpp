@@ -0,0 +1,663 @@
+// distributed.cpp - 分布式分支定价 (协调进程 / 工作进程, TCP)
+//
+// 协调进程 (--serve <port>) 完成根节点列生成后持有分支树、列池与最优整数解，
+// 工作进程 (--worker <host:port>) 读取同一算例、完成预处理与建网后连接协调进程:
+// - 协调进程把待分支节点 (累积 Arc 约束 + 待分支 Arc) 连同该工作进程尚未拥有的列发给空闲工作进程
+// - 工作进程创建左右子节点, 在本地执行 SolveNodeCG / SelectBranchArc,
+//   回传两个子节点的记录 (下界、待分支 Arc、非零列) 与本次生成的新列
+// - 协调进程把新列追加到全局列池并重映射子节点解中的列号, 更新最优整数解、剪枝并继续派发
+//
+// 工作进程的列池始终是全局列池的前缀: 回传新列后即截断, 这些列随下一个任务重新下发
+// 割池同样按前缀同步: 工作进程分离的新割随结果回传, 协调进程去重后追加并重映射子节点的割下标
+// 同一主机上可启动多个工作进程; 工作进程可随时加入, 断开时其任务节点放回待处理列表
+//
+// 消息格式: [类型 int32][长度 int32][负载], 负载由 serialize.cpp 的二进制记录组成
+
+#include "2DBP.h"
+
+#include <csignal>
+#include <cstring>  // for memcpy, memset
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+#ifdef _WIN32
+using SocketHandle = SOCKET;
+const SocketHandle kInvalidSocket = INVALID_SOCKET;
+static void CloseSocket(SocketHandle sock) { closesocket(sock); }
+#else
+using SocketHandle = int;
+const SocketHandle kInvalidSocket = -1;
+static void CloseSocket(SocketHandle sock) { close(sock); }
+#endif
+
+// 对端已断开时 send 不触发 SIGPIPE, 而是返回 -1 (EPIPE), 由调用方按断开处理
+// 没有 MSG_NOSIGNAL 的平台在 InitSockets 中忽略 SIGPIPE
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+// 消息类型
+constexpr int32_t kMsgHello = 1;        // 工作进程 -> 协调进程: 算例指纹
+constexpr int32_t kMsgTask = 2;         // 协调进程 -> 工作进程: 待分支节点
+constexpr int32_t kMsgResult = 3;       // 工作进程 -> 协调进程: 子节点与新列
+constexpr int32_t kMsgShutdown = 4;     // 协调进程 -> 工作进程: 结束
+
+constexpr int kMaxFrameBytes = 1 << 30;     // 单条消息上限 (防止读到损坏的长度)
+constexpr int kSelectTimeoutMs = 1000;      // 等待消息的轮询间隔 (用于超时检查)
+
+// 协调进程中的一个工作进程连接
+struct WorkerConn {
+    SocketHandle sock_ = kInvalidSocket;
+    string name_;                       // 对端地址 (日志用)
+    bool ready_ = false;                // 已通过算例指纹校验
+    int synced_y_ = 0;                  // 该工作进程已拥有的 Y 列数
+    int synced_x_ = 0;                  // 该工作进程已拥有的 X 列数
+    int synced_cuts_ = 0;               // 该工作进程已拥有的割数
+    BPNode* task_ = nullptr;            // 正在处理的节点 (空闲时为 nullptr)
+    int num_tasks_ = 0;                 // 累计完成的任务数
+};
+
+// Winsock 初始化 (其他平台为空操作)
+static bool InitSockets() {
+#ifdef _WIN32
+    WSADATA wsa_data;
+    return WSAStartup(MAKEWORD(2, 2), &wsa_data) == 0;
+#else
+#ifndef MSG_NOSIGNAL
+    signal(SIGPIPE, SIG_IGN);
+#endif
+    return true;
+#endif
+}
+
+static void CleanupSockets() {
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+// 完整发送 / 接收 size 字节
+static bool SendAll(SocketHandle sock, const char* buf, size_t size) {
+    while (size > 0) {
+        int chunk = static_cast<int>(min<size_t>(size, 1 << 20));
+        int sent = send(sock, buf, chunk, kSendFlags);
+        if (sent <= 0) return false;
+        buf += sent;
+        size -= sent;
+    }
+    return true;
+}
+
+static bool RecvAll(SocketHandle sock, char* buf, size_t size) {
+    while (size > 0) {
+        int chunk = static_cast<int>(min<size_t>(size, 1 << 20));
+        int received = recv(sock, buf, chunk, 0);
+        if (received <= 0) return false;
+        buf += received;
+        size -= received;
+    }
+    return true;
+}
+
+static bool SendFrame(SocketHandle sock, int32_t type, const string& payload) {
+    int32_t header[2] = {type, static_cast<int32_t>(payload.size())};
+    return SendAll(sock, reinterpret_cast<const char*>(header), sizeof(header)) &&
+        SendAll(sock, payload.data(), payload.size());
+}
+
+static bool RecvFrame(SocketHandle sock, int32_t& type, string& payload) {
+    int32_t header[2] = {0, 0};
+    if (!RecvAll(sock, reinterpret_cast<char*>(header), sizeof(header))) return false;
+    if (header[1] < 0 || header[1] > kMaxFrameBytes) return false;
+    type = header[0];
+    payload.resize(header[1]);
+    return header[1] == 0 || RecvAll(sock, &payload[0], payload.size());
+}
+
+// 关闭 Nagle, 任务与结果消息立即发出
+static void SetNoDelay(SocketHandle sock) {
+    int flag = 1;
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&flag), sizeof(flag));
+}
+
+// 子节点解中的列号: 工作进程本地新列 (>= synced) 映射到全局列池中追加的位置
+static void RemapColumns(vector<ColumnValue>& cols, int synced, int global_begin) {
+    for (auto& entry : cols) {
+        if (entry.col_ >= synced) {
+            entry.col_ = global_begin + (entry.col_ - synced);
+        }
+    }
+}
+
+// 待处理节点中下界最小者的下标, 无节点时返回 -1
+static int BestOpenIndex(const vector<BPNode*>& open_nodes) {
+    int best = -1;
+    for (int k = 0; k < (int)open_nodes.size(); k++) {
+        if (best < 0 || open_nodes[k]->lower_bound_ < open_nodes[best]->lower_bound_) {
+            best = k;
+        }
+    }
+    return best;
+}
+
+// 向工作进程派发一个待分支节点: UB + 两个子节点编号 + 该进程缺少的列 + 节点记录
+static bool SendTask(ProblemParams& params, ProblemData& data, WorkerConn& worker,
+    BPNode* node, int left_id, int right_id) {
+
+    ostringstream out(ios::binary);
+    double ub = params.global_best_int_;
+    out.write(reinterpret_cast<const char*>(&ub), sizeof(ub));
+    int32_t ids[2] = {left_id, right_id};
+    out.write(reinterpret_cast<const char*>(ids), sizeof(ids));
+    WriteColumnRange(out, data.y_columns_, worker.synced_y_);
+    WriteColumnRange(out, data.x_columns_, worker.synced_x_);
+    WriteCutRange(out, data.cut_pool_, worker.synced_cuts_);
+    WriteNodeRecord(out, *node);
+
+    if (!SendFrame(worker.sock_, kMsgTask, out.str())) return false;
+    worker.synced_y_ = data.y_columns_.num_cols_;
+    worker.synced_x_ = data.x_columns_.num_cols_;
+    worker.synced_cuts_ = static_cast<int>(data.cut_pool_.size());
+    worker.task_ = node;
+    return true;
+}
+
+// 将 cols 中的列追加到列池末尾 (两者宽度与存储类型相同)
+static void AppendColumns(ColumnStore& store, const ColumnStore& cols) {
+    store.patterns16_.insert(store.patterns16_.end(),
+        cols.patterns16_.begin(), cols.patterns16_.end());
+    store.patterns32_.insert(store.patterns32_.end(),
+        cols.patterns32_.begin(), cols.patterns32_.end());
+    store.strip_types_.insert(store.strip_types_.end(),
+        cols.strip_types_.begin(), cols.strip_types_.end());
+    store.values_.resize(store.num_cols_ + cols.num_cols_, 0.0);
+    store.var_indices_.resize(store.num_cols_ + cols.num_cols_, -1);
+    int shift = static_cast<int>(store.arc_ids_.size());
+    for (int k = 1; k <= cols.num_cols_; k++) {
+        store.arc_offsets_.push_back(cols.arc_offsets_[k] + shift);
+    }
+    store.arc_ids_.insert(store.arc_ids_.end(), cols.arc_ids_.begin(), cols.arc_ids_.end());
+    store.num_cols_ += cols.num_cols_;
+}
+
+// 子节点解的列号都在工作进程列池范围内 (已同步的列 + 本次新列)
+static bool ColumnsInRange(const vector<ColumnValue>& cols, int num_cols) {
+    for (const auto& entry : cols) {
+        if (entry.col_ < 0 || entry.col_ >= num_cols) return false;
+    }
+    return true;
+}
+
+// 读取子节点结果: 新列追加到全局列池, 子节点解的列号随之重映射
+// 新割在全局割池中去重后追加, 子节点的割下标随之重映射 (割池已满时丢弃该割)
+// 先读入临时结构并整体校验, 结果损坏或与该进程的同步位置不符时不改动全局列池与割池
+static bool ReadResult(ProblemData& data, const string& payload, WorkerConn& worker,
+    BPNode& left, BPNode& right) {
+
+    istringstream in(payload, ios::binary);
+    ColumnStore new_y;
+    ColumnStore new_x;
+    int y_begin = 0, x_begin = 0;
+    if (!ReadColumnRange(in, new_y, y_begin) || !ReadColumnRange(in, new_x, x_begin) ||
+        y_begin != worker.synced_y_ || x_begin != worker.synced_x_ ||
+        new_y.width_ != data.y_columns_.width_ || new_y.wide_ != data.y_columns_.wide_ ||
+        new_x.width_ != data.x_columns_.width_ || new_x.wide_ != data.x_columns_.wide_) {
+        return false;
+    }
+
+    vector<RankOneCut> new_cuts;
+    int cut_begin = 0;
+    if (!ReadCutRange(in, new_cuts, cut_begin) || cut_begin != worker.synced_cuts_) return false;
+
+    int num_cuts = worker.synced_cuts_ + static_cast<int>(new_cuts.size());
+    for (BPNode* child : {&left, &right}) {
+        int32_t flags[2] = {0, 0};
+        in.read(reinterpret_cast<char*>(flags), sizeof(flags));
+        if (!in || !ReadNodeRecord(in, *child)) return false;
+        child->prune_flag_ = flags[0];
+        child->branched_flag_ = flags[1];
+        if (!ColumnsInRange(child->solution_.y_cols_, worker.synced_y_ + new_y.num_cols_) ||
+            !ColumnsInRange(child->solution_.x_cols_, worker.synced_x_ + new_x.num_cols_)) {
+            return false;
+        }
+        for (int id : child->cut_ids_) {
+            if (id < 0 || id >= num_cuts) return false;
+        }
+    }
+
+    // 校验通过, 合并到全局列池与割池
+    int global_y = data.y_columns_.num_cols_;
+    int global_x = data.x_columns_.num_cols_;
+    AppendColumns(data.y_columns_, new_y);
+    AppendColumns(data.x_columns_, new_x);
+    vector<int> cut_map(new_cuts.size());
+    for (int k = 0; k < (int)new_cuts.size(); k++) {
+        cut_map[k] = FindOrAddCut(data, new_cuts[k]);
+    }
+
+    for (BPNode* child : {&left, &right}) {
+        RemapColumns(child->solution_.y_cols_, worker.synced_y_, global_y);
+        RemapColumns(child->solution_.x_cols_, worker.synced_x_, global_x);
+
+        vector<int> cut_ids;
+        for (int id : child->cut_ids_) {
+            if (id >= worker.synced_cuts_) id = cut_map[id - worker.synced_cuts_];
+            if (id >= 0) cut_ids.push_back(id);
+        }
+        child->cut_ids_ = cut_ids;
+    }
+    return true;
+}
+
+// 监听端口 (所有地址)
+static SocketHandle OpenListener(int port) {
+    SocketHandle sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (sock == kInvalidSocket) return kInvalidSocket;
+    int flag = 1;
+    setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&flag), sizeof(flag));
+
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    if (::bind(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        listen(sock, SOMAXCONN) != 0) {
+        CloseSocket(sock);
+        return kInvalidSocket;
+    }
+    return sock;
+}
+
+// 连接协调进程, address 形如 host:port
+static SocketHandle ConnectTo(const string& address) {
+    size_t colon = address.rfind(':');
+    if (colon == string::npos) return kInvalidSocket;
+    string host = address.substr(0, colon);
+    string port = address.substr(colon + 1);
+
+    addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &result) != 0) return kInvalidSocket;
+
+    SocketHandle sock = kInvalidSocket;
+    for (addrinfo* ai = result; ai != nullptr; ai = ai->ai_next) {
+        sock = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (sock == kInvalidSocket) continue;
+        if (connect(sock, ai->ai_addr, static_cast<int>(ai->ai_addrlen)) == 0) break;
+        CloseSocket(sock);
+        sock = kInvalidSocket;
+    }
+    freeaddrinfo(result);
+    return sock;
+}
+
+// 协调进程: 分支定价主循环, 节点求解交给工作进程
+// 输入: 根节点 (已完成列生成), 监听端口
+// 输出: 最优整数解存储在 params 中
+int RunDistributedBP(ProblemParams& params, ProblemData& data, BPNode* root, int port) {
+    LOG_FMT("[分布式] 协调进程启动, 监听端口 %d\n", port);
+
+    // 检查根节点是否已经是整数解
+    if (SelectBranchArc(params, data, root) == kBranchNone) {
+        params.global_best_int_ = root->solution_.obj_val_;
+        params.global_best_sol_ = root->solution_;
+        LOG("[BP] 根节点 Arc 流量全整数, 即为最优解");
+        return 0;
+    }
+
+    if (!InitSockets()) {
+        LOG_WARN("[分布式] 错误: 网络初始化失败");
+        return -1;
+    }
+    SocketHandle listener = OpenListener(port);
+    if (listener == kInvalidSocket) {
+        LOG_WARN_FMT("[分布式] 错误: 无法监听端口 %d\n", port);
+        CleanupSockets();
+        return -1;
+    }
+    PROGRESS(GetElapsedTime(params), "BP   | 分布式 | 端口 %d 等待工作进程\n", port);
+
+    NodePool pool;
+    vector<BPNode*> open_nodes = {root};    // 待分支节点 (根节点由调用方持有)
+    vector<WorkerConn> workers;
+    vector<int32_t> fingerprint = InstanceFingerprint(params, data);
+    int node_count = 1;
+    int pruned_count = 0;
+    double released_lb = INFINITY;          // 已完成分支节点下界的最小值 (计算间隙用)
+
+    // 归还节点 (根节点除外)
+    auto release = [&](BPNode* node) {
+        if (node != root) ReleaseNode(pool, node);
+    };
+
+    // 断开工作进程: 正在处理的节点放回待处理列表
+    auto drop_worker = [&](WorkerConn& worker, const char* reason) {
+        LOG_FMT("[分布式] 工作进程 %s 断开 (%s)\n", worker.name_.c_str(), reason);
+        if (worker.task_ != nullptr) {
+            open_nodes.push_back(worker.task_);
+            worker.task_ = nullptr;
+        }
+        CloseSocket(worker.sock_);
+        worker.sock_ = kInvalidSocket;
+    };
+
+    while (true) {
+        // 超时检查
+        if (IsTimeUp(params)) {
+            params.is_timeout_ = true;
+            LOG_FMT("[BP] 达到时间限制 (%d秒), 终止搜索\n", params.time_limit_);
+            break;
+        }
+
+        // 移除已断开的连接
+        workers.erase(remove_if(workers.begin(), workers.end(),
+            [](const WorkerConn& w) { return w.sock_ == kInvalidSocket; }), workers.end());
+
+        int num_busy = 0;
+        for (const auto& worker : workers) {
+            if (worker.task_ != nullptr) num_busy++;
+        }
+        if (open_nodes.empty() && num_busy == 0) {
+            LOG("[BP] 无可分支节点, 搜索完成");
+            break;
+        }
+
+        // 派发: 每个空闲工作进程领取当前下界最小的节点
+        for (auto& worker : workers) {
+            if (!worker.ready_ || worker.task_ != nullptr || worker.sock_ == kInvalidSocket) continue;
+            int best = BestOpenIndex(open_nodes);
+            if (best < 0) break;
+            BPNode* node = open_nodes[best];
+            open_nodes.erase(open_nodes.begin() + best);
+
+            int left_id = ++params.node_counter_;
+            int right_id = ++params.node_counter_;
+            if (SendTask(params, data, worker, node, left_id, right_id)) {
+                LOG_FMT("[分布式] 节点 %d (LB=%.4f) -> %s\n",
+                    node->id_, node->lower_bound_, worker.name_.c_str());
+            } else {
+                worker.task_ = node;
+                drop_worker(worker, "发送失败");
+            }
+        }
+
+        // 等待新连接或结果
+        fd_set read_set;
+        FD_ZERO(&read_set);
+        FD_SET(listener, &read_set);
+        SocketHandle max_sock = listener;
+        for (const auto& worker : workers) {
+            if (worker.sock_ == kInvalidSocket) continue;
+            FD_SET(worker.sock_, &read_set);
+            max_sock = max(max_sock, worker.sock_);
+        }
+        timeval timeout;
+        timeout.tv_sec = kSelectTimeoutMs / 1000;
+        timeout.tv_usec = (kSelectTimeoutMs % 1000) * 1000;
+        if (select(static_cast<int>(max_sock + 1), &read_set, nullptr, nullptr, &timeout) <= 0) {
+            continue;
+        }
+
+        // 新的工作进程
+        if (FD_ISSET(listener, &read_set)) {
+            sockaddr_storage addr;
+            socklen_t addr_len = sizeof(addr);
+            SocketHandle sock = accept(listener, reinterpret_cast<sockaddr*>(&addr), &addr_len);
+            if (sock != kInvalidSocket) {
+                SetNoDelay(sock);
+                char host[NI_MAXHOST] = "?";
+                char serv[NI_MAXSERV] = "?";
+                getnameinfo(reinterpret_cast<sockaddr*>(&addr), addr_len, host, sizeof(host),
+                    serv, sizeof(serv), NI_NUMERICHOST | NI_NUMERICSERV);
+                WorkerConn worker;
+                worker.sock_ = sock;
+                worker.name_ = string(host) + ":" + serv;
+                workers.push_back(worker);
+            }
+        }
+
+        for (auto& worker : workers) {
+            if (worker.sock_ == kInvalidSocket || !FD_ISSET(worker.sock_, &read_set)) continue;
+
+            int32_t type = 0;
+            string payload;
+            if (!RecvFrame(worker.sock_, type, payload)) {
+                drop_worker(worker, "连接关闭");
+                continue;
+            }
+
+            if (type == kMsgHello) {
+                // 握手: 算例指纹必须一致, 否则列与 Arc 编号无法对应
+                vector<int32_t> remote(payload.size() / sizeof(int32_t));
+                memcpy(remote.data(), payload.data(), remote.size() * sizeof(int32_t));
+                if (remote != fingerprint) {
+                    SendFrame(worker.sock_, kMsgShutdown, "");
+                    drop_worker(worker, "算例不符");
+                    continue;
+                }
+                worker.ready_ = true;
+                LOG_FMT("[分布式] 工作进程 %s 加入 (共%d个)\n",
+                    worker.name_.c_str(), (int)workers.size());
+                continue;
+            }
+
+            if (type != kMsgResult || worker.task_ == nullptr) {
+                drop_worker(worker, "消息异常");
+                continue;
+            }
+
+            // 子节点结果
+            BPNode* parent = worker.task_;
+            BPNode* left = AllocNode(pool);
+            BPNode* right = AllocNode(pool);
+            if (!ReadResult(data, payload, worker, *left, *right)) {
+                ReleaseNode(pool, left);
+                ReleaseNode(pool, right);
+                drop_worker(worker, "结果损坏");
+                continue;
+            }
+            worker.task_ = nullptr;
+            worker.num_tasks_++;
+            node_count += 2;
+            parent->branched_flag_ = 1;
+            released_lb = min(released_lb, parent->lower_bound_);
+            release(parent);
+
+            for (BPNode* child : {left, right}) {
+                if (child->prune_flag_ == 0 && child->branched_flag_ == 1 &&
+                    child->solution_.obj_val_ < params.global_best_int_) {
+                    // Arc 流量全整数: 新的整数解
+                    params.global_best_int_ = child->solution_.obj_val_;
+                    params.global_best_sol_ = child->solution_;
+                    LOG_FMT("[BP] 找到新整数解, 目标值=%.4f\n", params.global_best_int_);
+                }
+                if (child->prune_flag_ == 0 && child->branched_flag_ == 0 &&
+                    child->lower_bound_ < params.global_best_int_ - kZeroTolerance) {
+                    open_nodes.push_back(child);
+                } else {
+                    if (child->prune_flag_ == 1) pruned_count++;
+                    release(child);
+                }
+            }
+
+            // 按新的上界剪枝
+            auto last = remove_if(open_nodes.begin(), open_nodes.end(), [&](BPNode* node) {
+                if (node->lower_bound_ < params.global_best_int_ - kZeroTolerance) return false;
+                pruned_count++;
+                release(node);
+                return true;
+            });
+            open_nodes.erase(last, open_nodes.end());
+
+            // 控制台进度
+            double lb = INFINITY;
+            for (const BPNode* node : open_nodes) lb = min(lb, node->lower_bound_);
+            for (const auto& w : workers) {
+                if (w.task_ != nullptr) lb = min(lb, w.task_->lower_bound_);
+            }
+            double ub = params.global_best_int_;
+            if (ub < INFINITY && lb < INFINITY) {
+                PROGRESS(GetElapsedTime(params),
+                    "BP   | n=%-3d LB=%-6.2f UB=%-4.0f Gap=%-5.1f%% act=%-2d cut=%-2d wk=%d\n",
+                    node_count, lb, ub, (ub - lb) / ub * 100, (int)open_nodes.size(),
+                    pruned_count, (int)workers.size());
+            } else {
+                PROGRESS(GetElapsedTime(params),
+                    "BP   | n=%-3d UB=%s act=%-2d cut=%-2d wk=%d\n",
+                    node_count, ub < INFINITY ? to_string((int)ub).c_str() : "--",
+                    (int)open_nodes.size(), pruned_count, (int)workers.size());
+            }
+        }
+    }
+
+    // 计算间隙: 与 RunBranchAndPrice 相同, LB 取所有未剪枝节点 (含已完成分支的节点) 下界的最小值
+    double best_lb = released_lb;
+    for (const BPNode* node : open_nodes) best_lb = min(best_lb, node->lower_bound_);
+    for (const auto& worker : workers) {
+        if (worker.task_ != nullptr) best_lb = min(best_lb, worker.task_->lower_bound_);
+    }
+
+    // 通知工作进程结束
+    for (auto& worker : workers) {
+        if (worker.sock_ == kInvalidSocket) continue;
+        SendFrame(worker.sock_, kMsgShutdown, "");
+        LOG_FMT("[分布式] 工作进程 %s 完成任务 %d 个\n", worker.name_.c_str(), worker.num_tasks_);
+        CloseSocket(worker.sock_);
+    }
+    CloseSocket(listener);
+    CleanupSockets();
+
+    if (params.global_best_int_ >= INFINITY) {
+        RoundRootSolution(params, root);
+    }
+    params.optimal_lb_ = best_lb;
+    if (params.global_best_int_ < INFINITY && best_lb < INFINITY) {
+        params.gap_ = (params.global_best_int_ - best_lb) / params.global_best_int_;
+    }
+
+    LOG_FMT("[BP] 分布式分支定价结束, 最优解=%.4f, 间隙=%.2f%%\n",
+        params.global_best_int_, params.gap_ * 100);
+    LogNodePoolStats(pool);
+    return 0;
+}
+
+// 工作进程: 连接协调进程, 循环处理分支任务直到收到结束消息或连接断开
+// 调用前须完成与协调进程相同的数据读取、预处理与建网
+int RunBPWorker(ProblemParams& params, ProblemData& data, const string& address) {
+    if (!InitSockets()) {
+        LOG_WARN("[分布式] 错误: 网络初始化失败");
+        return -1;
+    }
+    SocketHandle sock = ConnectTo(address);
+    if (sock == kInvalidSocket) {
+        LOG_WARN_FMT("[分布式] 错误: 无法连接协调进程 %s\n", address.c_str());
+        CleanupSockets();
+        return -1;
+    }
+    SetNoDelay(sock);
+
+    vector<int32_t> fingerprint = InstanceFingerprint(params, data);
+    string hello(reinterpret_cast<const char*>(fingerprint.data()),
+        fingerprint.size() * sizeof(int32_t));
+    if (!SendFrame(sock, kMsgHello, hello)) {
+        CloseSocket(sock);
+        CleanupSockets();
+        return -1;
+    }
+    LOG_FMT("[分布式] 已连接协调进程 %s\n", address.c_str());
+    PROGRESS(GetElapsedTime(params), "工作 | 已连接 %s\n", address.c_str());
+
+    int num_tasks = 0;
+    while (true) {
+        int32_t type = 0;
+        string payload;
+        if (!RecvFrame(sock, type, payload) || type == kMsgShutdown) break;
+        if (type != kMsgTask) {
+            LOG_WARN_FMT("[分布式] 错误: 未知消息类型 %d\n", type);
+            break;
+        }
+
+        // 任务: UB, 子节点编号, 新列, 新割, 父节点记录
+        istringstream in(payload, ios::binary);
+        int32_t ids[2] = {0, 0};
+        int y_begin = 0, x_begin = 0, cut_begin = 0;
+        int num_y = data.y_columns_.num_cols_;
+        int num_x = data.x_columns_.num_cols_;
+        int num_cuts = static_cast<int>(data.cut_pool_.size());
+        BPNode parent;
+        in.read(reinterpret_cast<char*>(&params.global_best_int_), sizeof(double));
+        in.read(reinterpret_cast<char*>(ids), sizeof(ids));
+        if (!in || !ReadColumnRange(in, data.y_columns_, y_begin) ||
+            !ReadColumnRange(in, data.x_columns_, x_begin) ||
+            y_begin != num_y || x_begin != num_x ||
+            !ReadCutRange(in, data.cut_pool_, cut_begin) || cut_begin != num_cuts ||
+            !ReadNodeRecord(in, parent)) {
+            LOG_WARN("[分布式] 错误: 任务消息损坏");
+            break;
+        }
+        int synced_y = data.y_columns_.num_cols_;
+        int synced_x = data.x_columns_.num_cols_;
+        int synced_cuts = static_cast<int>(data.cut_pool_.size());
+
+        // 创建并求解左右子节点
+        BPNode left;
+        BPNode right;
+        CreateLeftChild(&parent, ids[0], &left);
+        CreateRightChild(&parent, ids[1], &right);
+        for (BPNode* child : {&left, &right}) {
+            if (PrescreenChild(params, data, &parent, child)) continue;
+            SolveNodeCG(params, data, child);
+            if (child->prune_flag_ == 0 &&
+                SelectBranchArc(params, data, child) == kBranchNone) {
+                child->branched_flag_ = 1;  // 整数解无需再分支
+                params.global_best_int_ = min(params.global_best_int_, child->solution_.obj_val_);
+            }
+        }
+
+        // 回传: 新列 + 新割 + 两个子节点 (剪枝/整数标志 + 节点记录)
+        ostringstream out(ios::binary);
+        WriteColumnRange(out, data.y_columns_, synced_y);
+        WriteColumnRange(out, data.x_columns_, synced_x);
+        WriteCutRange(out, data.cut_pool_, synced_cuts);
+        for (const BPNode* child : {&left, &right}) {
+            int32_t flags[2] = {child->prune_flag_, child->branched_flag_};
+            out.write(reinterpret_cast<const char*>(flags), sizeof(flags));
+            WriteNodeRecord(out, *child);
+        }
+        TruncateColumnStore(data.y_columns_, synced_y);
+        TruncateColumnStore(data.x_columns_, synced_x);
+        data.cut_pool_.resize(synced_cuts);
+
+        if (!SendFrame(sock, kMsgResult, out.str())) break;
+        num_tasks++;
+        PROGRESS(GetElapsedTime(params), "工作 | 节点%d -> %d (LB=%.2f) / %d (LB=%.2f)\n",
+            parent.id_, left.id_, left.lower_bound_, right.id_, right.lower_bound_);
+    }
+
+    LOG_FMT("[分布式] 工作进程结束, 完成任务 %d 个\n", num_tasks);
+    CloseSocket(sock);
+    CleanupSockets();
+    return 0;
+}
@@ -19,20 +19,36 @@ using namespace std;
 // 功能: 为根节点生成初始列池, 确保主问题可行
 // 策略: 使用对角矩阵, 每个Y列只产出一种条带, 每个X列只切割一种子板
 // 输出:
-//   - root_node.y_columns_: 初始Y列集合
-//   - root_node.x_columns_: 初始X列集合
-//   - root_node.matrix_: 完整约束矩阵
-void RunHeuristic(ProblemParams& params, ProblemData& data, BPNode& root_node) {
+//   - data.y_columns_: 初始Y列 (写入全局列池)
+//   - data.x_columns_: 初始X列 (写入全局列池)
+void RunHeuristic(ProblemParams& params, ProblemData& data) {
+    PROFILE_ZONE("heuristic");
+
     int num_strip_types = params.num_strip_types_;
     int num_item_types = params.num_item_types_;
 
     LOG("[启发式] 生成初始解");
 
+    // 初始化全局列池
+    // 系数上界: 一块母板最多切出 W / min(w_j) 个条带, 一个条带最多切出 L / min(l_i) 个子板
+    int min_strip_width = params.stock_width_;
+    for (int j = 0; j < num_strip_types; j++) {
+        min_strip_width = min(min_strip_width, data.strip_types_[j].width_);
+    }
+    int min_item_length = params.stock_length_;
+    for (int i = 0; i < num_item_types; i++) {
+        min_item_length = min(min_item_length, data.item_types_[i].length_);
+    }
+    InitColumnStore(data.y_columns_, num_strip_types,
+        params.stock_width_ / max(min_strip_width, 1));
+    InitColumnStore(data.x_columns_, num_item_types,
+        params.stock_length_ / max(min_item_length, 1));
+
     // 生成初始Y列 (母板切割方案)
     // 每个Y列对应一种条带类型, 只切割一个该类型条带
     // 这样可以确保每种条带都能被产出
     params.init_y_matrix_.clear();
-    root_node.y_columns_.clear();
+    vector<int> arc_ids;
 
     for (int j = 0; j < num_strip_types; j++) {
         // pattern[j] = 1 表示切割一个j型条带, 其他为0
@@ -40,10 +56,8 @@ void RunHeuristic(ProblemParams& params, ProblemData& data, BPNode& root_node) {
         pattern[j] = 1;
 
         params.init_y_matrix_.push_back(pattern);
-
-        YColumn y_col;
-        y_col.pattern_ = pattern;
-        root_node.y_columns_.push_back(y_col);
+        ComputeYColumnArcIds(data, pattern, arc_ids);
+        AppendColumn(data.y_columns_, pattern, -1, arc_ids);
     }
 
     LOG_FMT("  生成Y列数: %d\n", num_strip_types);
@@ -52,7 +66,6 @@ void RunHeuristic(ProblemParams& params, ProblemData& data, BPNode& root_node) {
     // 为每种子板类型生成一个X列, 确保所有需求约束都能被满足
     // 每个X列只切割一种子板类型
     params.init_x_matrix_.clear();
-    root_node.x_columns_.clear();
 
     for (int i = 0; i < num_item_types; i++) {
         int item_width = data.item_types_[i].width_;
@@ -72,66 +85,12 @@ void RunHeuristic(ProblemParams& params, ProblemData& data, BPNode& root_node) {
             pattern[i] = 1;
 
             params.init_x_matrix_.push_back(pattern);
-
-            XColumn x_col;
-            x_col.strip_type_id_ = strip_type;  // 该X列属于对应条带类型
-            x_col.pattern_ = pattern;
-            root_node.x_columns_.push_back(x_col);
-        }
-    }
-
-    LOG_FMT("  生成X列数: %d\n", (int)root_node.x_columns_.size());
-
-    // 构建完整模型矩阵
-    // 矩阵结构 (行优先存储):
-    //   行0 ~ J-1: 条带平衡约束
-    //   行J ~ J+N-1: 子板需求约束
-    //
-    // Y列在矩阵中的系数:
-    //   [C_1, C_2, ..., C_J, 0, 0, ..., 0]
-    //   其中 C_j = pattern[j] 为产出的j型条带数量
-    //
-    // X列在矩阵中的系数:
-    //   [0, ..., -1(位置j), ..., 0, B_1, B_2, ..., B_N]
-    //   其中 -1 表示消耗一个j型条带, B_i = pattern[i] 为产出的子板数量
-    root_node.matrix_.clear();
-
-    int num_rows = num_strip_types + num_item_types;
-
-    // 添加Y列到矩阵
-    for (int col = 0; col < (int)root_node.y_columns_.size(); col++) {
-        vector<double> col_data;
-
-        // 条带产出部分 (C矩阵): Y列产出条带, 系数为正
-        for (int j = 0; j < num_strip_types; j++) {
-            col_data.push_back(root_node.y_columns_[col].pattern_[j]);
-        }
-
-        // 子板产出部分: Y列不直接产出子板, 系数为0
-        for (int i = 0; i < num_item_types; i++) {
-            col_data.push_back(0);
+            ComputeXColumnArcIds(data, pattern, strip_type, arc_ids);
+            AppendColumn(data.x_columns_, pattern, strip_type, arc_ids);
         }
-
-        root_node.matrix_.push_back(col_data);
     }
 
-    // 添加X列到矩阵
-    for (int col = 0; col < (int)root_node.x_columns_.size(); col++) {
-        vector<double> col_data;
-        int strip_type = root_node.x_columns_[col].strip_type_id_;
-
-        // 条带消耗部分 (D矩阵): X列消耗条带, 在对应位置为-1
-        for (int j = 0; j < num_strip_types; j++) {
-            col_data.push_back((j == strip_type) ? -1 : 0);
-        }
-
-        // 子板产出部分 (B矩阵): X列产出子板, 系数为pattern值
-        for (int i = 0; i < num_item_types; i++) {
-            col_data.push_back(root_node.x_columns_[col].pattern_[i]);
-        }
-
-        root_node.matrix_.push_back(col_data);
-    }
+    LOG_FMT("  生成X列数: %d\n", data.x_columns_.num_cols_);
 
     LOG("[启发式] 初始解生成完成");
 
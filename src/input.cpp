@@ -61,7 +61,7 @@ string GetLatestInstanceFile(const string& data_dir) {
     namespace fs = filesystem;
 
     if (!fs::exists(data_dir) || !fs::is_directory(data_dir)) {
-        LOG_FMT("[错误] 目录不存在: %s\n", data_dir.c_str());
+        LOG_WARN_FMT("[错误] 目录不存在: %s\n", data_dir.c_str());
         return "";
     }
 
@@ -79,7 +79,7 @@ string GetLatestInstanceFile(const string& data_dir) {
     }
 
     if (csv_files.empty()) {
-        LOG_FMT("[错误] 目录中无算例文件: %s\n", data_dir.c_str());
+        LOG_WARN_FMT("[错误] 目录中无算例文件: %s\n", data_dir.c_str());
         return "";
     }
 
@@ -112,7 +112,7 @@ tuple<int, int, int> LoadInput(ProblemParams& params, ProblemData& data,
         // 自动选择最新的算例文件
         file_path = GetLatestInstanceFile(kDataDir);
         if (file_path.empty()) {
-            LOG("[错误] 未找到算例文件");
+            LOG_WARN("[错误] 未找到算例文件");
             return make_tuple(-1, 0, 0);
         }
         LOG_FMT("[数据] 使用最新文件: %s\n", file_path.c_str());
@@ -123,13 +123,11 @@ tuple<int, int, int> LoadInput(ProblemParams& params, ProblemData& data,
 
     ifstream fin(file_path.c_str());
     if (!fin) {
-        LOG_FMT("[错误] 无法打开文件: %s\n", file_path.c_str());
+        LOG_WARN_FMT("[错误] 无法打开文件: %s\n", file_path.c_str());
         return make_tuple(-1, 0, 0);
     }
 
     bool stock_read = false;
-    int total_demand = 0;
-    set<int> unique_widths;
 
     while (getline(fin, line)) {
         // 跳过注释行和空行
@@ -159,43 +157,54 @@ tuple<int, int, int> LoadInput(ProblemParams& params, ProblemData& data,
             item_type.demand_ = stoi(tokens[3]);
 
             data.item_types_.push_back(item_type);
-            total_demand += item_type.demand_;
-            unique_widths.insert(item_type.width_);
         }
     }
     fin.close();
 
-    params.num_item_types_ = static_cast<int>(data.item_types_.size());
+    // 创建条带类型并构建索引映射
+    BuildStripTypes(params, data);
+
     LOG_FMT("[数据] 子板类型数: %d\n", params.num_item_types_);
+    LOG_FMT("[数据] 子板总需求: %d\n", params.num_items_);
+    LOG_FMT("[数据] 条带类型数: %d\n", params.num_strip_types_);
 
-    // 条带类型数量 = 不同宽度的数量
-    // 因为同宽度的子板可以放在同一条带上切割
-    params.num_strip_types_ = static_cast<int>(unique_widths.size());
-    params.num_items_ = total_demand;
+    LOG("[数据] 数据读取完成");
+    return make_tuple(0, params.num_item_types_, params.num_strip_types_);
+}
 
-    LOG_FMT("[数据] 子板总需求: %d\n", total_demand);
-    LOG_FMT("[数据] 条带类型数: %d\n", params.num_strip_types_);
+// 根据当前子板类型列表创建条带类型, 并重建尺寸索引
+// 条带类型数量 = 不同宽度的数量, 因为同宽度的子板可以放在同一条带上切割
+// 条带按宽度降序排列, 宽度大的条带能容纳更多子板类型
+// 读取数据及预处理修改子板列表后调用
+void BuildStripTypes(ProblemParams& params, ProblemData& data) {
+    params.num_item_types_ = static_cast<int>(data.item_types_.size());
+
+    int total_demand = 0;
+    set<int> unique_widths;
+    for (int i = 0; i < params.num_item_types_; i++) {
+        total_demand += data.item_types_[i].demand_;
+        unique_widths.insert(data.item_types_[i].width_);
+    }
+    params.num_items_ = total_demand;
+    params.num_strip_types_ = static_cast<int>(unique_widths.size());
 
-    // 创建条带类型 (按宽度降序排列)
-    // 宽度大的条带能容纳更多子板类型
     vector<int> widths(unique_widths.begin(), unique_widths.end());
     sort(widths.begin(), widths.end(), greater<int>());
 
-    for (int i = 0; i < params.num_strip_types_; i++) {
+    data.strip_types_.clear();
+    data.strip_widths_.clear();
+    for (int j = 0; j < params.num_strip_types_; j++) {
         StripType strip_type;
-        strip_type.type_id_ = i;
-        strip_type.width_ = widths[i];
+        strip_type.type_id_ = j;
+        strip_type.width_ = widths[j];
         strip_type.length_ = params.stock_length_;  // 条带长度 = 母板长度
         data.strip_types_.push_back(strip_type);
-        data.strip_widths_.push_back(widths[i]);
+        data.strip_widths_.push_back(widths[j]);
     }
 
     // 构建索引映射 (用于快速查找)
     BuildLengthIndex(data);
     BuildWidthIndex(data);
-
-    LOG("[数据] 数据读取完成");
-    return make_tuple(0, params.num_item_types_, params.num_strip_types_);
 }
 
 // 构建长度到子板类型的索引
@@ -203,15 +212,23 @@ tuple<int, int, int> LoadInput(ProblemParams& params, ProblemData& data,
 void BuildLengthIndex(ProblemData& data) {
     data.item_lengths_.clear();
     data.length_to_item_index_.clear();
+    data.length_to_item_table_.clear();
 
+    int max_len = 0;
     for (int i = 0; i < (int)data.item_types_.size(); i++) {
         int len = data.item_types_[i].length_;
         data.length_to_item_index_[len] = i;  // 长度 -> 子板索引
         data.item_lengths_.push_back(len);
+        max_len = max(max_len, len);
+    }
+
+    // 直接索引表: 与 map 相同的覆盖语义 (同长度取最后一个子板)
+    data.length_to_item_table_.assign(max_len + 1, -1);
+    for (const auto& kv : data.length_to_item_index_) {
+        data.length_to_item_table_[kv.first] = kv.second;
     }
 
-    // 按降序排序 (用于动态规划优化)
-    sort(data.item_lengths_.begin(), data.item_lengths_.end(), greater<int>());
+    // item_lengths_[i] 与子板类型 i 对应 (与 X 列 pattern 下标一致), 不排序
 }
 
 // 构建宽度到条带/子板类型的索引
@@ -219,11 +236,20 @@ void BuildLengthIndex(ProblemData& data) {
 void BuildWidthIndex(ProblemData& data) {
     data.width_to_strip_index_.clear();
     data.width_to_item_indices_.clear();
+    data.width_to_strip_table_.clear();
 
     // 宽度 -> 条带类型索引
+    int max_wid = 0;
     for (int i = 0; i < (int)data.strip_types_.size(); i++) {
         int wid = data.strip_types_[i].width_;
         data.width_to_strip_index_[wid] = i;
+        max_wid = max(max_wid, wid);
+    }
+
+    // 直接索引表
+    data.width_to_strip_table_.assign(max_wid + 1, -1);
+    for (const auto& kv : data.width_to_strip_index_) {
+        data.width_to_strip_table_[kv.first] = kv.second;
     }
 
     // 宽度 -> 子板类型索引列表 (同宽度可能有多种子板)
@@ -287,15 +313,20 @@ void PrintCGSolution(BPNode* node, ProblemData& data) {
     LOG("=== 列生成解 ===");
     LOG_FMT("  目标值: %.4f\n", node->solution_.obj_val_);
 
+    const ColumnStore& y_store = data.y_columns_;
+    const ColumnStore& x_store = data.x_columns_;
+    const NodeSolution& sol = node->solution_;
+
     LOG("  Y列 (母板切割方案):");
-    for (int i = 0; i < (int)node->y_columns_.size(); i++) {
-        if (node->y_columns_[i].value_ > kZeroTolerance) {
+    for (const auto& entry : sol.y_cols_) {
+        if (entry.value_ > kZeroTolerance) {
+            int i = entry.col_;
             ostringstream oss;
             oss << "    Y" << (i + 1) << " = " << fixed << setprecision(4)
-                << node->y_columns_[i].value_ << " [";
-            for (int j = 0; j < (int)node->y_columns_[i].pattern_.size(); j++) {
+                << entry.value_ << " [";
+            for (int j = 0; j < y_store.width_; j++) {
                 if (j > 0) oss << ", ";
-                oss << node->y_columns_[i].pattern_[j];
+                oss << GetPatternCoef(y_store, i, j);
             }
             oss << "]";
             LOG(oss.str().c_str());
@@ -303,14 +334,15 @@ void PrintCGSolution(BPNode* node, ProblemData& data) {
     }
 
     LOG("  X列 (条带切割方案):");
-    for (int i = 0; i < (int)node->x_columns_.size(); i++) {
-        if (node->x_columns_[i].value_ > kZeroTolerance) {
+    for (const auto& entry : sol.x_cols_) {
+        if (entry.value_ > kZeroTolerance) {
+            int i = entry.col_;
             ostringstream oss;
-            oss << "    X" << (i + 1) << " (条带" << node->x_columns_[i].strip_type_id_ + 1
-                << ") = " << fixed << setprecision(4) << node->x_columns_[i].value_ << " [";
-            for (int j = 0; j < (int)node->x_columns_[i].pattern_.size(); j++) {
+            oss << "    X" << (i + 1) << " (条带" << x_store.strip_types_[i] + 1
+                << ") = " << fixed << setprecision(4) << entry.value_ << " [";
+            for (int j = 0; j < x_store.width_; j++) {
                 if (j > 0) oss << ", ";
-                oss << node->x_columns_[i].pattern_[j];
+                oss << GetPatternCoef(x_store, i, j);
             }
             oss << "]";
             LOG(oss.str().c_str());
@@ -325,6 +357,6 @@ void PrintNodeInfo(BPNode* node) {
     LOG_FMT("  下界: %.4f\n", node->lower_bound_);
     LOG_FMT("  剪枝: %d\n", node->prune_flag_);
     LOG_FMT("  分支完成: %d\n", node->branched_flag_);
-    LOG_FMT("  Y列数: %d\n", (int)node->y_columns_.size());
-    LOG_FMT("  X列数: %d\n", (int)node->x_columns_.size());
+    LOG_FMT("  Y列数: %d\n", (int)node->solution_.y_cols_.size());
+    LOG_FMT("  X列数: %d\n", (int)node->solution_.x_cols_.size());
 }
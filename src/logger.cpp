@@ -3,25 +3,56 @@
 // 改进内容:
 // 1. 移除DualStreambuf，避免流重定向
 // 2. 纯文件输出，与CPLEX完全隔离
-// 3. 线程安全：使用mutex保护文件写入
-// 4. 自动flush：确保崩溃时日志不丢失
-// 5. 批量写入：性能优于逐字符处理
+// 3. 线程安全：有界无锁环形缓冲区 (多生产者单消费者)
+// 4. 异步写入：后台线程批量写文件, 每批只flush一次
+// 5. 退出时析构函数写完缓冲区; 崩溃信号处理函数等待缓冲区落盘后再按默认方式终止
 //
 // 核心设计:
-// - Logger::Write(): 线程安全的文件写入
-// - Logger::WriteFormat(): 格式化输出（类似printf）
+// - Logger::Write(): 复制消息到缓冲区槽位, 不加锁、不做文件IO
+// - Logger::WriteFormat(): 直接格式化到槽位（类似printf）
+// - Logger::RunWriter(): 后台线程取出记录, 添加时间戳 (按秒缓存) 并批量写入
 // - g_logger全局指针：方便宏访问
 // - 不修改cout/cerr：避免与CPLEX冲突
+//
+// 环形缓冲区为 Vyukov 有界队列: 每个槽位的序号表示其状态, 生产者以 CAS 推进写入位置,
+// 缓冲区满时生产者让出CPU等待后台线程释放槽位 (不丢弃消息)
 
 #include "logger.h"
 
+#include <algorithm>
+#include <csignal>
+#include <cstring>
+
 using namespace std;
 
 // 全局Logger指针定义
 Logger* g_logger = nullptr;
 
+// 运行期日志级别
+int g_log_level = kLogInfo;
+
+// 解析级别名 (--log-level)
+int ParseLogLevel(const string& name) {
+    if (name == "trace") return kLogTrace;
+    if (name == "debug") return kLogDebug;
+    if (name == "info") return kLogInfo;
+    if (name == "warn") return kLogWarn;
+    return -1;
+}
+
+constexpr int kLogCrashFlushMs = 1000;      // 崩溃时等待缓冲区落盘的最长时间 (毫秒)
+
+// 崩溃信号处理: 等待缓冲区落盘, 再按默认方式处理该信号
+static void FlushOnSignal(int sig) {
+    if (g_logger) {
+        g_logger->Flush(kLogCrashFlushMs);
+    }
+    signal(sig, SIG_DFL);
+    raise(sig);
+}
+
 // Logger构造函数
-// 功能: 创建日志文件，初始化日志系统
+// 功能: 创建日志文件，初始化缓冲区并启动后台写入线程
 // 参数: log_prefix - 日志文件路径前缀（自动添加.log后缀）
 Logger::Logger(const string& log_prefix) {
     log_file_path_ = log_prefix + ".log";
@@ -37,6 +68,18 @@ Logger::Logger(const string& log_prefix) {
 
     if (!log_file_.is_open()) {
         fprintf(stderr, "[ERROR] 无法创建日志文件: %s\n", log_file_path_.c_str());
+    } else {
+        // 槽位 i 的初始序号为 i (可写)
+        ring_.reset(new LogRecord[kLogRingSize]);
+        for (size_t i = 0; i < kLogRingSize; i++) {
+            ring_[i].seq_.store(i, memory_order_relaxed);
+        }
+        writer_ = thread(&Logger::RunWriter, this);
+
+        signal(SIGSEGV, FlushOnSignal);
+        signal(SIGABRT, FlushOnSignal);
+        signal(SIGFPE, FlushOnSignal);
+        signal(SIGILL, FlushOnSignal);
     }
 
     // 设置全局Logger指针
@@ -44,90 +87,188 @@ Logger::Logger(const string& log_prefix) {
 }
 
 // Logger析构函数
-// 功能: 关闭日志文件，清空全局指针
+// 功能: 停止后台线程 (先写完缓冲区中的全部记录)，关闭日志文件，清空全局指针
 Logger::~Logger() {
     try {
+        // 清空全局指针
+        if (g_logger == this) {
+            g_logger = nullptr;
+        }
+
+        if (writer_.joinable()) {
+            stop_.store(true, memory_order_release);
+            writer_.join();
+        }
+
         // 关闭日志文件
         if (log_file_.is_open()) {
             log_file_.flush();
             log_file_.close();
         }
-
-        // 清空全局指针
-        if (g_logger == this) {
-            g_logger = nullptr;
-        }
     } catch (...) {
         // 忽略析构过程中的异常，避免程序崩溃
     }
 }
 
-// 获取当前时间戳
+// 获取时间戳
 // 格式: [YYYY-MM-DD HH:MM:SS]
-// 返回值: 格式化的时间戳字符串
-string Logger::GetTimestamp() {
-    auto now = chrono::system_clock::now();
-    auto time_t_val = chrono::system_clock::to_time_t(now);
-
-    tm tm_buf;
+// 同一秒内的记录复用上次格式化的结果
+const string& Logger::GetTimestamp(time_t time_val) {
+    if (time_val != cached_time_) {
+        tm tm_buf;
 #ifdef _WIN32
-    localtime_s(&tm_buf, &time_t_val);
+        localtime_s(&tm_buf, &time_val);
 #else
-    localtime_r(&time_t_val, &tm_buf);
+        localtime_r(&time_val, &tm_buf);
 #endif
+        char buf[32];
+        strftime(buf, sizeof(buf), "[%Y-%m-%d %H:%M:%S] ", &tm_buf);
+        cached_stamp_ = buf;
+        cached_time_ = time_val;
+    }
+    return cached_stamp_;
+}
+
+// 申请可写槽位
+// 槽位序号等于写入位置时可写; 小于写入位置说明缓冲区已满, 等待后台线程释放
+uint64_t Logger::Acquire() {
+    uint64_t pos = write_pos_.load(memory_order_relaxed);
+    while (true) {
+        LogRecord& rec = ring_[pos & (kLogRingSize - 1)];
+        uint64_t seq = rec.seq_.load(memory_order_acquire);
+        if (seq == pos) {
+            if (write_pos_.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                return pos;
+            }
+        } else if (seq < pos) {
+            this_thread::yield();
+            pos = write_pos_.load(memory_order_relaxed);
+        } else {
+            pos = write_pos_.load(memory_order_relaxed);
+        }
+    }
+}
 
-    stringstream ss;
-    ss << "[" << put_time(&tm_buf, "%Y-%m-%d %H:%M:%S") << "] ";
-    return ss.str();
+// 发布槽位: 记录内容先于序号对后台线程可见
+void Logger::Publish(uint64_t pos) {
+    ring_[pos & (kLogRingSize - 1)].seq_.store(pos + 1, memory_order_release);
 }
 
 // 写入日志消息（带时间戳）
-// 功能: 线程安全地写入日志文件
+// 功能: 复制消息到缓冲区, 由后台线程添加时间戳并写入文件
 // 参数: msg - 日志消息
-// 说明:
-//   - 自动添加时间戳
-//   - 立即flush，确保崩溃时不丢日志
-//   - 线程安全
 void Logger::Write(const string& msg) {
-    if (!log_file_.is_open()) {
+    if (!ring_) {
         return;
     }
 
-    // 线程安全：加锁保护文件写入
-    lock_guard<mutex> lock(mutex_);
-
-    try {
-        // 写入时间戳 + 消息
-        string timestamp = GetTimestamp();
-        log_file_ << timestamp << msg;
-
-        // 立即flush，确保日志写入磁盘
-        log_file_.flush();
-    } catch (const exception& e) {
-        // 捕获异常，避免日志错误导致程序崩溃
-        fprintf(stderr, "[ERROR] 日志写入失败: %s\n", e.what());
+    uint64_t pos = Acquire();
+    LogRecord& rec = ring_[pos & (kLogRingSize - 1)];
+    rec.time_ = time(nullptr);
+    rec.len_ = msg.size();
+    if (rec.len_ < kLogInlineSize) {
+        memcpy(rec.text_, msg.data(), rec.len_);
+    } else {
+        rec.long_text_.assign(msg);
     }
+    Publish(pos);
 }
 
 // 格式化写入日志
-// 功能: 类似printf的格式化日志输出
+// 功能: 类似printf的格式化日志输出, 直接格式化到缓冲区槽位
 // 参数: fmt - 格式化字符串, ... - 参数列表
-// 说明:
-//   - 支持printf风格的格式化
-//   - 自动添加时间戳
-//   - 线程安全
+// 说明: 单条消息超过 kLogMaxFormat - 1 个字符时截断
 void Logger::WriteFormat(const char* fmt, ...) {
-    if (!log_file_.is_open()) {
+    if (!ring_) {
         return;
     }
 
-    // 格式化字符串
-    char buffer[4096];  // 缓冲区大小：4KB
     va_list args;
     va_start(args, fmt);
-    vsnprintf(buffer, sizeof(buffer), fmt, args);
+    va_list args_copy;
+    va_copy(args_copy, args);
+
+    uint64_t pos = Acquire();
+    LogRecord& rec = ring_[pos & (kLogRingSize - 1)];
+    rec.time_ = time(nullptr);
+
+    int len = vsnprintf(rec.text_, kLogInlineSize, fmt, args);
+    if (len < 0) len = 0;
+    rec.len_ = static_cast<size_t>(len);
+    if (rec.len_ >= kLogInlineSize) {
+        // 内联文本放不下: 重新格式化到 long_text_
+        rec.len_ = min(rec.len_, kLogMaxFormat - 1);
+        rec.long_text_.resize(rec.len_ + 1);
+        vsnprintf(&rec.long_text_[0], rec.len_ + 1, fmt, args_copy);
+        rec.long_text_.resize(rec.len_);
+    }
+    Publish(pos);
+
+    va_end(args_copy);
     va_end(args);
+}
+
+// 取出缓冲区中已发布的记录 (最多一整圈), 拼接后一次写入文件并flush
+// 返回值: 取出的记录数
+size_t Logger::Drain() {
+    batch_.clear();
+    size_t count = 0;
+    while (count < kLogRingSize) {
+        LogRecord& rec = ring_[read_pos_ & (kLogRingSize - 1)];
+        if (rec.seq_.load(memory_order_acquire) != read_pos_ + 1) {
+            break;
+        }
+        batch_ += GetTimestamp(rec.time_);
+        if (rec.len_ < kLogInlineSize) {
+            batch_.append(rec.text_, rec.len_);
+        } else {
+            batch_ += rec.long_text_;
+        }
+        // 释放槽位: 下一圈的写入位置
+        rec.seq_.store(read_pos_ + kLogRingSize, memory_order_release);
+        read_pos_++;
+        count++;
+    }
+
+    if (count > 0) {
+        try {
+            log_file_.write(batch_.data(), static_cast<streamsize>(batch_.size()));
+            log_file_.flush();
+        } catch (const exception& e) {
+            // 捕获异常，避免日志错误导致程序崩溃
+            fprintf(stderr, "[ERROR] 日志写入失败: %s\n", e.what());
+        }
+        flushed_pos_.store(read_pos_, memory_order_release);
+    }
+    return count;
+}
+
+// 后台写入线程: 缓冲区为空时轮询等待; 收到停止请求后写完剩余记录再退出
+void Logger::RunWriter() {
+    while (true) {
+        bool stopping = stop_.load(memory_order_acquire);
+        if (Drain() == 0) {
+            if (stopping) break;
+            this_thread::sleep_for(chrono::microseconds(kLogIdleMicros));
+        }
+    }
+}
 
-    // 调用Write写入（自动加时间戳和flush）
-    Write(buffer);
+// 等待此前写入的消息全部落盘
+// 在后台线程内调用 (如后台线程崩溃) 时直接返回 false
+bool Logger::Flush(int timeout_ms) {
+    if (!writer_.joinable() || this_thread::get_id() == writer_.get_id()) {
+        return false;
+    }
+
+    uint64_t target = write_pos_.load(memory_order_acquire);
+    auto start = chrono::steady_clock::now();
+    while (flushed_pos_.load(memory_order_acquire) < target) {
+        if (timeout_ms >= 0 &&
+            chrono::steady_clock::now() - start > chrono::milliseconds(timeout_ms)) {
+            return false;
+        }
+        this_thread::sleep_for(chrono::microseconds(kLogIdleMicros));
+    }
+    return true;
 }
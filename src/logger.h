@@ -5,9 +5,9 @@
 // 改进点:
 // 1. 纯文件输出，避免流重定向导致的崩溃
 // 2. 不修改全局cout状态，与CPLEX完全隔离
-// 3. 线程安全的文件写入
-// 4. 批量写入提升性能
-// 5. 自动flush确保崩溃时不丢日志
+// 3. 线程安全: 调用线程只把消息写入无锁环形缓冲区
+// 4. 后台线程添加时间戳并批量写入文件
+// 5. 程序退出与崩溃 (SIGSEGV / SIGABRT 等) 时flush缓冲区, 不丢日志
 //
 // 使用方式:
 //   int main() {
@@ -19,22 +19,39 @@
 #ifndef LOGGER_H_
 #define LOGGER_H_
 
+#include <atomic>
 #include <fstream>
 #include <string>
 #include <chrono>
 #include <iomanip>
 #include <ctime>
 #include <sstream>
-#include <mutex>
+#include <memory>
+#include <thread>
 #include <filesystem>
+#include <cstdint>
 #include <cstdio>
 #include <cstdarg>
 
-// 简化的文件日志类
+constexpr size_t kLogRingSize = 8192;       // 环形缓冲区记录数 (2 的幂)
+constexpr size_t kLogInlineSize = 256;      // 记录内联文本长度, 更长的消息存入 long_text_
+constexpr size_t kLogMaxFormat = 4096;      // WriteFormat 单条消息长度上限 (含结尾 0)
+constexpr int kLogIdleMicros = 1000;        // 缓冲区为空时后台线程的轮询间隔 (微秒)
+
+// 环形缓冲区中的一条日志记录
+struct LogRecord {
+    std::atomic<uint64_t> seq_{0};          // 槽位序号: 等于写入位置时可写, 等于写入位置+1时可读
+    time_t time_ = 0;                       // 写入时间 (秒)
+    size_t len_ = 0;                        // 文本长度
+    char text_[kLogInlineSize];             // 内联文本 (len_ < kLogInlineSize 时使用)
+    std::string long_text_;                 // 超长文本
+};
+
+// 文件日志类
 // 特点:
 // - 只写文件，不重定向流
-// - 线程安全
-// - 每次写入自动flush
+// - 调用线程只格式化消息并写入有界无锁环形缓冲区 (多生产者单消费者), 缓冲区满时等待
+// - 后台线程按秒缓存时间戳字符串, 每批记录一次写入并flush
 class Logger {
 public:
     // 构造函数 - 创建日志文件
@@ -58,21 +75,75 @@ public:
     // 参数: fmt - 格式化字符串, ... - 参数列表
     void WriteFormat(const char* fmt, ...);
 
+    // 等待此前写入的消息全部落盘
+    // 参数: timeout_ms - 最长等待时间 (毫秒), 负数表示一直等待
+    // 返回值: true=已落盘, false=超时
+    bool Flush(int timeout_ms = -1);
+
     // 获取日志文件路径
     std::string GetLogFilePath() const { return log_file_path_; }
 
 private:
-    // 获取当前时间戳 "[YYYY-MM-DD HH:MM:SS] "
-    std::string GetTimestamp();
+    // 申请一个可写槽位, 返回其写入位置
+    uint64_t Acquire();
+    // 发布槽位 (此后后台线程可读)
+    void Publish(uint64_t pos);
+
+    // 后台写入线程
+    void RunWriter();
+    // 取出当前缓冲区中的全部记录, 写入文件并flush; 返回取出的记录数
+    size_t Drain();
+
+    // 获取时间戳 "[YYYY-MM-DD HH:MM:SS] " (同一秒内复用上次结果)
+    const std::string& GetTimestamp(time_t time_val);
 
     std::ofstream log_file_;    // 日志文件流
-    std::mutex mutex_;          // 线程安全互斥锁
     std::string log_file_path_; // 日志文件完整路径
+
+    std::unique_ptr<LogRecord[]> ring_;         // 环形缓冲区
+    std::atomic<uint64_t> write_pos_{0};        // 下一个写入位置 (生产者)
+    uint64_t read_pos_ = 0;                     // 下一个读取位置 (仅后台线程)
+    std::atomic<uint64_t> flushed_pos_{0};      // 已落盘的位置
+    std::atomic<bool> stop_{false};
+    std::thread writer_;
+
+    // 以下仅后台线程访问
+    std::string batch_;                         // 本批待写入文本
+    time_t cached_time_ = -1;                   // 时间戳缓存
+    std::string cached_stamp_;
 };
 
 // 全局Logger指针
 extern Logger* g_logger;
 
+// 日志级别
+// 宏的级别低于编译期下限 LOG_COMPILE_LEVEL 时整条语句被编译器消除;
+// 低于运行期级别 g_log_level (--log-level) 时跳过, 不求值参数、不格式化
+enum LogLevel {
+    kLogTrace = 0,      // 逐 Arc / 逐列的明细 (对偶价格、约化成本、建模耗时)
+    kLogDebug = 1,      // 逐次迭代的子问题与主问题求解过程
+    kLogInfo = 2,       // 阶段进度与结果 (默认)
+    kLogWarn = 3        // 警告与错误
+};
+
+// 编译期级别下限: Release (定义 NDEBUG) 默认移除 trace 级日志, 可用 -DLOG_COMPILE_LEVEL=<n> 覆盖
+#ifndef LOG_COMPILE_LEVEL
+#ifdef NDEBUG
+#define LOG_COMPILE_LEVEL 1
+#else
+#define LOG_COMPILE_LEVEL 0
+#endif
+#endif
+
+// 运行期日志级别 (main 在创建工作线程前设置)
+extern int g_log_level;
+
+// 解析级别名 (trace / debug / info / warn), 无效时返回 -1
+int ParseLogLevel(const std::string& name);
+
+// 该级别的日志是否输出 (编译期下限为常量, 低于下限时整个条件为常量 false)
+#define LOG_LEVEL_ON(level) ((level) >= LOG_COMPILE_LEVEL && (level) >= g_log_level)
+
 // 获取时间戳字符串（用于文件名）
 // 返回格式: YYYYMMDD_HHMMSS
 inline std::string GetTimestampString() {
@@ -92,28 +163,38 @@ inline std::string GetTimestampString() {
 }
 
 // 日志输出宏 - 只写文件
+// LOG / LOG_FMT 为 info 级; 其他级别使用 LOG_TRACE / LOG_DEBUG / LOG_WARN 及对应的 _FMT 宏
 
 // 带换行的日志输出（只写文件）
-#define LOG(msg) do { \
-    if (g_logger) { \
+#define LOG_AT(level, msg) do { \
+    if (LOG_LEVEL_ON(level) && g_logger) { \
         g_logger->Write(std::string(msg) + "\n"); \
     } \
 } while(0)
 
 // 不带换行的日志输出（只写文件）
 #define LOG_NO_NL(msg) do { \
-    if (g_logger) { \
+    if (LOG_LEVEL_ON(kLogInfo) && g_logger) { \
         g_logger->Write(msg); \
     } \
 } while(0)
 
 // 格式化日志输出（只写文件）
-#define LOG_FMT(fmt, ...) do { \
-    if (g_logger) { \
+#define LOG_FMT_AT(level, fmt, ...) do { \
+    if (LOG_LEVEL_ON(level) && g_logger) { \
         g_logger->WriteFormat(fmt, ##__VA_ARGS__); \
     } \
 } while(0)
 
+#define LOG(msg)                LOG_AT(kLogInfo, msg)
+#define LOG_FMT(fmt, ...)       LOG_FMT_AT(kLogInfo, fmt, ##__VA_ARGS__)
+#define LOG_TRACE(msg)          LOG_AT(kLogTrace, msg)
+#define LOG_TRACE_FMT(fmt, ...) LOG_FMT_AT(kLogTrace, fmt, ##__VA_ARGS__)
+#define LOG_DEBUG(msg)          LOG_AT(kLogDebug, msg)
+#define LOG_DEBUG_FMT(fmt, ...) LOG_FMT_AT(kLogDebug, fmt, ##__VA_ARGS__)
+#define LOG_WARN(msg)           LOG_AT(kLogWarn, msg)
+#define LOG_WARN_FMT(fmt, ...)  LOG_FMT_AT(kLogWarn, fmt, ##__VA_ARGS__)
+
 // 控制台输出宏（独立，不经过Logger）
 // 用于关键进度信息的实时显示
 
@@ -135,8 +216,15 @@ inline std::string FormatElapsed(double elapsed_sec) {
 }
 
 // 带时间戳的控制台输出宏
-// 参数: elapsed - 已用时间(秒), fmt - 格式字符串, ... - 参数
-#define PROGRESS(elapsed, fmt, ...) \
-    fprintf(stderr, "%s " fmt, FormatElapsed(elapsed).c_str(), ##__VA_ARGS__)
+// 参数: level - 日志级别, elapsed - 已用时间(秒), fmt - 格式字符串, ... - 参数
+// 级别关闭时不求值 elapsed 与参数
+#define PROGRESS_AT(level, elapsed, fmt, ...) do { \
+    if (LOG_LEVEL_ON(level)) { \
+        fprintf(stderr, "%s " fmt, FormatElapsed(elapsed).c_str(), ##__VA_ARGS__); \
+    } \
+} while(0)
+
+// info 级进度输出
+#define PROGRESS(elapsed, fmt, ...) PROGRESS_AT(kLogInfo, elapsed, fmt, ##__VA_ARGS__)
 
 #endif  // LOGGER_H_
@@ -10,6 +10,12 @@
 // 4. 整数性检查: 若LP解为整数则直接输出, 否则进入分支定价
 // 5. 分支定价: 使用Arc分支策略逐步求解整数最优解
 //
+// 检查点: --checkpoint <file> 在分支定价期间定期写出完整状态
+//         --resume <file> 从检查点继续 (跳过阶段2-4, 须使用同一算例文件)
+//
+// 分布式: --serve <port> 作为协调进程, 阶段5的节点交给工作进程求解
+//         --worker <host:port> 作为工作进程 (须使用同一算例文件), 完成建网后只处理分支任务
+//
 // 子问题求解方法 (可配置):
 // - kCplexIP: CPLEX整数规划 (默认)
 // - kArcFlow: Arc Flow网络流模型 (支持Arc分支)
@@ -26,6 +32,23 @@ void PrintUsage(const char* program) {
     cout << "Options:\n";
     cout << "  -f, --file <path>    Specify instance file path\n";
     cout << "  -t, --time <seconds> Set time limit (0 = no limit)\n";
+    cout << "  -m, --mem-limit <MB> Memory budget; open nodes spill to disk above it (0 = no limit)\n";
+    cout << "  --checkpoint <file>  Write branch-and-price checkpoints to <file>\n";
+    cout << "  --checkpoint-interval <seconds>\n";
+    cout << "                       Checkpoint interval (default: " << kCheckpointIntervalSec << ")\n";
+    cout << "  --resume <file>      Resume branch-and-price from a checkpoint (same instance file)\n";
+    cout << "  --serve <port>       Coordinate a distributed branch-and-price on <port>\n";
+    cout << "  --worker <host:port> Run as a worker for the coordinator at <host:port> (same instance file)\n";
+    cout << "  --no-cuts            Disable rank-1 cut separation at branch nodes\n";
+    cout << "  --cg-threads <n>     Pricing threads for pipelined root column generation (0 = synchronous)\n";
+    cout << "  --cplex-config <file> CPLEX parameter profiles per solve phase (see cplex_profile.cpp)\n";
+    cout << "  --tune <file>        Time candidate LP algorithms per master phase and write the best profiles to <file>\n";
+    cout << "  --arc-cache <dir>    Arc network cache directory (default: " << kArcCacheDir << ")\n";
+    cout << "  --no-arc-cache       Disable the arc network cache\n";
+    cout << "  --profile-trace <file> Write a Chrome trace-event JSON of timed phases to <file>\n";
+    cout << "  --cg-trace <file>    Write per-iteration column generation records to <file> (.jsonl = JSON Lines, else CSV)\n";
+    cout << "  --tree-log <file>    Write branch-and-price tree events to <file> as JSON Lines (see tools/bp_tree_summary.cpp)\n";
+    cout << "  --log-level <level>  Log level: trace, debug, info (default), warn\n";
     cout << "  -h, --help           Show this help message\n";
     cout << "\nIf no file is specified, the latest instance in " << kDataDir << " will be used.\n";
 }
@@ -34,6 +57,21 @@ int main(int argc, char* argv[]) {
     // 解析命令行参数
     string instance_file = "";
     int time_limit = 0;  // 0表示无限制
+    int mem_limit = 0;   // MB, 0表示无限制
+    string arc_cache_dir = kArcCacheDir;
+    string checkpoint_file = "";
+    int checkpoint_interval = kCheckpointIntervalSec;
+    string resume_file = "";
+    int serve_port = 0;      // 0表示单进程求解
+    string worker_address = "";
+    bool use_cuts = true;
+    int cg_threads = 0;      // 0表示同步列生成
+    string cplex_config = "";
+    string tune_file = "";   // 非空表示自动调参
+    int log_level = kLogInfo;
+    string profile_trace = "";  // 非空表示写出 trace 文件
+    string cg_trace = "";       // 非空表示写出列生成逐次迭代记录
+    string tree_log = "";       // 非空表示写出分支树事件记录
 
     for (int i = 1; i < argc; i++) {
         string arg = argv[i];
@@ -44,6 +82,43 @@ int main(int argc, char* argv[]) {
             instance_file = argv[++i];
         } else if ((arg == "-t" || arg == "--time") && i + 1 < argc) {
             time_limit = atoi(argv[++i]);
+        } else if ((arg == "-m" || arg == "--mem-limit") && i + 1 < argc) {
+            mem_limit = atoi(argv[++i]);
+        } else if (arg == "--checkpoint" && i + 1 < argc) {
+            checkpoint_file = argv[++i];
+        } else if (arg == "--checkpoint-interval" && i + 1 < argc) {
+            checkpoint_interval = atoi(argv[++i]);
+        } else if (arg == "--resume" && i + 1 < argc) {
+            resume_file = argv[++i];
+        } else if (arg == "--serve" && i + 1 < argc) {
+            serve_port = atoi(argv[++i]);
+        } else if (arg == "--worker" && i + 1 < argc) {
+            worker_address = argv[++i];
+        } else if (arg == "--no-cuts") {
+            use_cuts = false;
+        } else if (arg == "--cg-threads" && i + 1 < argc) {
+            cg_threads = max(0, atoi(argv[++i]));
+        } else if (arg == "--cplex-config" && i + 1 < argc) {
+            cplex_config = argv[++i];
+        } else if (arg == "--tune" && i + 1 < argc) {
+            tune_file = argv[++i];
+        } else if (arg == "--profile-trace" && i + 1 < argc) {
+            profile_trace = argv[++i];
+        } else if (arg == "--cg-trace" && i + 1 < argc) {
+            cg_trace = argv[++i];
+        } else if (arg == "--tree-log" && i + 1 < argc) {
+            tree_log = argv[++i];
+        } else if (arg == "--log-level" && i + 1 < argc) {
+            log_level = ParseLogLevel(argv[++i]);
+            if (log_level < 0) {
+                cerr << "Unknown log level: " << argv[i] << "\n";
+                PrintUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--arc-cache" && i + 1 < argc) {
+            arc_cache_dir = argv[++i];
+        } else if (arg == "--no-arc-cache") {
+            arc_cache_dir = "";
         } else {
             cerr << "Unknown option: " << arg << "\n";
             PrintUsage(argv[0]);
@@ -55,7 +130,10 @@ int main(int argc, char* argv[]) {
     filesystem::create_directories("logs");
     filesystem::create_directories("lp");
 
-    // 初始化日志系统
+    // 初始化日志系统 (日志级别与 trace 开关在任何线程启动前设置)
+    g_log_level = log_level;
+    g_profile_trace = !profile_trace.empty();
+    SetProfileThreadName("main");
     // 日志文件命名: logs/log_2DBP_Arc_YYYYMMDD_HHMMSS.log
     string log_file = "logs/log_2DBP_Arc_" + GetTimestampString();
     Logger logger(log_file);
@@ -76,12 +154,38 @@ int main(int argc, char* argv[]) {
     // 设置时间控制
     params.time_limit_ = time_limit;
     params.start_time_ = chrono::steady_clock::now();
+    params.mem_limit_mb_ = mem_limit;
+    params.arc_cache_dir_ = arc_cache_dir;
+    params.checkpoint_file_ = checkpoint_file;
+    params.checkpoint_interval_ = checkpoint_interval;
+    params.use_cuts_ = use_cuts;
+    params.cg_threads_ = cg_threads;
+    params.cplex_tune_ = !tune_file.empty();
+    params.cplex_tune_file_ = tune_file;
+
+    // 各求解阶段的 CPLEX 参数: 默认值, 配置文件中的项覆盖默认值
+    if (!cplex_config.empty() && !LoadCplexProfiles(cplex_config, params)) {
+        CONSOLE_FMT("[错误] CPLEX配置读取失败\n");
+        return 1;
+    }
+    if (params.cplex_tune_) {
+        LOG_FMT("[系统] CPLEX自动调参: 结果写入 %s\n", tune_file.c_str());
+    }
 
     if (time_limit > 0) {
         LOG_FMT("[系统] 时间限制: %d 秒\n", time_limit);
     } else {
         LOG("[系统] 时间限制: 无");
     }
+    if (mem_limit > 0) {
+        LOG_FMT("[系统] 内存预算: %d MB (超出时节点溢出到 %s)\n", mem_limit, kSpillDir.c_str());
+    }
+    if (!checkpoint_file.empty()) {
+        LOG_FMT("[系统] 检查点: %s (每 %d 秒)\n", checkpoint_file.c_str(), checkpoint_interval);
+    }
+    if (!use_cuts) {
+        LOG("[系统] 秩1割: 关闭");
+    }
 
     // 配置子问题求解方法
     // SP1: 宽度方向背包问题 (在母板上选择条带)
@@ -101,7 +205,7 @@ int main(int argc, char* argv[]) {
 
     auto [status, num_items, num_strips] = LoadInput(params, data, instance_file);
     if (status != 0) {
-        LOG("[错误] 数据读取失败");
+        LOG_WARN("[错误] 数据读取失败");
         CONSOLE_FMT("[错误] 数据读取失败\n");
         return 1;
     }
@@ -113,53 +217,97 @@ int main(int argc, char* argv[]) {
     PROGRESS(GetElapsedTime(params), "数据 | %d种子板 | 母板:%dx%d\n",
         params.num_item_types_, params.stock_width_, params.stock_length_);
 
-    // 如果使用Arc Flow方法, 预先生成Arc网络
-    if (params.sp1_method_ == kArcFlow || params.sp2_method_ == kArcFlow) {
-        GenerateAllArcs(data, params);
+    // 预处理: 算例约简 -> 尺寸缩放 (导出解前恢复) -> 定价上界
+    ReduceInstance(params, data);
+    PreprocessDimensions(params, data);
+    ComputePricingBounds(params, data);
+
+    // 预先生成Arc网络
+    // 除Arc Flow定价外, 列入池时的规范Arc编号和分支阶段的Arc分支也依赖该网络
+    GenerateAllArcs(data, params);
+
+    // 列生成逐次迭代记录 (条带类型数与定价上界在预处理后确定)
+    if (!cg_trace.empty() && !OpenCGTrace(cg_trace, params, data)) {
+        return 1;
+    }
+    if (!tree_log.empty() && !OpenTreeLog(tree_log)) {
+        return 1;
     }
 
-    // 阶段2: 启发式生成初始解
-    LOG("------------------------------------------------------------");
-    LOG("[阶段2] 启发式生成初始解");
-    LOG("------------------------------------------------------------");
+    // 工作进程: 只处理协调进程派发的分支任务
+    // 节点求解不设时间限制, 由协调进程控制 (超时会把节点误判为剪枝)
+    if (!worker_address.empty()) {
+        params.time_limit_ = 0;
+        return RunBPWorker(params, data, worker_address) == 0 ? 0 : 1;
+    }
 
-    RunHeuristic(params, data, root_node);
+    // 从检查点继续: 恢复列池、根节点与待处理节点, 跳过阶段2-4
+    BPCheckpoint resume;
+    bool resumed = false;
+    if (!resume_file.empty()) {
+        if (!LoadCheckpoint(resume_file, params, data, root_node, resume)) {
+            LOG_WARN("[错误] 检查点读取失败");
+            CONSOLE_FMT("[错误] 检查点读取失败\n");
+            return 1;
+        }
+        resumed = true;
+        PROGRESS(GetElapsedTime(params), "恢复 | 检查点 %s | LB=%.2f 待处理节点%d\n",
+            resume_file.c_str(), root_node.lower_bound_, (int)resume.open_nodes_.size());
+    }
 
-    // 阶段3: 根节点列生成
-    LOG("------------------------------------------------------------");
-    LOG("[阶段3] 根节点列生成");
-    LOG("------------------------------------------------------------");
+    bool is_integer = false;
+    if (!resumed) {
+        // 阶段2: 启发式生成初始解
+        LOG("------------------------------------------------------------");
+        LOG("[阶段2] 启发式生成初始解");
+        LOG("------------------------------------------------------------");
 
-    SolveRootCG(params, data, root_node);
+        RunHeuristic(params, data);
 
-    // 阶段4: 检查整数性
-    LOG("------------------------------------------------------------");
-    LOG("[阶段4] 整数性检查");
-    LOG("------------------------------------------------------------");
+        // 阶段3: 根节点列生成
+        LOG("------------------------------------------------------------");
+        LOG("[阶段3] 根节点列生成");
+        LOG("------------------------------------------------------------");
+
+        SolveRootCG(params, data, root_node);
+
+        // 阶段4: 检查整数性
+        LOG("------------------------------------------------------------");
+        LOG("[阶段4] 整数性检查");
+        LOG("------------------------------------------------------------");
 
-    bool is_integer = IsIntegerSolution(root_node.solution_);
+        is_integer = IsIntegerSolution(root_node.solution_);
+    }
 
     if (is_integer) {
         // LP解恰好为整数, 无需分支
         LOG("[结果] 根节点解为整数解, 无需分支");
         params.global_best_int_ = root_node.solution_.obj_val_;
-        params.global_best_y_cols_ = root_node.solution_.y_columns_;
-        params.global_best_x_cols_ = root_node.solution_.x_columns_;
+        params.global_best_sol_ = root_node.solution_;
+        params.optimal_lb_ = root_node.lower_bound_;
 
         // 导出根节点解 (供测试可视化)
+        RestoreDimensions(params, data);
         ExportSolution(params, data);
     } else {
         // LP解为分数, 需要分支定价求整数解
         LOG("[结果] 根节点解非整数, 需要分支定价");
-        PROGRESS(GetElapsedTime(params), "CG   | 收敛 LP=%.2f (分数解)\n",
-            root_node.solution_.obj_val_);
+        if (!resumed) {
+            PROGRESS(GetElapsedTime(params), "CG   | 收敛 LP=%.2f (分数解)\n",
+                root_node.solution_.obj_val_);
+        }
 
         // 阶段5: 分支定价
         LOG("------------------------------------------------------------");
         LOG("[阶段5] 分支定价求解");
         LOG("------------------------------------------------------------");
 
-        RunBranchAndPrice(params, data, &root_node);
+        if (serve_port > 0) {
+            RunDistributedBP(params, data, &root_node, serve_port);
+        } else {
+            RunBranchAndPrice(params, data, &root_node, resumed ? &resume : nullptr);
+        }
+        RestoreDimensions(params, data);
 
         // 导出最优解 (供 CS-2D-Fig 可视化)
         if (params.global_best_int_ < INFINITY) {
@@ -167,9 +315,24 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    // 各阶段主问题求解耗时 (调参时写出配置文件)
+    ReportCplexProfiles(params);
+    ReportProfile(profile_trace);
+    CloseCGTrace();
+    CloseTreeLog();
+
     // 计算总耗时
     double elapsed_sec = GetElapsedTime(params);
 
+    // 最终母板数 = 主问题最优解 + 预处理固定的整板; 下界与间隙同样按总数计算 (与 ExportSolution 一致)
+    double total_best = params.global_best_int_ + params.fixed_plates_;
+    double total_lb = params.optimal_lb_ + params.fixed_plates_;
+    double total_root_lb = root_node.lower_bound_ + params.fixed_plates_;
+    double total_gap = params.gap_;
+    if (total_best < INFINITY && total_lb < INFINITY && total_best > kZeroTolerance) {
+        total_gap = (total_best - total_lb) / total_best;
+    }
+
     // 输出求解结果汇总
     LOG("============================================================");
     LOG("  求解结果 (Solution Summary)");
@@ -182,22 +345,25 @@ int main(int argc, char* argv[]) {
 
         if (params.global_best_int_ < INFINITY) {
             LOG("  [当前状态] 已找到可行整数解，但未证明最优");
-            LOG_FMT("  [当前最优解] %.0f 块母板\n", params.global_best_int_);
-            LOG_FMT("  [当前下界] %.4f\n", params.optimal_lb_);
-            LOG_FMT("  [当前Gap] %.2f%% (未证明最优)\n", params.gap_ * 100);
+            LOG_FMT("  [当前最优解] %.0f 块母板\n", total_best);
+            LOG_FMT("  [当前下界] %.4f\n", total_lb);
+            LOG_FMT("  [当前Gap] %.2f%% (未证明最优)\n", total_gap * 100);
         } else {
             LOG("  [当前状态] 尚未找到整数解");
-            LOG_FMT("  [LP下界] %.4f\n", root_node.lower_bound_);
+            LOG_FMT("  [LP下界] %.4f\n", total_root_lb);
             LOG("  [建议] 增加时间限制或简化问题规模");
         }
         LOG_FMT("  [已探索节点] %d\n", params.node_counter_);
     } else {
-        LOG_FMT("  最优目标值 (母板数): %.4f\n", params.global_best_int_);
-        LOG_FMT("  根节点下界: %.4f\n", root_node.lower_bound_);
-        LOG_FMT("  最优性间隙: %.2f%%\n", params.gap_ * 100);
+        LOG_FMT("  最优目标值 (母板数): %.4f\n", total_best);
+        LOG_FMT("  根节点下界: %.4f\n", total_root_lb);
+        LOG_FMT("  最优性间隙: %.2f%%\n", total_gap * 100);
         LOG_FMT("  分支节点数: %d\n", params.node_counter_);
     }
 
+    if (params.fixed_plates_ > 0) {
+        LOG_FMT("  预处理固定整板: %d 块 (已计入目标值与下界)\n", params.fixed_plates_);
+    }
     LOG_FMT("  总耗时: %.3f 秒\n", elapsed_sec);
     LOG("============================================================");
 
@@ -205,28 +371,33 @@ int main(int argc, char* argv[]) {
     if (params.is_timeout_) {
         if (params.global_best_int_ < INFINITY) {
             PROGRESS(elapsed_sec, "完成 | 超时 | 解=%.0f Gap=%.1f%% nodes=%d\n",
-                params.global_best_int_, params.gap_ * 100, params.node_counter_);
+                total_best, total_gap * 100, params.node_counter_);
         } else {
             PROGRESS(elapsed_sec, "完成 | 超时 | 未找到整数解 nodes=%d\n",
                 params.node_counter_);
         }
     } else {
         PROGRESS(elapsed_sec, "完成 | 最优=%.0f Gap=%.1f%% nodes=%d\n",
-            params.global_best_int_, params.gap_ * 100, params.node_counter_);
+            total_best, total_gap * 100, params.node_counter_);
     }
 
     // 输出最优切割方案
     if (params.global_best_int_ < INFINITY) {
+        const ColumnStore& y_store = data.y_columns_;
+        const ColumnStore& x_store = data.x_columns_;
+        const NodeSolution& best = params.global_best_sol_;
+
         // 输出Y列 (母板切割方案)
         LOG("[最优解] Y列 (母板切割方案):");
-        for (int i = 0; i < (int)params.global_best_y_cols_.size(); i++) {
-            if (params.global_best_y_cols_[i].value_ > kZeroTolerance) {
+        for (const auto& entry : best.y_cols_) {
+            if (entry.value_ > kZeroTolerance) {
+                int i = entry.col_;
                 ostringstream oss;
                 oss << "  Y" << (i + 1) << " = " << fixed << setprecision(0)
-                    << params.global_best_y_cols_[i].value_ << " [";
-                for (int j = 0; j < (int)params.global_best_y_cols_[i].pattern_.size(); j++) {
+                    << entry.value_ << " [";
+                for (int j = 0; j < y_store.width_; j++) {
                     if (j > 0) oss << ", ";
-                    oss << params.global_best_y_cols_[i].pattern_[j];
+                    oss << GetPatternCoef(y_store, i, j);
                 }
                 oss << "]";
                 LOG(oss.str().c_str());
@@ -235,15 +406,16 @@ int main(int argc, char* argv[]) {
 
         // 输出X列 (条带切割方案)
         LOG("[最优解] X列 (条带切割方案):");
-        for (int i = 0; i < (int)params.global_best_x_cols_.size(); i++) {
-            if (params.global_best_x_cols_[i].value_ > kZeroTolerance) {
+        for (const auto& entry : best.x_cols_) {
+            if (entry.value_ > kZeroTolerance) {
+                int i = entry.col_;
                 ostringstream oss;
-                oss << "  X" << (i + 1) << " (条带" << params.global_best_x_cols_[i].strip_type_id_ + 1
+                oss << "  X" << (i + 1) << " (条带" << x_store.strip_types_[i] + 1
                     << ") = " << fixed << setprecision(0)
-                    << params.global_best_x_cols_[i].value_ << " [";
-                for (int j = 0; j < (int)params.global_best_x_cols_[i].pattern_.size(); j++) {
+                    << entry.value_ << " [";
+                for (int j = 0; j < x_store.width_; j++) {
                     if (j > 0) oss << ", ";
-                    oss << params.global_best_x_cols_[i].pattern_[j];
+                    oss << GetPatternCoef(x_store, i, j);
                 }
                 oss << "]";
                 LOG(oss.str().c_str());
@@ -3,58 +3,80 @@
 // 本文件实现Branch and Price树中非根节点的列生成过程
 // 与根节点的主要区别:
 // 1. 使用指针BPNode*而非引用, 便于树结构管理
-// 2. 继承父节点的列池和分支约束
+// 2. 共享全局列池, 继承父节点的分支约束
 // 3. 支持变量分支约束 (branched_var_ids_, branched_bounds_)
 // 4. 支持Arc分支约束 (sp1_*_arcs_, sp2_*_arcs_)
 //
 // 分支节点的处理流程:
-// 1. 从父节点继承列池 (y_columns_, x_columns_)
+// 1. 使用全局列池 (data.y_columns_, data.x_columns_) 构建主问题
 // 2. 应用分支约束到变量上界
 // 3. 执行列生成直至收敛
 // 4. 检查是否需要剪枝或进一步分支
+//
+// 分支切割定价: 列生成收敛后在需求行上分离秩1割 (cuts.cpp), 加入 RMP 后继续列生成,
+// 至多 kMaxCutRounds 轮; 割行对偶价格通过标签定价进入 SP2 (SolveNodeSP2Labels)
 
 #include "2DBP.h"
 
 using namespace std;
 
-// 非根节点列生成主循环
-// 功能: 对分支节点执行列生成, 求解其LP松弛问题
-// 与根节点的区别:
-//   - 继承父节点的列池和对偶价格
-//   - 变量上界受分支约束限制
-//   - 子问题中应用Arc分支约束 (在SolveNodeSP1ArcFlow等中处理)
-// 返回值: 0=正常完成, -1=节点不可行(被剪枝)
-int SolveNodeCG(ProblemParams& params, ProblemData& data, BPNode* node) {
-    LOG_FMT("[CG] 节点%d 列生成开始\n", node->id_);
+// 读取节点 Arc 约束行的对偶价格, 并写入各网络的稠密 arc_duals_
+// 每次 RMP 求解后调用, 定价时按 Arc 编号直接读取 μ_a
+void ExtractNodeArcDuals(ProblemData& data, IloCplex& cplex,
+    IloRangeArray& cons, BPNode* node) {
 
-    // 继承全局SP方法设置
-    // 注意: 非根节点通常使用Arc Flow以支持Arc分支约束
-    node->sp1_method_ = params.sp1_method_;
-    node->sp2_method_ = params.sp2_method_;
+    for (auto& con_row : node->arc_con_rows_) {
+        double dual = cplex.getDual(cons[con_row.row_]);
+        if (dual == -0.0) dual = 0.0;
+        con_row.dual_ = dual;
+    }
+    ScatterArcDuals(data, node);
+}
 
-    // 初始化CPLEX环境
-    IloEnv env;
-    IloModel model(env);
-    IloObjective obj = IloAdd(model, IloMinimize(env));
-    IloNumVarArray vars(env);
-    IloRangeArray cons(env);
+// 读取节点割行的对偶价格 ρ_c, 每次 RMP 求解后调用
+void ExtractNodeCutDuals(IloCplex& cplex, IloRangeArray& cons, BPNode* node) {
+    for (auto& cut_row : node->cut_rows_) {
+        double dual = cplex.getDual(cons[cut_row.row_]);
+        if (dual == -0.0) dual = 0.0;
+        cut_row.dual_ = dual;
+    }
+}
 
-    node->iter_ = 0;  // 迭代计数器
+// 为 node->cut_ids_[first..] 添加割行: Σ_p ceil(Σ_{i∈S} a_ip / q) X_p >= rhs
+// 系数覆盖列池中的全部 X 列 (均已在当前 RMP 中), 之后新增的 X 列由 SolveNodeUpdateMP 设置系数
+void AddNodeCutRows(ProblemData& data, IloEnv& env, IloModel& model,
+    IloRangeArray& cons, IloNumVarArray& vars, BPNode* node, int first) {
 
-    // 构建并求解初始主问题
-    // 初始列继承自父节点, 变量上界受分支约束限制
-    bool feasible = SolveNodeInitMP(params, data, env, model, obj, cons, vars, node);
+    const ColumnStore& x_store = data.x_columns_;
+    for (int k = first; k < (int)node->cut_ids_.size(); k++) {
+        int cut_id = node->cut_ids_[k];
+        const RankOneCut& cut = data.cut_pool_[cut_id];
 
-    if (!feasible) {
-        // 节点不可行 (分支约束导致无法满足需求)
-        // 标记剪枝并返回
-        node->prune_flag_ = 1;
-        env.end();
-        LOG_FMT("[CG] 节点%d 不可行, 剪枝\n", node->id_);
-        return -1;
+        IloExpr lhs(env);
+        for (int col = 0; col < x_store.num_cols_; col++) {
+            int coef = CutColumnCoef(cut, x_store, col);
+            if (coef > 0) lhs += coef * vars[x_store.var_indices_[col]];
+        }
+        IloRange cut_con(env, cut.rhs_, lhs, IloInfinity);
+        cut_con.setName(("Cut_" + to_string(cut_id)).c_str());
+        cons.add(cut_con);
+        model.add(cut_con);
+        lhs.end();
+
+        CutRow cut_row;
+        cut_row.row_ = static_cast<int>(cons.getSize()) - 1;
+        cut_row.cut_id_ = cut_id;
+        node->cut_rows_.push_back(cut_row);
     }
+}
+
+// 列生成迭代: SP1 -> 全部 SP2, 有改进列即加入 RMP, 直到收敛
+// 返回值: true=收敛 (最终对偶价格下所有子问题均无改进列), false=超时或达到迭代上限
+static bool RunNodeCGLoop(ProblemParams& params, ProblemData& data, IloObjective& obj,
+    IloRangeArray& cons, IloNumVarArray& vars, IloCplex& cplex, BPNode* node) {
+
+    CGIterTrace trace;  // --cg-trace 逐次迭代记录
 
-    // 列生成主循环
     while (true) {
         node->iter_++;
 
@@ -63,49 +85,134 @@ int SolveNodeCG(ProblemParams& params, ProblemData& data, BPNode* node) {
             params.is_timeout_ = true;
             LOG_FMT("[CG] 节点%d: 达到时间限制, 终止列生成\n", node->id_);
             node->prune_flag_ = true;  // 标记节点剪枝
-            break;
+            return false;
         }
 
         // 检查最大迭代次数限制
         if (node->iter_ >= kMaxCgIter) {
-            LOG_FMT("[CG] 警告: 达到最大迭代次数 %d (异常), 强制终止\n", kMaxCgIter);
-            LOG("[CG]    正常应该收敛, 请检查算法或降低 kMaxCgIter 以更早发现问题");
-            break;
+            LOG_WARN_FMT("[CG] 警告: 达到最大迭代次数 %d (异常), 强制终止\n", kMaxCgIter);
+            LOG_WARN("[CG]    正常应该收敛, 请检查算法或降低 kMaxCgIter 以更早发现问题");
+            return false;
         }
 
         // 步骤1: 求解SP1子问题 (宽度方向背包)
         // Arc分支约束在子问题求解函数中应用
+        BeginCGIterTrace(trace, params, node->id_, node->iter_, cplex, cons, vars);
+        int64_t sp_start = ProfileNow();
         bool sp1_converged = SolveNodeSP1(params, data, node);
+        TraceSP1(trace, *node, sp1_converged, sp_start);
 
         if (sp1_converged) {
             // SP1收敛, 检查所有SP2子问题
             bool all_sp2_converged = true;
 
             for (int j = 0; j < params.num_strip_types_; j++) {
+                sp_start = ProfileNow();
                 bool sp2_converged = SolveNodeSP2(params, data, node, j);
+                TraceSP2(trace, *node, j, sp2_converged, sp_start);
 
                 if (!sp2_converged) {
                     all_sp2_converged = false;
                     // 添加新X列到主问题
-                    SolveNodeUpdateMP(params, data, env, model, obj, cons, vars, node);
+                    int64_t mp_start = ProfileNow();
+                    SolveNodeUpdateMP(params, data, obj, cons, vars, cplex, node);
+                    TraceMasterSolve(trace, mp_start);
                 }
             }
 
             // 检查是否完全收敛
             if (all_sp2_converged) {
+                WriteCGIterTrace(trace);
                 LOG_FMT("[CG] 列生成收敛, 迭代%d次\n", node->iter_);
-                break;
+                return true;
             }
         } else {
             // SP1找到改进列, 添加新Y列
-            SolveNodeUpdateMP(params, data, env, model, obj, cons, vars, node);
+            int64_t mp_start = ProfileNow();
+            SolveNodeUpdateMP(params, data, obj, cons, vars, cplex, node);
+            TraceMasterSolve(trace, mp_start);
         }
+        WriteCGIterTrace(trace);
+    }
+}
+
+// 非根节点列生成主循环
+// 功能: 对分支节点执行列生成, 求解其LP松弛问题
+// 与根节点的区别:
+//   - 使用全局列池, 继承父节点的分支约束
+//   - 变量上界受分支约束限制
+//   - 子问题中应用Arc分支约束 (在SolveNodeSP1ArcFlow等中处理)
+// 返回值: 0=正常完成, -1=节点不可行(被剪枝)
+int SolveNodeCG(ProblemParams& params, ProblemData& data, BPNode* node) {
+    PROFILE_ZONE("cg.node");
+
+    LOG_FMT("[CG] 节点%d 列生成开始\n", node->id_);
+
+    // 继承全局SP方法设置
+    // 注意: 非根节点通常使用Arc Flow以支持Arc分支约束
+    node->sp1_method_ = params.sp1_method_;
+    node->sp2_method_ = params.sp2_method_;
+
+    // 初始化CPLEX环境
+    IloEnv env;
+    IloModel model(env);
+    IloObjective obj = IloAdd(model, IloMinimize(env));
+    IloNumVarArray vars(env);
+    IloRangeArray cons(env);
+
+    // 节点内各次 RMP 求解共用一个 cplex 对象, 加列 / 加割行后从上一次的基热启动
+    IloCplex cplex(env);
+    cplex.setOut(env.getNullStream());
+
+    node->iter_ = 0;  // 迭代计数器
+
+    // 构建并求解初始主问题
+    // 初始列继承自父节点, 变量上界受分支约束限制
+    bool feasible = SolveNodeInitMP(params, data, env, model, obj, cons, vars, cplex, node);
+
+    if (!feasible) {
+        // 节点不可行 (分支约束导致无法满足需求)
+        // 标记剪枝并返回
+        node->prune_flag_ = 1;
+        env.end();
+        LOG_FMT("[CG] 节点%d 不可行, 剪枝\n", node->id_);
+        return -1;
+    }
+
+    // 列生成主循环
+    bool converged = RunNodeCGLoop(params, data, obj, cons, vars, cplex, node);
+    node->cg_converged_ = converged ? 1 : 0;
+
+    // 割平面轮次: 收敛后分离秩1割, 加入 RMP 并继续列生成
+    // 节点已可剪枝 (ceil(下界) >= UB) 或没有违反的割时停止
+    for (int round = 1; params.use_cuts_ && converged && round <= kMaxCutRounds; round++) {
+        if (!SolveNodeFinalMP(params, data, obj, cons, vars, cplex, node)) break;
+        if (ceil(node->lower_bound_ - kIntTolerance) >= params.global_best_int_ - kZeroTolerance) {
+            break;
+        }
+
+        double lb_before = node->lower_bound_;
+        int first = static_cast<int>(node->cut_ids_.size());
+        if (SeparateRankOneCuts(params, data, node) == 0) break;
+        AddNodeCutRows(data, env, model, cons, vars, node, first);
+
+        // 重新求解 RMP 刷新对偶价格 (含新割行), 再继续列生成
+        SolveNodeUpdateMP(params, data, obj, cons, vars, cplex, node);
+        converged = RunNodeCGLoop(params, data, obj, cons, vars, cplex, node);
+        node->cg_converged_ = converged ? 1 : 0;
+        LOG_FMT("[Cut] 节点%d 第%d轮: 节点割%d条, 加割前下界 %.4f%s\n",
+            node->id_, round, (int)node->cut_ids_.size(), lb_before,
+            converged ? "" : ", 列生成未收敛");
     }
 
     // 求解最终主问题, 提取完整解
-    SolveNodeFinalMP(params, data, env, model, obj, cons, vars, node);
+    SolveNodeFinalMP(params, data, obj, cons, vars, cplex, node);
+
+    // 子节点只继承对偶价格为正的割
+    DropSlackCuts(node);
 
     // 释放CPLEX资源
+    cplex.end();
     obj.end();
     vars.end();
     cons.end();
@@ -117,7 +224,7 @@ int SolveNodeCG(ProblemParams& params, ProblemData& data, BPNode* node) {
 }
 
 // 构建并求解非根节点的初始主问题
-// 功能: 基于继承的列池构建主问题, 应用变量分支约束和Arc行约束
+// 功能: 基于全局列池构建主问题, 应用变量分支约束和Arc行约束
 // 变量分支约束:
 //   - branched_var_ids_: 受分支约束影响的变量索引
 //   - branched_bounds_: 对应变量的上界 (来自左分支的floor(v))
@@ -128,10 +235,14 @@ int SolveNodeCG(ProblemParams& params, ProblemData& data, BPNode* node) {
 // 返回值: true=可行, false=不可行
 bool SolveNodeInitMP(ProblemParams& params, ProblemData& data,
     IloEnv& env, IloModel& model, IloObjective& obj,
-    IloRangeArray& cons, IloNumVarArray& vars, BPNode* node) {
-
-    int num_y_cols = static_cast<int>(node->y_columns_.size());
-    int num_x_cols = static_cast<int>(node->x_columns_.size());
+    IloRangeArray& cons, IloNumVarArray& vars,
+    IloCplex& cplex, BPNode* node) {
+    PROFILE_ZONE("rmp.node.init");
+
+    ColumnStore& y_store = data.y_columns_;
+    ColumnStore& x_store = data.x_columns_;
+    int num_y_cols = y_store.num_cols_;
+    int num_x_cols = x_store.num_cols_;
     int num_strip_types = params.num_strip_types_;
     int num_item_types = params.num_item_types_;
     int num_base_rows = num_strip_types + num_item_types;
@@ -167,7 +278,7 @@ bool SolveNodeInitMP(ProblemParams& params, ProblemData& data,
 
         // 条带产出系数
         for (int j = 0; j < num_strip_types; j++) {
-            cplex_col += cons[j](node->y_columns_[col].pattern_[j]);
+            cplex_col += cons[j](GetPatternCoef(y_store, col, j));
         }
         // 需求约束系数 (Y列不直接满足需求)
         for (int i = 0; i < num_item_types; i++) {
@@ -187,14 +298,14 @@ bool SolveNodeInitMP(ProblemParams& params, ProblemData& data,
         string var_name = "Y_" + to_string(col + 1);
         IloNumVar var(cplex_col, 0, var_ub, ILOFLOAT, var_name.c_str());
         vars.add(var);
-        node->y_columns_[col].var_index_ = col;  // 记录变量索引
+        y_store.var_indices_[col] = col;  // 记录变量索引
         cplex_col.end();
     }
 
     // 添加X变量 (条带模式)
     for (int col = 0; col < num_x_cols; col++) {
         IloNumColumn cplex_col = obj(0.0);  // 目标系数=0
-        int strip_type = node->x_columns_[col].strip_type_id_;
+        int strip_type = x_store.strip_types_[col];
 
         // 条带消耗系数
         for (int j = 0; j < num_strip_types; j++) {
@@ -202,7 +313,7 @@ bool SolveNodeInitMP(ProblemParams& params, ProblemData& data,
         }
         // 需求满足系数
         for (int i = 0; i < num_item_types; i++) {
-            cplex_col += cons[num_strip_types + i](node->x_columns_[col].pattern_[i]);
+            cplex_col += cons[num_strip_types + i](GetPatternCoef(x_store, col, i));
         }
 
         // 检查变量分支约束
@@ -219,7 +330,7 @@ bool SolveNodeInitMP(ProblemParams& params, ProblemData& data,
         string var_name = "X_" + to_string(col + 1);
         IloNumVar var(cplex_col, 0, var_ub, ILOFLOAT, var_name.c_str());
         vars.add(var);
-        node->x_columns_[col].var_index_ = num_y_cols + col;  // 记录变量索引
+        x_store.var_indices_[col] = num_y_cols + col;  // 记录变量索引
         cplex_col.end();
     }
 
@@ -229,88 +340,72 @@ bool SolveNodeInitMP(ProblemParams& params, ProblemData& data,
     // 约束形式: F_a = Σ_{p: uses arc a} X_p 或 Y_q
     // ============================================================
 
-    // 用于存储 Arc 约束行的索引, 以便后续提取对偶价格
-    vector<pair<int, array<int, 2>>> sp1_arc_cons_info;  // (cons索引, arc)
-    map<int, vector<pair<int, array<int, 2>>>> sp2_arc_cons_info;  // strip_type -> (cons索引, arc)
-
-    // SP1 Arc 约束 (宽度方向, 作用于 Y 列)
-    // F^Y_a = Σ_{q: q uses arc a} Y_q
-    // 零弧约束: F^Y_a <= 0
-    for (const auto& arc : node->sp1_zero_arcs_) {
+    // 添加一条 Arc 行约束: lb <= F_a <= ub
+    // 同时记录该行的位置和所属网络, 供更新列系数和提取对偶价格使用
+    node->arc_con_rows_.clear();
+    auto add_arc_row = [&](int strip_type, const array<int, 2>& arc,
+                           IloNum lb, IloNum ub, const string& con_name) {
+        int arc_idx = FindArcIndex(data, strip_type, arc);
         IloExpr arc_flow(env);
-        for (int col = 0; col < num_y_cols; col++) {
-            // 检查该 Y 列是否使用此 arc
-            if (node->y_columns_[col].arc_set_.count(arc) > 0) {
-                arc_flow += vars[col];
+        if (strip_type < 0) {
+            // SP1: F^Y_a = Σ_{q: q uses arc a} Y_q
+            for (int col = 0; col < num_y_cols; col++) {
+                if (ColumnUsesArc(y_store, col, arc_idx)) {
+                    arc_flow += vars[y_store.var_indices_[col]];
+                }
+            }
+        } else {
+            // SP2: F^X_a = Σ_{p: j(p)=j(a) and p uses arc a} X_p
+            for (int col = 0; col < num_x_cols; col++) {
+                if (x_store.strip_types_[col] == strip_type &&
+                    ColumnUsesArc(x_store, col, arc_idx)) {
+                    arc_flow += vars[x_store.var_indices_[col]];
+                }
             }
         }
-        IloRange arc_con(env, -IloInfinity, arc_flow, 0);  // F_a <= 0
-        string con_name = "SP1_zero_" + to_string(arc[0]) + "_" + to_string(arc[1]);
+        IloRange arc_con(env, lb, arc_flow, ub);
         arc_con.setName(con_name.c_str());
         cons.add(arc_con);
         model.add(arc_con);
-        sp1_arc_cons_info.push_back({static_cast<int>(cons.getSize()) - 1, arc});
         arc_flow.end();
+
+        ArcConRow con_row;
+        con_row.row_ = static_cast<int>(cons.getSize()) - 1;
+        con_row.strip_type_ = strip_type;
+        con_row.arc_idx_ = arc_idx;
+        con_row.arc_ = arc;
+        node->arc_con_rows_.push_back(con_row);
+    };
+    auto arc_suffix = [](const array<int, 2>& arc) {
+        return to_string(arc[0]) + "_" + to_string(arc[1]);
+    };
+
+    // SP1 Arc 约束 (宽度方向, 作用于 Y 列)
+    // 零弧约束: F^Y_a <= 0
+    for (const auto& arc : node->sp1_zero_arcs_) {
+        add_arc_row(-1, arc, -IloInfinity, 0, "SP1_zero_" + arc_suffix(arc));
     }
 
     // SP1 上界约束: F^Y_a <= bound
     for (size_t i = 0; i < node->sp1_lower_arcs_.size(); i++) {
         const auto& arc = node->sp1_lower_arcs_[i];
-        int bound = node->sp1_lower_bounds_[i];
-        IloExpr arc_flow(env);
-        for (int col = 0; col < num_y_cols; col++) {
-            if (node->y_columns_[col].arc_set_.count(arc) > 0) {
-                arc_flow += vars[col];
-            }
-        }
-        IloRange arc_con(env, -IloInfinity, arc_flow, bound);  // F_a <= bound
-        string con_name = "SP1_ub_" + to_string(arc[0]) + "_" + to_string(arc[1]);
-        arc_con.setName(con_name.c_str());
-        cons.add(arc_con);
-        model.add(arc_con);
-        sp1_arc_cons_info.push_back({static_cast<int>(cons.getSize()) - 1, arc});
-        arc_flow.end();
+        add_arc_row(-1, arc, -IloInfinity, node->sp1_lower_bounds_[i],
+            "SP1_ub_" + arc_suffix(arc));
     }
 
     // SP1 下界约束: F^Y_a >= bound
     for (size_t i = 0; i < node->sp1_greater_arcs_.size(); i++) {
         const auto& arc = node->sp1_greater_arcs_[i];
-        int bound = node->sp1_greater_bounds_[i];
-        IloExpr arc_flow(env);
-        for (int col = 0; col < num_y_cols; col++) {
-            if (node->y_columns_[col].arc_set_.count(arc) > 0) {
-                arc_flow += vars[col];
-            }
-        }
-        IloRange arc_con(env, bound, arc_flow, IloInfinity);  // F_a >= bound
-        string con_name = "SP1_lb_" + to_string(arc[0]) + "_" + to_string(arc[1]);
-        arc_con.setName(con_name.c_str());
-        cons.add(arc_con);
-        model.add(arc_con);
-        sp1_arc_cons_info.push_back({static_cast<int>(cons.getSize()) - 1, arc});
-        arc_flow.end();
+        add_arc_row(-1, arc, node->sp1_greater_bounds_[i], IloInfinity,
+            "SP1_lb_" + arc_suffix(arc));
     }
 
     // SP2 Arc 约束 (长度方向, 作用于 X 列, 按条带类型)
-    // F^X_a = Σ_{p: j(p)=j(a) and p uses arc a} X_p
     for (const auto& kv : node->sp2_zero_arcs_) {
         int strip_type = kv.first;
         for (const auto& arc : kv.second) {
-            IloExpr arc_flow(env);
-            for (int col = 0; col < num_x_cols; col++) {
-                if (node->x_columns_[col].strip_type_id_ == strip_type &&
-                    node->x_columns_[col].arc_set_.count(arc) > 0) {
-                    arc_flow += vars[num_y_cols + col];
-                }
-            }
-            IloRange arc_con(env, -IloInfinity, arc_flow, 0);  // F_a <= 0
-            string con_name = "SP2_zero_" + to_string(strip_type) + "_" +
-                              to_string(arc[0]) + "_" + to_string(arc[1]);
-            arc_con.setName(con_name.c_str());
-            cons.add(arc_con);
-            model.add(arc_con);
-            sp2_arc_cons_info[strip_type].push_back({static_cast<int>(cons.getSize()) - 1, arc});
-            arc_flow.end();
+            add_arc_row(strip_type, arc, -IloInfinity, 0,
+                "SP2_zero_" + to_string(strip_type) + "_" + arc_suffix(arc));
         }
     }
 
@@ -320,23 +415,8 @@ bool SolveNodeInitMP(ProblemParams& params, ProblemData& data,
         const auto& arcs = kv.second;
         const auto& bounds = node->sp2_lower_bounds_.at(strip_type);
         for (size_t i = 0; i < arcs.size(); i++) {
-            const auto& arc = arcs[i];
-            int bound = bounds[i];
-            IloExpr arc_flow(env);
-            for (int col = 0; col < num_x_cols; col++) {
-                if (node->x_columns_[col].strip_type_id_ == strip_type &&
-                    node->x_columns_[col].arc_set_.count(arc) > 0) {
-                    arc_flow += vars[num_y_cols + col];
-                }
-            }
-            IloRange arc_con(env, -IloInfinity, arc_flow, bound);
-            string con_name = "SP2_ub_" + to_string(strip_type) + "_" +
-                              to_string(arc[0]) + "_" + to_string(arc[1]);
-            arc_con.setName(con_name.c_str());
-            cons.add(arc_con);
-            model.add(arc_con);
-            sp2_arc_cons_info[strip_type].push_back({static_cast<int>(cons.getSize()) - 1, arc});
-            arc_flow.end();
+            add_arc_row(strip_type, arcs[i], -IloInfinity, bounds[i],
+                "SP2_ub_" + to_string(strip_type) + "_" + arc_suffix(arcs[i]));
         }
     }
 
@@ -346,41 +426,27 @@ bool SolveNodeInitMP(ProblemParams& params, ProblemData& data,
         const auto& arcs = kv.second;
         const auto& bounds = node->sp2_greater_bounds_.at(strip_type);
         for (size_t i = 0; i < arcs.size(); i++) {
-            const auto& arc = arcs[i];
-            int bound = bounds[i];
-            IloExpr arc_flow(env);
-            for (int col = 0; col < num_x_cols; col++) {
-                if (node->x_columns_[col].strip_type_id_ == strip_type &&
-                    node->x_columns_[col].arc_set_.count(arc) > 0) {
-                    arc_flow += vars[num_y_cols + col];
-                }
-            }
-            IloRange arc_con(env, bound, arc_flow, IloInfinity);
-            string con_name = "SP2_lb_" + to_string(strip_type) + "_" +
-                              to_string(arc[0]) + "_" + to_string(arc[1]);
-            arc_con.setName(con_name.c_str());
-            cons.add(arc_con);
-            model.add(arc_con);
-            sp2_arc_cons_info[strip_type].push_back({static_cast<int>(cons.getSize()) - 1, arc});
-            arc_flow.end();
+            add_arc_row(strip_type, arcs[i], bounds[i], IloInfinity,
+                "SP2_lb_" + to_string(strip_type) + "_" + arc_suffix(arcs[i]));
         }
     }
 
-    // 求解初始主问题
-    IloCplex cplex(env);
+    // 继承的秩1割行
+    node->cut_rows_.clear();
+    AddNodeCutRows(data, env, model, cons, vars, node, 0);
+
+    // 求解初始主问题 (分支约束行使父节点的基对偶可行, 按加行阶段设置参数)
     cplex.extract(model);
-    cplex.setOut(env.getNullStream());
-    bool feasible = cplex.solve();
+    bool feasible = SolveMasterLP(params, cplex, kCplexNodeRows);
 
     if (!feasible) {
         // 不可行: 分支约束过紧, 无法满足需求
         LOG("[MP] 初始主问题不可行");
-        cplex.end();
         return false;
     }
 
     double obj_val = cplex.getValue(obj);
-    LOG_FMT("[MP] 目标值: %.4f\n", obj_val);
+    LOG_DEBUG_FMT("[MP] 目标值: %.4f\n", obj_val);
 
     // 提取对偶价格, 用于子问题求解
     node->duals_.clear();
@@ -392,27 +458,18 @@ bool SolveNodeInitMP(ProblemParams& params, ProblemData& data,
 
     // 提取 Arc 约束的对偶价格 (数学模型 Section 9.5)
     // μ_a 用于修正子问题中弧的收益
-    node->sp1_arc_duals_.clear();
-    for (const auto& info : sp1_arc_cons_info) {
-        double dual = cplex.getDual(cons[info.first]);
-        if (dual == -0.0) dual = 0.0;
-        node->sp1_arc_duals_[info.second] = dual;
-        LOG_FMT("  SP1 Arc (%d,%d) dual=%.4f\n", info.second[0], info.second[1], dual);
-    }
-
-    node->sp2_arc_duals_.clear();
-    for (const auto& kv : sp2_arc_cons_info) {
-        int strip_type = kv.first;
-        for (const auto& info : kv.second) {
-            double dual = cplex.getDual(cons[info.first]);
-            if (dual == -0.0) dual = 0.0;
-            node->sp2_arc_duals_[strip_type][info.second] = dual;
-            LOG_FMT("  SP2[%d] Arc (%d,%d) dual=%.4f\n",
-                strip_type, info.second[0], info.second[1], dual);
+    ExtractNodeArcDuals(data, cplex, cons, node);
+    ExtractNodeCutDuals(cplex, cons, node);
+    for (const auto& con_row : node->arc_con_rows_) {
+        if (con_row.strip_type_ < 0) {
+            LOG_TRACE_FMT("  SP1 Arc (%d,%d) dual=%.4f\n",
+                con_row.arc_[0], con_row.arc_[1], con_row.dual_);
+        } else {
+            LOG_TRACE_FMT("  SP2[%d] Arc (%d,%d) dual=%.4f\n",
+                con_row.strip_type_, con_row.arc_[0], con_row.arc_[1], con_row.dual_);
         }
     }
 
-    cplex.end();
     return true;
 }
 
@@ -423,13 +480,17 @@ bool SolveNodeInitMP(ProblemParams& params, ProblemData& data,
 //   - 新列需要在 Arc 约束行中设置系数 (如果该列使用受约束的 Arc)
 // 返回值: true=更新后可行, false=不可行
 bool SolveNodeUpdateMP(ProblemParams& params, ProblemData& data,
-    IloEnv& env, IloModel& model, IloObjective& obj,
-    IloRangeArray& cons, IloNumVarArray& vars, BPNode* node) {
+    IloObjective& obj, IloRangeArray& cons, IloNumVarArray& vars,
+    IloCplex& cplex, BPNode* node) {
+    PROFILE_ZONE("rmp.node.update");
 
     int num_strip_types = params.num_strip_types_;
     int num_item_types = params.num_item_types_;
     int num_base_rows = num_strip_types + num_item_types;
 
+    // 有新列时按加列阶段求解, 否则为加割行后的重解
+    bool has_new_cols = !node->new_y_col_.pattern_.empty() || !node->new_x_col_.pattern_.empty();
+
     // 添加新Y列 (如果SP1找到改进列)
     if (!node->new_y_col_.pattern_.empty()) {
         IloNumColumn cplex_col = obj(1.0);
@@ -443,45 +504,29 @@ bool SolveNodeUpdateMP(ProblemParams& params, ProblemData& data,
             cplex_col += cons[num_strip_types + i](0);
         }
 
-        // Arc 约束系数: 如果新列使用受约束的 Arc, 系数为 1
-        // 需要遍历 cons 中 num_base_rows 之后的约束行
-        // 但由于我们不再直接修改子问题变量, 新生成的列如果使用禁用的 Arc
-        // 会在 Arc 约束行中产生系数, 从而影响解的可行性
-        // 这里新列的 arc_set_ 应该已经由子问题生成并存储
-        for (int row = num_base_rows; row < cons.getSize(); row++) {
-            // 通过约束名判断类型 (SP1_zero_, SP1_ub_, SP1_lb_)
-            string con_name = cons[row].getName();
-            if (con_name.find("SP1_") == 0) {
-                // 解析 arc 坐标 (格式: SP1_type_start_end)
-                // 检查新列是否使用此 arc
-                // 这里简化处理: 如果新列使用此 arc, 系数为 1
-                if (node->new_y_col_.arc_set_.size() > 0) {
-                    for (const auto& arc : node->new_y_col_.arc_set_) {
-                        string arc_suffix = "_" + to_string(arc[0]) + "_" + to_string(arc[1]);
-                        if (con_name.find(arc_suffix) != string::npos) {
-                            cplex_col += cons[row](1.0);
-                            break;
-                        }
-                    }
-                }
+        // Arc 约束系数: 如果新列使用受约束的 SP1 Arc, 系数为 1
+        // 先将子问题给出的 Arc 替换为规范 Arc 编号 (与列池 CSR 一致), 按记录的行号直接设置系数
+        vector<int>& y_arc_ids = node->new_y_col_.arc_ids_;
+        ComputeYColumnArcIds(data, node->new_y_col_.pattern_, y_arc_ids);
+        for (const auto& con_row : node->arc_con_rows_) {
+            if (con_row.strip_type_ < 0 &&
+                binary_search(y_arc_ids.begin(), y_arc_ids.end(), con_row.arc_idx_)) {
+                cplex_col += cons[con_row.row_](1.0);
             }
         }
 
-        int col_id = static_cast<int>(node->y_columns_.size()) + 1;
+        int col_id = data.y_columns_.num_cols_ + 1;
         string var_name = "Y_" + to_string(col_id);
         // 新列上界为无穷 (不受已有分支约束限制)
         IloNumVar var(cplex_col, 0, IloInfinity, ILOFLOAT, var_name.c_str());
         vars.add(var);
         cplex_col.end();
 
-        // 保存新列到列池
-        YColumn y_col;
-        y_col.pattern_ = node->new_y_col_.pattern_;
-        y_col.arc_set_ = node->new_y_col_.arc_set_;
-        y_col.var_index_ = static_cast<int>(vars.getSize()) - 1;
-        node->y_columns_.push_back(y_col);
+        // 保存新列到全局列池
+        int col = AppendColumn(data.y_columns_, node->new_y_col_.pattern_, -1, y_arc_ids);
+        data.y_columns_.var_indices_[col] = static_cast<int>(vars.getSize()) - 1;
         node->new_y_col_.pattern_.clear();
-        node->new_y_col_.arc_set_.clear();
+        node->new_y_col_.arc_ids_.clear();
     }
 
     // 添加新X列 (如果SP2找到改进列)
@@ -498,64 +543,48 @@ bool SolveNodeUpdateMP(ProblemParams& params, ProblemData& data,
             cplex_col += cons[num_strip_types + i](node->new_x_col_.pattern_[i]);
         }
 
-        // SP2 Arc 约束系数
-        for (int row = num_base_rows; row < cons.getSize(); row++) {
-            string con_name = cons[row].getName();
-            // 检查是否为此条带类型的 SP2 约束
-            string prefix = "SP2_";
-            if (con_name.find(prefix) == 0) {
-                // 解析条带类型 (格式: SP2_type_striptype_start_end)
-                size_t pos1 = con_name.find('_', prefix.size());
-                if (pos1 != string::npos) {
-                    size_t pos2 = con_name.find('_', pos1 + 1);
-                    if (pos2 != string::npos) {
-                        int con_strip_type = stoi(con_name.substr(pos1 + 1, pos2 - pos1 - 1));
-                        if (con_strip_type == strip_type && node->new_x_col_.arc_set_.size() > 0) {
-                            for (const auto& arc : node->new_x_col_.arc_set_) {
-                                string arc_suffix = "_" + to_string(arc[0]) + "_" + to_string(arc[1]);
-                                if (con_name.find(arc_suffix) != string::npos) {
-                                    cplex_col += cons[row](1.0);
-                                    break;
-                                }
-                            }
-                        }
-                    }
-                }
+        // SP2 Arc 约束系数: 只对同一条带类型的 Arc 行生效
+        vector<int>& x_arc_ids = node->new_x_col_.arc_ids_;
+        ComputeXColumnArcIds(data, node->new_x_col_.pattern_, strip_type, x_arc_ids);
+        for (const auto& con_row : node->arc_con_rows_) {
+            if (con_row.strip_type_ == strip_type &&
+                binary_search(x_arc_ids.begin(), x_arc_ids.end(), con_row.arc_idx_)) {
+                cplex_col += cons[con_row.row_](1.0);
             }
         }
 
-        int col_id = static_cast<int>(node->x_columns_.size()) + 1;
+        // 割行系数 ceil(Σ_{i∈S} a_i / q)
+        for (const auto& cut_row : node->cut_rows_) {
+            int coef = CutPatternCoef(data.cut_pool_[cut_row.cut_id_], node->new_x_col_.pattern_);
+            if (coef > 0) cplex_col += cons[cut_row.row_](coef);
+        }
+
+        int col_id = data.x_columns_.num_cols_ + 1;
         string var_name = "X_" + to_string(col_id);
         IloNumVar var(cplex_col, 0, IloInfinity, ILOFLOAT, var_name.c_str());
         vars.add(var);
         cplex_col.end();
 
-        // 保存新列到列池
-        XColumn x_col;
-        x_col.strip_type_id_ = strip_type;
-        x_col.pattern_ = node->new_x_col_.pattern_;
-        x_col.arc_set_ = node->new_x_col_.arc_set_;
-        x_col.var_index_ = static_cast<int>(vars.getSize()) - 1;
-        node->x_columns_.push_back(x_col);
+        // 保存新列到全局列池
+        int col = AppendColumn(data.x_columns_, node->new_x_col_.pattern_, strip_type, x_arc_ids);
+        data.x_columns_.var_indices_[col] = static_cast<int>(vars.getSize()) - 1;
         node->new_x_col_.pattern_.clear();
-        node->new_x_col_.arc_set_.clear();
+        node->new_x_col_.arc_ids_.clear();
     }
 
     // 求解更新后的主问题
-    LOG_FMT("[MP-%d] 更新并求解主问题\n", node->iter_);
-    IloCplex cplex(env);
-    cplex.extract(model);
-    cplex.setOut(env.getNullStream());
-    bool feasible = cplex.solve();
+    // 模型修改已同步到 cplex, 直接从上一次的基热启动
+    LOG_DEBUG_FMT("[MP-%d] 更新并求解主问题\n", node->iter_);
+    bool feasible = SolveMasterLP(params, cplex,
+        has_new_cols ? kCplexNodeColumns : kCplexNodeRows);
 
     if (!feasible) {
         LOG("[MP] 更新后主问题不可行");
-        cplex.end();
         return false;
     }
 
     double obj_val = cplex.getValue(obj);
-    LOG_FMT("[MP] 目标值: %.4f\n", obj_val);
+    LOG_DEBUG_FMT("[MP] 目标值: %.4f\n", obj_val);
 
     // 提取新的对偶价格 (基本约束)
     node->duals_.clear();
@@ -565,42 +594,10 @@ bool SolveNodeUpdateMP(ProblemParams& params, ProblemData& data,
         node->duals_.push_back(dual);
     }
 
-    // 更新 Arc 约束对偶价格
-    node->sp1_arc_duals_.clear();
-    node->sp2_arc_duals_.clear();
-    for (int row = num_base_rows; row < cons.getSize(); row++) {
-        string con_name = cons[row].getName();
-        double dual = cplex.getDual(cons[row]);
-        if (dual == -0.0) dual = 0.0;
-
-        if (con_name.find("SP1_") == 0) {
-            // 解析 SP1 arc 约束
-            // 格式: SP1_type_start_end
-            size_t pos1 = con_name.rfind('_');
-            size_t pos2 = con_name.rfind('_', pos1 - 1);
-            if (pos1 != string::npos && pos2 != string::npos) {
-                int arc_end = stoi(con_name.substr(pos1 + 1));
-                int arc_start = stoi(con_name.substr(pos2 + 1, pos1 - pos2 - 1));
-                array<int, 2> arc = {arc_start, arc_end};
-                node->sp1_arc_duals_[arc] = dual;
-            }
-        } else if (con_name.find("SP2_") == 0) {
-            // 解析 SP2 arc 约束
-            // 格式: SP2_type_striptype_start_end
-            size_t pos1 = con_name.rfind('_');
-            size_t pos2 = con_name.rfind('_', pos1 - 1);
-            size_t pos3 = con_name.rfind('_', pos2 - 1);
-            if (pos1 != string::npos && pos2 != string::npos && pos3 != string::npos) {
-                int arc_end = stoi(con_name.substr(pos1 + 1));
-                int arc_start = stoi(con_name.substr(pos2 + 1, pos1 - pos2 - 1));
-                int strip_type = stoi(con_name.substr(pos3 + 1, pos2 - pos3 - 1));
-                array<int, 2> arc = {arc_start, arc_end};
-                node->sp2_arc_duals_[strip_type][arc] = dual;
-            }
-        }
-    }
+    // 更新 Arc 约束与割行对偶价格
+    ExtractNodeArcDuals(data, cplex, cons, node);
+    ExtractNodeCutDuals(cplex, cons, node);
 
-    cplex.end();
     return true;
 }
 
@@ -612,20 +609,18 @@ bool SolveNodeUpdateMP(ProblemParams& params, ProblemData& data,
 //   - node->prune_flag_: 若不可行则设为1
 // 返回值: true=可行, false=不可行
 bool SolveNodeFinalMP(ProblemParams& params, ProblemData& data,
-    IloEnv& env, IloModel& model, IloObjective& obj,
-    IloRangeArray& cons, IloNumVarArray& vars, BPNode* node) {
+    IloObjective& obj, IloRangeArray& cons, IloNumVarArray& vars,
+    IloCplex& cplex, BPNode* node) {
+    PROFILE_ZONE("rmp.node.final");
 
     LOG_FMT("[MP-Final] 节点%d 求解最终主问题\n", node->id_);
 
-    IloCplex cplex(env);
-    cplex.extract(model);
-    cplex.setOut(env.getNullStream());
-    bool feasible = cplex.solve();
+    // 模型自上一次求解后未改变时, 热启动直接得到最优基
+    bool feasible = SolveMasterLP(params, cplex, kCplexNodeColumns);
 
     if (!feasible) {
         LOG("[MP] 最终主问题不可行");
         node->prune_flag_ = 1;  // 标记节点被剪枝
-        cplex.end();
         return false;
     }
 
@@ -636,29 +631,9 @@ bool SolveNodeFinalMP(ProblemParams& params, ProblemData& data,
 
     LOG_FMT("[MP] 最终目标值: %.4f\n", obj_val);
 
-    // 提取Y列的解值
-    node->solution_.y_columns_.clear();
-    for (int col = 0; col < (int)node->y_columns_.size(); col++) {
-        double val = cplex.getValue(vars[col]);
-        if (fabs(val) < kZeroTolerance) val = 0;  // 处理数值误差
-
-        YColumn y_col = node->y_columns_[col];
-        y_col.value_ = val;
-        node->solution_.y_columns_.push_back(y_col);
-    }
-
-    // 提取X列的解值
-    node->solution_.x_columns_.clear();
-    int y_count = static_cast<int>(node->y_columns_.size());
-    for (int col = 0; col < static_cast<int>(node->x_columns_.size()); col++) {
-        double val = cplex.getValue(vars[y_count + col]);
-        if (fabs(val) < kZeroTolerance) val = 0;
+    // 提取各列的解值 (按 var_indices_ 访问, 新列与老列交错时也正确)
+    ExtractColumnValues(cplex, vars, data.y_columns_, node->solution_.y_cols_);
+    ExtractColumnValues(cplex, vars, data.x_columns_, node->solution_.x_cols_);
 
-        XColumn x_col = node->x_columns_[col];
-        x_col.value_ = val;
-        node->solution_.x_columns_.push_back(x_col);
-    }
-
-    cplex.end();
     return true;
 }
@@ -18,85 +18,352 @@
 
 using namespace std;
 
-// 非根节点SP1子问题: 宽度方向背包问题 - CPLEX整数规划求解
-// 功能: 为分支节点寻找能改进主问题目标值的新Y列
-// 与根节点版本相同的数学模型:
-//   max sum_{j} v_j * G_j  s.t. sum_{j} w_j * G_j <= W
-// 注意: 背包模型不包含Arc约束, 因此只适用于无Arc约束的情况
-// 返回值: true=列生成收敛, false=找到改进列
-bool SolveNodeSP1Knapsack(ProblemParams& params, ProblemData& data, BPNode* node) {
-    IloEnv env;
-    IloModel model(env);
-    IloNumVarArray vars(env);
-    int num_strip_types = params.num_strip_types_;
+// 持久化的 CPLEX 子问题模型
+// 首次定价时按网络建模并 extract, 之后每次定价只修改与当前值不同的目标系数、变量上界和行上界,
+// 由 IloCplex 增量同步; 深度优先下潜时相邻节点只差一条分支约束, 切换节点几乎不改动模型
+struct PricingModel {
+    IloEnv env_;
+    IloModel model_;
+    IloNumVarArray vars_;
+    IloObjective obj_;
+    IloRangeArray rows_;                // 随条带类型变化上界的行 (SP2 Arc Flow 数量上界)
+    IloCplex cplex_;
+
+    vector<double> coefs_;              // 当前目标系数
+    vector<double> var_ubs_;            // 当前变量上界
+    vector<double> row_ubs_;            // 当前 rows_ 上界
+    vector<int> row_kinds_;             // rows_ 对应的长度种类 (SP2 Arc Flow)
+
+    PricingModel() : model_(env_), vars_(env_), obj_(IloMaximize(env_)),
+                     rows_(env_), cplex_(env_) {
+        model_.add(obj_);
+        cplex_.setOut(env_.getNullStream());  // 关闭CPLEX输出
+    }
+    ~PricingModel() { env_.end(); }
+    PricingModel(const PricingModel&) = delete;
+    PricingModel& operator=(const PricingModel&) = delete;
+};
+
+// 非根节点定价工作区 (每个线程一份)
+// 持久化模型、当前节点禁用 Arc 的编号、DP 数组与目标系数 / 上界缓冲区都跨调用复用
+struct PricingWorkspace {
+    unique_ptr<PricingModel> sp1_knapsack_;
+    unique_ptr<PricingModel> sp1_arc_flow_;
+    unique_ptr<PricingModel> sp2_knapsack_;
+    unique_ptr<PricingModel> sp2_arc_flow_;
+
+    // 禁用 Arc 编号 (升序), 按节点编号缓存, 同一节点的多次定价只转换一次
+    int zero_node_id_ = -1;
+    vector<int> sp1_zero_ids_;
+    map<int, vector<int>> sp2_zero_ids_;        // 按条带类型
+
+    vector<double> coefs_;
+    vector<double> ubs_;
+    vector<int> arc_items_;
+    vector<double> dp_;
+    vector<vector<int>> choice_;
+};
+
+static PricingWorkspace& GetPricingWorkspace() {
+    thread_local PricingWorkspace ws;
+    return ws;
+}
 
-    // 构建目标函数: max sum(v_j * G_j)
-    // v_j: 条带平衡约束的对偶价格, 反映条带j的边际价值
-    IloExpr obj_expr(env);
-    for (int j = 0; j < num_strip_types; j++) {
-        string var_name = "G_" + to_string(j + 1);
-        IloNumVar var(env, 0, IloInfinity, ILOINT, var_name.c_str());
-        vars.add(var);
+// 当前节点禁用 Arc 的编号; 节点未变时直接复用上次的转换结果
+static void RefreshZeroArcIds(PricingWorkspace& ws, ProblemData& data, BPNode* node) {
+    if (ws.zero_node_id_ == node->id_) return;
+    ws.zero_node_id_ = node->id_;
+
+    const SP1ArcFlowData& sp1_data = data.sp1_arc_data_;
+    ws.sp1_zero_ids_.clear();
+    for (const auto& arc : node->sp1_zero_arcs_) {
+        auto it = sp1_data.arc_to_index_.find(arc);
+        if (it != sp1_data.arc_to_index_.end()) ws.sp1_zero_ids_.push_back(it->second);
+    }
+    sort(ws.sp1_zero_ids_.begin(), ws.sp1_zero_ids_.end());
+
+    ws.sp2_zero_ids_.clear();
+    for (const auto& [strip_type, arcs] : node->sp2_zero_arcs_) {
+        vector<int>& ids = ws.sp2_zero_ids_[strip_type];
+        for (const auto& arc : arcs) {
+            int id = GetSP2ArcId(data.sp2_arc_data_, arc);
+            if (id >= 0) ids.push_back(id);
+        }
+        sort(ids.begin(), ids.end());
+    }
+}
+
+static const vector<int>& SP2ZeroArcIds(const PricingWorkspace& ws, int strip_type_id) {
+    static const vector<int> kNone;
+    auto it = ws.sp2_zero_ids_.find(strip_type_id);
+    return it != ws.sp2_zero_ids_.end() ? it->second : kNone;
+}
+
+// 只修改与当前值不同的目标系数 (批量 setLinearCoefs)
+static void UpdateObjective(PricingModel& model, const vector<double>& coefs) {
+    IloNumVarArray changed_vars(model.env_);
+    IloNumArray changed_coefs(model.env_);
+    for (size_t i = 0; i < coefs.size(); i++) {
+        if (coefs[i] != model.coefs_[i]) {
+            changed_vars.add(model.vars_[i]);
+            changed_coefs.add(coefs[i]);
+            model.coefs_[i] = coefs[i];
+        }
+    }
+    if (changed_vars.getSize() > 0) {
+        model.obj_.setLinearCoefs(changed_vars, changed_coefs);
+    }
+    changed_vars.end();
+    changed_coefs.end();
+}
+
+// 只修改与当前值不同的变量上界
+static void UpdateVarBounds(PricingModel& model, const vector<double>& ubs) {
+    for (size_t i = 0; i < ubs.size(); i++) {
+        if (ubs[i] != model.var_ubs_[i]) {
+            model.vars_[i].setUB(ubs[i]);
+            model.var_ubs_[i] = ubs[i];
+        }
+    }
+}
+
+// 读取解向量并取整 (处理0.99999这类数值误差)
+static void ExtractIntValues(PricingModel& model, vector<int>& values) {
+    IloNumArray vals(model.env_);
+    model.cplex_.getValues(vals, model.vars_);
+    values.resize(vals.getSize());
+    for (IloInt i = 0; i < vals.getSize(); i++) {
+        values[i] = static_cast<int>(vals[i] + 0.5);
+    }
+    vals.end();
+}
+
+// 建立 Arc Flow 网络的流量守恒约束: 起点流出 = 1, 终点流入 = 1, 中间节点流入 = 流出
+template <typename ArcData>
+static void AddFlowConservation(PricingModel& model, const ArcData& arc_data) {
+    IloEnv env = model.env_;
+    IloNumVarArray& vars = model.vars_;
+
+    IloExpr begin_expr(env);
+    for (int idx : arc_data.begin_arc_indices_) {
+        begin_expr += vars[idx];
+    }
+    model.model_.add(begin_expr == 1);
+    begin_expr.end();
+
+    IloExpr end_expr(env);
+    for (int idx : arc_data.end_arc_indices_) {
+        end_expr += vars[idx];
+    }
+    model.model_.add(end_expr == 1);
+    end_expr.end();
 
-        double dual = node->duals_[j];  // 指针访问
-        if (dual != 0.0) {              // 跳过零系数项
-            obj_expr += vars[j] * dual;
+    int num_mid = static_cast<int>(arc_data.mid_nodes_.size());
+    for (int i = 0; i < num_mid; i++) {
+        IloExpr in_expr(env);
+        IloExpr out_expr(env);
+        for (int idx : arc_data.mid_in_arcs_[i]) {
+            in_expr += vars[idx];
+        }
+        for (int idx : arc_data.mid_out_arcs_[i]) {
+            out_expr += vars[idx];
         }
+        model.model_.add(in_expr == out_expr);
+        in_expr.end();
+        out_expr.end();
     }
+}
 
-    IloObjective obj = IloMaximize(env, obj_expr);
-    model.add(obj);
+// 建立 SP1 背包模型: max sum(v_j * G_j) s.t. sum(w_j * G_j) <= W (目标系数每次定价写入)
+static unique_ptr<PricingModel> BuildSP1KnapsackModel(ProblemParams& params, ProblemData& data) {
+    auto model = make_unique<PricingModel>();
+    IloEnv env = model->env_;
+    int num_strip_types = params.num_strip_types_;
 
-    // 宽度约束: sum(w_j * G_j) <= W
-    // 条带宽度总和不能超过母板宽度
     IloExpr wid_expr(env);
     for (int j = 0; j < num_strip_types; j++) {
-        wid_expr += data.strip_types_[j].width_ * vars[j];
+        string var_name = "G_" + to_string(j + 1);
+        IloNumVar var(env, 0, data.strip_max_per_plate_[j], ILOINT, var_name.c_str());
+        model->vars_.add(var);
+        model->var_ubs_.push_back(data.strip_max_per_plate_[j]);
+        wid_expr += data.strip_types_[j].width_ * var;
     }
-    model.add(wid_expr <= params.stock_width_);
+    model->model_.add(wid_expr <= params.stock_width_);
     wid_expr.end();
 
+    model->coefs_.assign(num_strip_types, 0.0);
+    model->cplex_.extract(model->model_);
+    ApplyCplexProfile(model->cplex_, params.cplex_profiles_[kCplexPricing]);
+    return model;
+}
+
+// 建立 SP1 Arc Flow 模型: 每个Arc一个0-1变量, 宽度约束、数量上界与流量守恒 (与节点无关)
+static unique_ptr<PricingModel> BuildSP1ArcFlowModel(ProblemParams& params, ProblemData& data) {
+    auto model = make_unique<PricingModel>();
+    IloEnv env = model->env_;
+    const SP1ArcFlowData& arc_data = data.sp1_arc_data_;
+    int num_arcs = static_cast<int>(arc_data.arc_list_.size());
+    int num_strip_types = params.num_strip_types_;
+
+    for (int i = 0; i < num_arcs; i++) {
+        string var_name = "a_" + to_string(i + 1);
+        model->vars_.add(IloNumVar(env, 0, 1, ILOINT, var_name.c_str()));
+    }
+    IloNumVarArray& vars = model->vars_;
+
+    // 宽度约束: 选中Arc总长度不超过母板宽度 (冗余约束, 可加速求解)
+    IloExpr wid_expr(env);
+    for (int i = 0; i < num_arcs; i++) {
+        int arc_width = arc_data.arc_list_[i][1] - arc_data.arc_list_[i][0];
+        wid_expr += arc_width * vars[i];
+    }
+    model->model_.add(wid_expr <= params.stock_width_);
+    wid_expr.end();
+
+    // 数量上界: j 型条带弧的流量之和不超过 strip_max_per_plate_[j] (比容量更紧时才添加)
+    for (int j = 0; j < num_strip_types; j++) {
+        if (data.strip_max_per_plate_[j] >= params.stock_width_ / data.strip_types_[j].width_) {
+            continue;
+        }
+        IloExpr cnt_expr(env);
+        for (int i = 0; i < num_arcs; i++) {
+            if (arc_data.arc_strip_index_[i] == j) cnt_expr += vars[i];
+        }
+        model->model_.add(cnt_expr <= data.strip_max_per_plate_[j]);
+        cnt_expr.end();
+    }
+
+    AddFlowConservation(*model, arc_data);
+
+    model->coefs_.assign(num_arcs, 0.0);
+    model->var_ubs_.assign(num_arcs, 1.0);
+    model->cplex_.extract(model->model_);
+    ApplyCplexProfile(model->cplex_, params.cplex_profiles_[kCplexPricing]);
+    return model;
+}
+
+// 建立 SP2 背包模型: 全部子板各一个变量, 放不下当前条带的子板上界在定价时置0
+static unique_ptr<PricingModel> BuildSP2KnapsackModel(ProblemParams& params, ProblemData& data) {
+    auto model = make_unique<PricingModel>();
+    IloEnv env = model->env_;
+    int num_item_types = params.num_item_types_;
+
+    IloExpr len_expr(env);
+    for (int i = 0; i < num_item_types; i++) {
+        string var_name = "D_" + to_string(i + 1);
+        IloNumVar var(env, 0, data.item_max_per_strip_[i], ILOINT, var_name.c_str());
+        model->vars_.add(var);
+        model->var_ubs_.push_back(data.item_max_per_strip_[i]);
+        len_expr += data.item_types_[i].length_ * var;
+    }
+    model->model_.add(len_expr <= params.stock_length_);
+    len_expr.end();
+
+    model->coefs_.assign(num_item_types, 0.0);
+    model->cplex_.extract(model->model_);
+    ApplyCplexProfile(model->cplex_, params.cplex_profiles_[kCplexPricing]);
+    return model;
+}
+
+// 建立 SP2 Arc Flow 模型 (各条带类型共享)
+// 数量上界按长度种类建行: 条带类型 j 上长度种类 d 对应子板 length_items_[d],
+// 其上界 item_max_per_strip_ 比容量更紧时写入行上界, 否则为无穷
+static unique_ptr<PricingModel> BuildSP2ArcFlowModel(ProblemParams& params, ProblemData& data) {
+    auto model = make_unique<PricingModel>();
+    IloEnv env = model->env_;
+    const SP2ArcFlowData& arc_data = data.sp2_arc_data_;
+    int num_arcs = static_cast<int>(arc_data.arc_list_.size());
+    int num_kinds = static_cast<int>(arc_data.lengths_.size());
+
+    for (int i = 0; i < num_arcs; i++) {
+        string var_name = "a_" + to_string(i + 1);
+        model->vars_.add(IloNumVar(env, 0, 1, ILOINT, var_name.c_str()));
+    }
+    IloNumVarArray& vars = model->vars_;
+
+    // 长度约束: 选中Arc总长度不超过条带长度 (冗余约束)
+    IloExpr len_expr(env);
+    for (int i = 0; i < num_arcs; i++) {
+        int arc_len = arc_data.arc_list_[i][1] - arc_data.arc_list_[i][0];
+        len_expr += arc_len * vars[i];
+    }
+    model->model_.add(len_expr <= params.stock_length_);
+    len_expr.end();
+
+    // 只为可能出现更紧上界的长度种类建行
+    for (int d = 0; d < num_kinds; d++) {
+        bool needed = false;
+        for (const auto& strip_data : data.sp2_strip_data_) {
+            int item = strip_data.length_items_[d];
+            if (item >= 0 && data.item_max_per_strip_[item] <
+                params.stock_length_ / data.item_types_[item].length_) {
+                needed = true;
+                break;
+            }
+        }
+        if (!needed) continue;
+
+        IloExpr cnt_expr(env);
+        for (int i = 0; i < num_arcs; i++) {
+            if (arc_data.arc_length_index_[i] == d) cnt_expr += vars[i];
+        }
+        IloRange row(env, -IloInfinity, cnt_expr, IloInfinity);
+        cnt_expr.end();
+        model->model_.add(row);
+        model->rows_.add(row);
+        model->row_kinds_.push_back(d);
+        model->row_ubs_.push_back(IloInfinity);
+    }
+
+    AddFlowConservation(*model, arc_data);
+
+    model->coefs_.assign(num_arcs, 0.0);
+    model->var_ubs_.assign(num_arcs, 1.0);
+    model->cplex_.extract(model->model_);
+    ApplyCplexProfile(model->cplex_, params.cplex_profiles_[kCplexPricing]);
+    return model;
+}
+
+// 非根节点SP1子问题: 宽度方向背包问题 - CPLEX整数规划求解
+// 功能: 为分支节点寻找能改进主问题目标值的新Y列
+// 与根节点版本相同的数学模型:
+//   max sum_{j} v_j * G_j  s.t. sum_{j} w_j * G_j <= W
+// 注意: 背包模型不包含Arc约束, 因此只适用于无Arc约束的情况
+// 模型只建一次, 每次定价只改目标系数
+// 返回值: true=列生成收敛, false=找到改进列
+bool SolveNodeSP1Knapsack(ProblemParams& params, ProblemData& data, BPNode* node) {
+    PricingWorkspace& ws = GetPricingWorkspace();
+    if (!ws.sp1_knapsack_) ws.sp1_knapsack_ = BuildSP1KnapsackModel(params, data);
+    PricingModel& model = *ws.sp1_knapsack_;
+    int num_strip_types = params.num_strip_types_;
+
+    // 目标函数: max sum(v_j * G_j)
+    // v_j: 条带平衡约束的对偶价格, 反映条带j的边际价值
+    ws.coefs_.assign(node->duals_.begin(), node->duals_.begin() + num_strip_types);
+    UpdateObjective(model, ws.coefs_);
+
     // 求解背包问题
-    LOG_FMT("[SP1-%d] 节点%d 求解SP1 (背包)\n", node->iter_, node->id_);
-    IloCplex cplex(env);
-    cplex.extract(model);
-    cplex.setOut(env.getNullStream());  // 关闭CPLEX输出
-    bool feasible = cplex.solve();
+    LOG_DEBUG_FMT("[SP1-%d] 节点%d 求解SP1 (背包)\n", node->iter_, node->id_);
+    bool feasible = model.cplex_.solve();
 
     bool cg_converged = true;  // 默认假设收敛
 
     if (feasible) {
-        double rc = cplex.getObjValue();  // reduced cost
-        LOG_FMT("  [SP1] Reduced Cost: %.4f\n", rc);
-
-        // 提取解向量, 构建新Y列的pattern
-        node->new_y_col_.pattern_.clear();
-        for (int j = 0; j < num_strip_types; j++) {
-            double val = cplex.getValue(vars[j]);
-            // 浮点取整: 处理0.99999这类数值误差
-            int int_val = (val - (int)val > 0.99999) ? (int)val + 1 : (int)val;
-            node->new_y_col_.pattern_.push_back(int_val);
-        }
+        double rc = model.cplex_.getObjValue();  // reduced cost
+        node->price_value_ = rc;
+        LOG_TRACE_FMT("  [SP1] Reduced Cost: %.4f\n", rc);
 
         // 判断是否找到改进列: rc > 1 表示该列能改进目标
         if (rc > 1 + kRcTolerance) {
             cg_converged = false;  // 找到改进列, 继续迭代
-            LOG("  [SP1] 找到改进列");
+            ExtractIntValues(model, node->new_y_col_.pattern_);
+            LOG_DEBUG("  [SP1] 找到改进列");
         } else {
-            cg_converged = true;   // 无改进列, 收敛
             node->new_y_col_.pattern_.clear();
-            LOG("  [SP1] 收敛");
+            LOG_DEBUG("  [SP1] 收敛");
         }
     }
 
-    // 释放CPLEX资源
-    obj_expr.end();
-    obj.end();
-    vars.end();
-    cplex.end();
-    model.end();
-    env.end();
-
     return cg_converged;
 }
 
@@ -105,11 +372,15 @@ bool SolveNodeSP1Knapsack(ProblemParams& params, ProblemData& data, BPNode* node
 // Arc Flow优势:
 //   - 可在子问题中施加Arc约束, 保证分支切割的有效性
 // Arc约束处理 (数学模型 Section 9.5):
-//   - 零弧约束: 直接禁用该Arc (setUB(0))
+//   - 零弧约束: 直接禁用该Arc (上界为0)
 //   - 非零约束: 使用对偶价格 μ_a 修正弧收益: v_j → v_j + μ_a
 //   - 对偶价格来自RMP中的Arc行约束
+// 网络模型只建一次; 每次定价只改变化的目标系数, 切换节点时只改禁用Arc变化部分的上界
 // 返回值: true=列生成收敛, false=找到改进列
 bool SolveNodeSP1ArcFlow(ProblemParams& params, ProblemData& data, BPNode* node) {
+    // 建模计时起点
+    auto build_start = chrono::steady_clock::now();
+
     SP1ArcFlowData& arc_data = data.sp1_arc_data_;
     int num_arcs = static_cast<int>(arc_data.arc_list_.size());
     int num_strip_types = params.num_strip_types_;
@@ -119,112 +390,64 @@ bool SolveNodeSP1ArcFlow(ProblemParams& params, ProblemData& data, BPNode* node)
         return true;
     }
 
-    IloEnv env;
-    IloModel model(env);
-    IloNumVarArray vars(env);
+    PricingWorkspace& ws = GetPricingWorkspace();
+    if (!ws.sp1_arc_flow_) ws.sp1_arc_flow_ = BuildSP1ArcFlowModel(params, data);
+    PricingModel& model = *ws.sp1_arc_flow_;
 
-    // 为每个Arc创建0-1整数变量
     // 目标函数: max sum((v_j + μ_a) * a_i)
     // 物品弧: v_j为Arc对应条带的对偶价格, μ_a为Arc约束对偶价格
     // 损耗弧: 收益为0 (符合数学模型 Section 7.3)
-    IloExpr obj_expr(env);
+    vector<double>& coefs = ws.coefs_;
+    coefs.assign(num_arcs, 0.0);
     for (int i = 0; i < num_arcs; i++) {
-        string var_name = "a_" + to_string(i + 1);
-        IloNumVar var(env, 0, 1, ILOINT, var_name.c_str());
-        vars.add(var);
-
-        // Arc长度对应条带宽度, 映射到对偶价格
-        const auto& arc = arc_data.arc_list_[i];
-        int arc_width = arc[1] - arc[0];
-
         // 基础收益: 物品弧为 v_j, 损耗弧为 0
         double profit = 0.0;
-        if (data.width_to_strip_index_.count(arc_width) > 0) {
-            int strip_idx = data.width_to_strip_index_.at(arc_width);
+        int strip_idx = arc_data.arc_strip_index_[i];
+        if (strip_idx >= 0) {
             profit = node->duals_[strip_idx];
         }
 
         // 添加 Arc 约束对偶价格修正 (数学模型 Section 9.5)
-        // μ_a 来自 RMP 中 Arc 行约束的对偶价格
-        if (node->sp1_arc_duals_.count(arc) > 0) {
-            double mu_a = node->sp1_arc_duals_.at(arc);
+        // μ_a 来自 RMP 中 Arc 行约束的对偶价格, 已按Arc编号写入 arc_duals_
+        double mu_a = arc_data.arc_duals_[i];
+        if (mu_a != 0.0) {
             profit += mu_a;
-            LOG_FMT("  SP1 Arc (%d,%d): profit %.4f + mu %.4f = %.4f\n",
+            const auto& arc = arc_data.arc_list_[i];
+            LOG_TRACE_FMT("  SP1 Arc (%d,%d): profit %.4f + mu %.4f = %.4f\n",
                 arc[0], arc[1], profit - mu_a, mu_a, profit);
         }
 
         if (fabs(profit) > kZeroTolerance) {
-            obj_expr += vars[i] * profit;
+            coefs[i] = profit;
         }
     }
+    UpdateObjective(model, coefs);
 
-    IloObjective obj = IloMaximize(env, obj_expr);
-    model.add(obj);
-
-    // 宽度约束: 选中Arc总长度不超过母板宽度 (冗余约束, 可加速求解)
-    IloExpr wid_expr(env);
-    for (int i = 0; i < num_arcs; i++) {
-        int arc_width = arc_data.arc_list_[i][1] - arc_data.arc_list_[i][0];
-        wid_expr += arc_width * vars[i];
-    }
-    model.add(wid_expr <= params.stock_width_);
-    wid_expr.end();
-
-    // 起点约束: 从节点0出发的流量 = 1
-    IloExpr begin_expr(env);
-    for (int idx : arc_data.begin_arc_indices_) {
-        begin_expr += vars[idx];
-    }
-    model.add(begin_expr == 1);
-    begin_expr.end();
-
-    // 终点约束: 进入终点节点的流量 = 1
-    IloExpr end_expr(env);
-    for (int idx : arc_data.end_arc_indices_) {
-        end_expr += vars[idx];
-    }
-    model.add(end_expr == 1);
-    end_expr.end();
-
-    // 中间节点流量守恒: 流入量 = 流出量
-    int num_mid = static_cast<int>(arc_data.mid_nodes_.size());
-    for (int i = 0; i < num_mid; i++) {
-        IloExpr in_expr(env);
-        IloExpr out_expr(env);
-        for (int idx : arc_data.mid_in_arcs_[i]) {
-            in_expr += vars[idx];
-        }
-        for (int idx : arc_data.mid_out_arcs_[i]) {
-            out_expr += vars[idx];
-        }
-        model.add(in_expr == out_expr);
-        in_expr.end();
-        out_expr.end();
-    }
-
-    // 禁用Arc约束: 设置上界为0, 完全禁止使用该Arc
+    // 禁用Arc约束: 上界为0, 完全禁止使用该Arc
     // 这是零弧分支的正确处理: 子问题不生成使用该Arc的新pattern
-    for (const auto& arc : node->sp1_zero_arcs_) {
-        if (arc_data.arc_to_index_.count(arc)) {
-            int idx = arc_data.arc_to_index_.at(arc);
-            vars[idx].setUB(0);  // 禁用该Arc
-        }
-    }
+    RefreshZeroArcIds(ws, data, node);
+    vector<double>& ubs = ws.ubs_;
+    ubs.assign(num_arcs, 1.0);
+    for (int idx : ws.sp1_zero_ids_) ubs[idx] = 0.0;
+    UpdateVarBounds(model, ubs);
 
     // 注意: 非零Arc约束 (sp1_lower_arcs_, sp1_greater_arcs_) 不再在此处处理
     // 它们已作为RMP行约束, 通过对偶价格 μ_a 影响子问题目标函数
 
+    // 建模耗时 (不含CPLEX求解)
+    double build_ms = chrono::duration<double, milli>(
+        chrono::steady_clock::now() - build_start).count();
+
     // 求解Arc Flow子问题
-    LOG_FMT("[SP1-%d] 节点%d 求解SP1 (Arc Flow)\n", node->iter_, node->id_);
-    IloCplex cplex(env);
-    cplex.extract(model);
-    cplex.setOut(env.getNullStream());
-    bool feasible = cplex.solve();
+    LOG_DEBUG_FMT("[SP1-%d] 节点%d 求解SP1 (Arc Flow)\n", node->iter_, node->id_);
+    bool feasible = model.cplex_.solve();
+    LOG_TRACE_FMT("  [SP1] 建模耗时: %.3f ms\n", build_ms);
 
     bool cg_converged = true;
 
     if (feasible) {
-        double rc = cplex.getObjValue();
+        double rc = model.cplex_.getObjValue();
+        node->price_value_ = rc;
 
         // 判断是否找到改进列
         if (rc > 1 + kRcTolerance) {
@@ -232,40 +455,31 @@ bool SolveNodeSP1ArcFlow(ProblemParams& params, ProblemData& data, BPNode* node)
 
             // 根据选中的Arc构建切割模式
             // 只计物品弧, 不计损耗弧
+            vector<int> selected;
+            ExtractIntValues(model, selected);
             vector<int> pattern(num_strip_types, 0);
-            set<array<int, 2>> selected_arcs;  // 记录选中的Arc用于约束系数
+            vector<int> selected_arcs;  // 记录选中的Arc用于约束系数 (Arc编号, 升序)
             for (int i = 0; i < num_arcs; i++) {
-                double val = cplex.getValue(vars[i]);
-                if (val > 0.5) {  // Arc被选中
-                    const auto& arc = arc_data.arc_list_[i];
-                    selected_arcs.insert(arc);
-                    int arc_width = arc[1] - arc[0];
+                if (selected[i] > 0) {  // Arc被选中
+                    selected_arcs.push_back(i);
                     // 只统计物品弧
-                    if (data.width_to_strip_index_.count(arc_width) > 0) {
-                        int strip_idx = data.width_to_strip_index_.at(arc_width);
+                    int strip_idx = arc_data.arc_strip_index_[i];
+                    if (strip_idx >= 0) {
                         pattern[strip_idx]++;
                     }
                     // else: 损耗弧, 不计入pattern
                 }
             }
             node->new_y_col_.pattern_ = pattern;
-            node->new_y_col_.arc_set_ = selected_arcs;
-            LOG("  [SP1] 找到改进列");
+            node->new_y_col_.arc_ids_ = selected_arcs;
+            LOG_DEBUG("  [SP1] 找到改进列");
         } else {
-            LOG("  [SP1] 收敛");
+            LOG_DEBUG("  [SP1] 收敛");
         }
     } else {
-        LOG("  [SP1] 子问题不可行");
+        LOG_DEBUG("  [SP1] 子问题不可行");
     }
 
-    // 释放CPLEX资源
-    obj_expr.end();
-    obj.end();
-    vars.end();
-    cplex.end();
-    model.end();
-    env.end();
-
     return cg_converged;
 }
 
@@ -278,12 +492,16 @@ bool SolveNodeSP1DP(ProblemParams& params, ProblemData& data, BPNode* node) {
     int num_strip_types = params.num_strip_types_;
     int W = params.stock_width_;  // 母板宽度 = 背包容量
 
-    LOG_FMT("[SP1-%d] 节点%d 求解SP1 (DP)\n", node->iter_, node->id_);
+    LOG_DEBUG_FMT("[SP1-%d] 节点%d 求解SP1 (DP)\n", node->iter_, node->id_);
 
     // dp[w]: 使用宽度w时能获得的最大价值
-    // choice[w]: 达到最大价值时的切割方案
-    vector<double> dp(W + 1, 0.0);
-    vector<vector<int>> choice(W + 1, vector<int>(num_strip_types, 0));
+    // choice[w]: 达到最大价值时的切割方案 (工作区复用, 只清零不重新分配)
+    PricingWorkspace& ws = GetPricingWorkspace();
+    vector<double>& dp = ws.dp_;
+    vector<vector<int>>& choice = ws.choice_;
+    dp.assign(W + 1, 0.0);
+    choice.resize(W + 1);
+    for (auto& c : choice) c.assign(num_strip_types, 0);
 
     // 完全背包DP: 每种条带可使用任意次
     for (int j = 0; j < num_strip_types; j++) {
@@ -291,17 +509,12 @@ bool SolveNodeSP1DP(ProblemParams& params, ProblemData& data, BPNode* node) {
         double val = node->duals_[j];           // 条带对偶价格
         if (val <= 0) continue;  // 跳过非正价值的条带
 
-        // 从小到大遍历容量, 允许重复选择
-        for (int w = wid; w <= W; w++) {
-            if (dp[w - wid] + val > dp[w]) {
-                dp[w] = dp[w - wid] + val;
-                choice[w] = choice[w - wid];
-                choice[w][j]++;  // 多选一个j型条带
-            }
-        }
+        // 完全背包转移, 数量受 strip_max_per_plate_[j] 限制
+        AddKnapsackItem(dp, choice, j, wid, val, data.strip_max_per_plate_[j]);
     }
 
     double rc = dp[W];  // reduced cost = 最大价值
+    node->price_value_ = rc;
     if (rc > 1 + kRcTolerance) {
         node->new_y_col_.pattern_ = choice[W];  // 保存最优方案
         return false;  // 找到改进列
@@ -317,71 +530,53 @@ bool SolveNodeSP1DP(ProblemParams& params, ProblemData& data, BPNode* node) {
 // 列生成判断:
 //   - reduced_cost = obj_value - v_j (X列在目标函数系数为-v_j)
 //   - 若 reduced_cost > 0, 说明该列能改进目标
+// 各条带类型共用一个模型: 放不下当前条带的子板上界置0, 每次定价只改变化的系数和上界
 // 参数: strip_type_id - 条带类型索引
 // 返回值: true=列生成收敛, false=找到改进列
 bool SolveNodeSP2Knapsack(ProblemParams& params, ProblemData& data,
     BPNode* node, int strip_type_id) {
 
-    IloEnv env;
-    IloModel model(env);
-    IloNumVarArray vars(env);
     int num_item_types = params.num_item_types_;
     int num_strip_types = params.num_strip_types_;
     int strip_width = data.strip_types_[strip_type_id].width_;  // 当前条带宽度
 
-    // 构建目标函数: max sum(pi_i * D_i)
-    IloExpr obj_expr(env);
+    // 目标系数 pi_i (只考虑宽度能装入当前条带且对偶价格为正的子板) 与变量上界
+    PricingWorkspace& ws = GetPricingWorkspace();
+    vector<double>& coefs = ws.coefs_;
+    vector<double>& ubs = ws.ubs_;
+    coefs.assign(num_item_types, 0.0);
+    ubs.assign(num_item_types, 0.0);
     double sum_coef = 0;  // 用于检查是否有正系数
 
     for (int i = 0; i < num_item_types; i++) {
-        string var_name = "D_" + to_string(i + 1);
-        IloNumVar var(env, 0, IloInfinity, ILOINT, var_name.c_str());
-        vars.add(var);
-
-        // 只考虑宽度能装入当前条带的子板
-        if (data.item_types_[i].width_ <= strip_width) {
-            double dual = node->duals_[num_strip_types + i];  // pi_i
-            if (dual > 0) {
-                obj_expr += vars[i] * dual;
-                sum_coef += dual;
-            }
+        if (data.item_types_[i].width_ > strip_width) continue;
+        ubs[i] = data.item_max_per_strip_[i];
+        double dual = node->duals_[num_strip_types + i];  // pi_i
+        if (dual > 0) {
+            coefs[i] = dual;
+            sum_coef += dual;
         }
     }
 
     // 无正系数子板, 无需求解 (不可能找到改进列)
     if (sum_coef <= 0) {
-        obj_expr.end();
-        vars.end();
-        model.end();
-        env.end();
         return true;
     }
 
-    IloObjective obj = IloMaximize(env, obj_expr);
-    model.add(obj);
-
-    // 长度约束: sum(l_i * D_i) <= L
-    // 子板长度总和不能超过条带长度(=母板长度)
-    IloExpr len_expr(env);
-    for (int i = 0; i < num_item_types; i++) {
-        if (data.item_types_[i].width_ <= strip_width) {
-            len_expr += data.item_types_[i].length_ * vars[i];
-        }
-    }
-    model.add(len_expr <= params.stock_length_);
-    len_expr.end();
+    if (!ws.sp2_knapsack_) ws.sp2_knapsack_ = BuildSP2KnapsackModel(params, data);
+    PricingModel& model = *ws.sp2_knapsack_;
+    UpdateObjective(model, coefs);
+    UpdateVarBounds(model, ubs);
 
     // 求解背包问题
-    LOG_FMT("[SP2-%d] 条带类型%d 求解SP2 (背包)\n", node->iter_, strip_type_id);
-    IloCplex cplex(env);
-    cplex.extract(model);
-    cplex.setOut(env.getNullStream());
-    bool feasible = cplex.solve();
+    LOG_DEBUG_FMT("[SP2-%d] 条带类型%d 求解SP2 (背包)\n", node->iter_, strip_type_id);
+    bool feasible = model.cplex_.solve();
 
     bool cg_converged = true;
 
     if (feasible) {
-        double rc = cplex.getObjValue();
+        double rc = model.cplex_.getObjValue();
+        node->price_value_ = rc;
         double dual_v = node->duals_[strip_type_id];  // 条带的对偶价格
 
         // 判断改进条件: rc > v_j
@@ -389,24 +584,11 @@ bool SolveNodeSP2Knapsack(ProblemParams& params, ProblemData& data,
             cg_converged = false;
 
             // 提取解向量
-            node->new_x_col_.pattern_.clear();
-            for (int i = 0; i < num_item_types; i++) {
-                double val = cplex.getValue(vars[i]);
-                int int_val = (val - (int)val > 0.99999) ? (int)val + 1 : (int)val;
-                node->new_x_col_.pattern_.push_back(int_val);
-            }
+            ExtractIntValues(model, node->new_x_col_.pattern_);
             node->new_strip_type_ = strip_type_id;  // 记录条带类型
         }
     }
 
-    // 释放CPLEX资源
-    obj_expr.end();
-    obj.end();
-    vars.end();
-    cplex.end();
-    model.end();
-    env.end();
-
     return cg_converged;
 }
 
@@ -415,21 +597,25 @@ bool SolveNodeSP2Knapsack(ProblemParams& params, ProblemData& data,
 // Arc Flow网络结构:
 //   - 节点: 0, 1, 2, ..., L (表示条带长度的使用位置)
 //   - Arc (i, j): 在位置i放置长度为(j-i)的子板
-//   - 每种条带类型有独立的Arc网络 (因宽度不同, 可装入的子板不同)
+//   - 各条带类型共享一个Arc网络, 本条带放不下的子板弧上界为0 (sp2_strip_data_ 过滤)
 // Arc约束处理 (数学模型 Section 9.5):
-//   - 零弧约束: 直接禁用该Arc (setUB(0))
+//   - 零弧约束: 直接禁用该Arc (上界为0)
 //   - 非零约束: 使用对偶价格 μ_a 修正弧收益: π_i → π_i + μ_a
 //   - 对偶价格来自RMP中的Arc行约束
+// 各条带类型共用一个持久化模型, 每次定价只改变化的目标系数、Arc上界与数量上界
 // 返回值: true=列生成收敛, false=找到改进列
 bool SolveNodeSP2ArcFlow(ProblemParams& params, ProblemData& data,
     BPNode* node, int strip_type_id) {
+    // 建模计时起点
+    auto build_start = chrono::steady_clock::now();
 
-    // 确保该条带类型的Arc网络已生成
-    if ((int)data.sp2_arc_data_.size() <= strip_type_id) {
-        GenerateSP2Arcs(data, params, strip_type_id);
+    // 确保共享Arc网络已生成
+    if ((int)data.sp2_strip_data_.size() <= strip_type_id) {
+        GenerateSP2Arcs(data, params);
     }
 
-    SP2ArcFlowData& arc_data = data.sp2_arc_data_[strip_type_id];
+    const SP2ArcFlowData& arc_data = data.sp2_arc_data_;
+    const SP2StripData& strip_data = data.sp2_strip_data_[strip_type_id];
     int num_arcs = static_cast<int>(arc_data.arc_list_.size());
     int num_item_types = params.num_item_types_;
     int num_strip_types = params.num_strip_types_;
@@ -437,119 +623,90 @@ bool SolveNodeSP2ArcFlow(ProblemParams& params, ProblemData& data,
     // 无Arc网络时视为收敛
     if (num_arcs == 0) return true;
 
-    IloEnv env;
-    IloModel model(env);
-    IloNumVarArray vars(env);
+    PricingWorkspace& ws = GetPricingWorkspace();
+    if (!ws.sp2_arc_flow_) ws.sp2_arc_flow_ = BuildSP2ArcFlowModel(params, data);
+    PricingModel& model = *ws.sp2_arc_flow_;
+    RefreshZeroArcIds(ws, data, node);
 
-    // 获取该条带类型的Arc对偶价格
-    const map<array<int, 2>, double>* arc_duals = nullptr;
-    if (node->sp2_arc_duals_.count(strip_type_id)) {
-        arc_duals = &node->sp2_arc_duals_.at(strip_type_id);
+    // 共享网络上本条带类型的子板标签 (-1 为损耗弧或不可用)
+    vector<int>& arc_items = ws.arc_items_;
+    arc_items.resize(num_arcs);
+    for (int i = 0; i < num_arcs; i++) {
+        arc_items[i] = GetSP2ArcItem(arc_data, strip_data, i);
     }
 
-    // 为每个Arc创建0-1整数变量
     // 目标函数: max sum((π_i + μ_a) * a_k)
     // π_i为Arc对应子板的对偶价格, μ_a为Arc约束对偶价格
-    IloExpr obj_expr(env);
+    // Arc上界: 本条带放不下的子板弧与禁用Arc为0
+    vector<double>& coefs = ws.coefs_;
+    vector<double>& ubs = ws.ubs_;
+    coefs.assign(num_arcs, 0.0);
+    ubs.resize(num_arcs);
     for (int i = 0; i < num_arcs; i++) {
-        string var_name = "a_" + to_string(i + 1);
-        IloNumVar var(env, 0, 1, ILOINT, var_name.c_str());
-        vars.add(var);
-
-        // Arc长度对应子板长度, 映射到对偶价格
-        const auto& arc = arc_data.arc_list_[i];
-        int arc_len = arc[1] - arc[0];
+        ubs[i] = SP2ArcAllowed(arc_data, strip_data, i) ? 1.0 : 0.0;
 
         // 基础收益: 物品弧为 π_i, 损耗弧为 0
         double profit = 0.0;
-        if (data.length_to_item_index_.count(arc_len)) {
-            int item_idx = data.length_to_item_index_[arc_len];
+        int item_idx = arc_items[i];
+        if (item_idx >= 0) {
             profit = node->duals_[num_strip_types + item_idx];
         }
 
-        // 添加 Arc 约束对偶价格修正 (数学模型 Section 9.5)
-        // μ_a 来自 RMP 中 Arc 行约束的对偶价格
-        if (arc_duals != nullptr && arc_duals->count(arc) > 0) {
-            double mu_a = arc_duals->at(arc);
-            profit += mu_a;
-            LOG_FMT("  SP2[%d] Arc (%d,%d): profit %.4f + mu %.4f = %.4f\n",
-                strip_type_id, arc[0], arc[1], profit - mu_a, mu_a, profit);
-        }
-
         if (fabs(profit) > kZeroTolerance) {
-            obj_expr += vars[i] * profit;
+            coefs[i] = profit;
         }
     }
 
-    IloObjective obj = IloMaximize(env, obj_expr);
-    model.add(obj);
-
-    // 长度约束: 选中Arc总长度不超过条带长度 (冗余约束)
-    IloExpr len_expr(env);
-    for (int i = 0; i < num_arcs; i++) {
-        int arc_len = arc_data.arc_list_[i][1] - arc_data.arc_list_[i][0];
-        len_expr += arc_len * vars[i];
+    // 添加 Arc 约束对偶价格修正 (数学模型 Section 9.5)
+    // μ_a 来自 RMP 中 Arc 行约束的对偶价格, 已由 ScatterArcDuals 按Arc编号写入本条带类型的 arc_duals_
+    for (const auto& [arc_idx, mu_a] : strip_data.arc_duals_) {
+        if (arc_idx >= num_arcs) continue;
+        const auto& arc = arc_data.arc_list_[arc_idx];
+        LOG_TRACE_FMT("  SP2[%d] Arc (%d,%d): mu %.4f\n", strip_type_id, arc[0], arc[1], mu_a);
+        coefs[arc_idx] += mu_a;
     }
-    model.add(len_expr <= params.stock_length_);
-    len_expr.end();
 
-    // 起点约束: 从节点0出发的流量 = 1
-    IloExpr begin_expr(env);
-    for (int idx : arc_data.begin_arc_indices_) {
-        begin_expr += vars[idx];
-    }
-    model.add(begin_expr == 1);
-    begin_expr.end();
-
-    // 终点约束: 进入终点节点的流量 = 1
-    IloExpr end_expr(env);
-    for (int idx : arc_data.end_arc_indices_) {
-        end_expr += vars[idx];
+    // 禁用Arc约束: 上界为0, 完全禁止使用该Arc
+    // 这是零弧分支的正确处理: 子问题不生成使用该Arc的新pattern
+    for (int idx : SP2ZeroArcIds(ws, strip_type_id)) {
+        if (idx < num_arcs) ubs[idx] = 0.0;
     }
-    model.add(end_expr == 1);
-    end_expr.end();
 
-    // 中间节点流量守恒: 流入量 = 流出量
-    int num_mid = static_cast<int>(arc_data.mid_nodes_.size());
-    for (int i = 0; i < num_mid; i++) {
-        IloExpr in_expr(env);
-        IloExpr out_expr(env);
-        for (int idx : arc_data.mid_in_arcs_[i]) {
-            in_expr += vars[idx];
-        }
-        for (int idx : arc_data.mid_out_arcs_[i]) {
-            out_expr += vars[idx];
+    UpdateObjective(model, coefs);
+    UpdateVarBounds(model, ubs);
+
+    // 数量上界: i 型子板弧的流量之和不超过 item_max_per_strip_[i] (比容量更紧时才生效)
+    int num_rows = static_cast<int>(model.row_kinds_.size());
+    for (int r = 0; r < num_rows; r++) {
+        int item = strip_data.length_items_[model.row_kinds_[r]];
+        double ub = IloInfinity;
+        if (item >= 0 && data.item_max_per_strip_[item] <
+            params.stock_length_ / data.item_types_[item].length_) {
+            ub = data.item_max_per_strip_[item];
         }
-        model.add(in_expr == out_expr);
-        in_expr.end();
-        out_expr.end();
-    }
-
-    // 禁用Arc约束: 设置上界为0, 完全禁止使用该Arc
-    // 这是零弧分支的正确处理: 子问题不生成使用该Arc的新pattern
-    if (node->sp2_zero_arcs_.count(strip_type_id)) {
-        for (const auto& arc : node->sp2_zero_arcs_.at(strip_type_id)) {
-            if (arc_data.arc_to_index_.count(arc)) {
-                int idx = arc_data.arc_to_index_.at(arc);
-                vars[idx].setUB(0);
-            }
+        if (ub != model.row_ubs_[r]) {
+            model.rows_[r].setUB(ub);
+            model.row_ubs_[r] = ub;
         }
     }
 
     // 注意: 非零Arc约束 (sp2_lower_arcs_, sp2_greater_arcs_) 不再在此处处理
     // 它们已作为RMP行约束, 通过对偶价格 μ_a 影响子问题目标函数
 
+    // 建模耗时 (不含CPLEX求解)
+    double build_ms = chrono::duration<double, milli>(
+        chrono::steady_clock::now() - build_start).count();
+
     // 求解Arc Flow子问题
-    LOG_FMT("[SP2-%d] 条带类型%d 求解SP2 (Arc Flow)\n", node->iter_, strip_type_id);
-    IloCplex cplex(env);
-    cplex.extract(model);
-    cplex.setOut(env.getNullStream());
-    bool feasible = cplex.solve();
+    LOG_DEBUG_FMT("[SP2-%d] 条带类型%d 求解SP2 (Arc Flow)\n", node->iter_, strip_type_id);
+    bool feasible = model.cplex_.solve();
+    LOG_TRACE_FMT("  [SP2] 建模耗时: %.3f ms\n", build_ms);
 
     bool cg_converged = true;
 
     if (feasible) {
-        double rc = cplex.getObjValue();
+        double rc = model.cplex_.getObjValue();
+        node->price_value_ = rc;
         double dual_v = node->duals_[strip_type_id];  // 条带的对偶价格
 
         // 判断改进条件: rc > v_j
@@ -557,39 +714,30 @@ bool SolveNodeSP2ArcFlow(ProblemParams& params, ProblemData& data,
             cg_converged = false;
 
             // 根据选中的Arc构建切割模式
+            vector<int> selected;
+            ExtractIntValues(model, selected);
             vector<int> pattern(num_item_types, 0);
-            set<array<int, 2>> selected_arcs;  // 记录选中的Arc用于约束系数
+            vector<int> selected_arcs;  // 记录选中的Arc用于约束系数 (Arc编号, 升序)
             for (int i = 0; i < num_arcs; i++) {
-                double val = cplex.getValue(vars[i]);
-                if (val > 0.5) {  // Arc被选中
-                    const auto& arc = arc_data.arc_list_[i];
-                    selected_arcs.insert(arc);
-                    int arc_len = arc[1] - arc[0];
-                    if (data.length_to_item_index_.count(arc_len)) {
-                        int item_idx = data.length_to_item_index_[arc_len];
+                if (selected[i] > 0) {  // Arc被选中
+                    selected_arcs.push_back(i);
+                    int item_idx = arc_items[i];
+                    if (item_idx >= 0) {
                         pattern[item_idx]++;
                     }
                 }
             }
             node->new_x_col_.pattern_ = pattern;
-            node->new_x_col_.arc_set_ = selected_arcs;
+            node->new_x_col_.arc_ids_ = selected_arcs;
             node->new_strip_type_ = strip_type_id;
-            LOG("  [SP2] 找到改进列");
+            LOG_DEBUG("  [SP2] 找到改进列");
         } else {
-            LOG("  [SP2] 收敛");
+            LOG_DEBUG("  [SP2] 收敛");
         }
     } else {
-        LOG("  [SP2] 子问题不可行");
+        LOG_DEBUG("  [SP2] 子问题不可行");
     }
 
-    // 释放CPLEX资源
-    obj_expr.end();
-    obj.end();
-    vars.end();
-    cplex.end();
-    model.end();
-    env.end();
-
     return cg_converged;
 }
 
@@ -607,12 +755,16 @@ bool SolveNodeSP2DP(ProblemParams& params, ProblemData& data,
     int L = params.stock_length_;  // 条带长度 = 背包容量
     int strip_width = data.strip_types_[strip_type_id].width_;
 
-    LOG_FMT("[SP2-%d] 条带类型%d 求解SP2 (DP)\n", node->iter_, strip_type_id);
+    LOG_DEBUG_FMT("[SP2-%d] 条带类型%d 求解SP2 (DP)\n", node->iter_, strip_type_id);
 
     // dp[l]: 使用长度l时能获得的最大价值
-    // choice[l]: 达到最大价值时的切割方案
-    vector<double> dp(L + 1, 0.0);
-    vector<vector<int>> choice(L + 1, vector<int>(num_item_types, 0));
+    // choice[l]: 达到最大价值时的切割方案 (工作区复用, 只清零不重新分配)
+    PricingWorkspace& ws = GetPricingWorkspace();
+    vector<double>& dp = ws.dp_;
+    vector<vector<int>>& choice = ws.choice_;
+    dp.assign(L + 1, 0.0);
+    choice.resize(L + 1);
+    for (auto& c : choice) c.assign(num_item_types, 0);
 
     // 完全背包DP: 每种子板可使用任意次
     for (int i = 0; i < num_item_types; i++) {
@@ -623,17 +775,12 @@ bool SolveNodeSP2DP(ProblemParams& params, ProblemData& data,
         double val = node->duals_[num_strip_types + i];  // 子板对偶价格
         if (val <= 0) continue;  // 跳过非正价值的子板
 
-        // 从小到大遍历容量, 允许重复选择
-        for (int l = len; l <= L; l++) {
-            if (dp[l - len] + val > dp[l]) {
-                dp[l] = dp[l - len] + val;
-                choice[l] = choice[l - len];
-                choice[l][i]++;  // 多选一个i型子板
-            }
-        }
+        // 完全背包转移, 数量受 item_max_per_strip_[i] 限制
+        AddKnapsackItem(dp, choice, i, len, val, data.item_max_per_strip_[i]);
     }
 
     double rc = dp[L];  // 目标值
+    node->price_value_ = rc;
     double dual_v = node->duals_[strip_type_id];  // 条带对偶价格
 
     // 判断改进条件: rc > v_j
@@ -644,3 +791,148 @@ bool SolveNodeSP2DP(ProblemParams& params, ProblemData& data,
     }
     return true;  // 收敛
 }
+
+// 非根节点SP2子问题: 隐式网络最长路求解
+// 条带长度超过 kImplicitArcMinLength 时代替 Arc Flow 模型
+// 禁用Arc在最长路中跳过, 其他Arc约束的对偶价格 μ_a 已由 ScatterArcDuals 写入本条带类型的 arc_duals_
+bool SolveNodeSP2Implicit(ProblemParams& params, ProblemData& data,
+    BPNode* node, int strip_type_id) {
+
+    int num_item_types = params.num_item_types_;
+    int num_strip_types = params.num_strip_types_;
+    const SP2ArcFlowData& arc_data = data.sp2_arc_data_;
+    const SP2StripData& strip_data = data.sp2_strip_data_[strip_type_id];
+
+    LOG_DEBUG_FMT("[SP2-%d] 条带类型%d 求解SP2 (隐式网络)\n", node->iter_, strip_type_id);
+
+    // 子板收益 π_i (只取正值)
+    vector<double> profits(num_item_types, 0.0);
+    for (int i = 0; i < num_item_types; i++) {
+        profits[i] = max(node->duals_[num_strip_types + i], 0.0);
+    }
+
+    // 禁用 Arc 编号 (按节点缓存)
+    PricingWorkspace& ws = GetPricingWorkspace();
+    RefreshZeroArcIds(ws, data, node);
+    const vector<int>& forbidden = SP2ZeroArcIds(ws, strip_type_id);
+
+    vector<int> pattern;
+    vector<int> arc_ids;
+    double rc = SolveSP2ImplicitPath(arc_data, strip_data, profits, forbidden,
+        pattern, arc_ids, ThreadPathWorkspace());
+    node->price_value_ = rc;
+    double dual_v = node->duals_[strip_type_id];  // 条带对偶价格
+
+    // 判断改进条件: rc > v_j
+    if (rc > dual_v + kRcTolerance) {
+        node->new_x_col_.pattern_ = pattern;
+        node->new_x_col_.arc_ids_ = arc_ids;
+        node->new_strip_type_ = strip_type_id;
+        LOG_DEBUG("  [SP2] 找到改进列");
+        return false;  // 找到改进列
+    }
+    LOG_DEBUG("  [SP2] 收敛");
+    return true;  // 收敛
+}
+
+// 非根节点SP2子问题: 标签定价 (节点 RMP 含秩1割)
+// 割行对偶价格 ρ_c > 0 时列收益含 ρ_c * ceil(Σ_{i∈S} a_i / q), 不再按 Arc 可加,
+// 显式 / 隐式网络都改用 SolveSP2LabelPath; 禁用Arc与 μ_a 的处理同隐式网络
+// 只有 S 中含本条带可放子板的割影响本条带的定价
+#ifndef NDEBUG
+// 调试构建: 不含割时标签定价的目标值应与 Arc Flow 模型一致 (隐式网络与最长路比较)
+// 不一致说明标签定价漏掉了可行方案, 此时节点下界无效
+static void CheckSP2LabelPath(ProblemParams& params, ProblemData& data, BPNode* node,
+    int strip_type_id, const vector<double>& profits, const vector<int>& forbidden) {
+    const SP2ArcFlowData& arc_data = data.sp2_arc_data_;
+    const SP2StripData& strip_data = data.sp2_strip_data_[strip_type_id];
+    vector<int> pattern;
+    vector<int> arc_ids;
+    double label_value = SolveSP2LabelPath(arc_data, strip_data, profits, forbidden,
+        {}, {}, pattern, arc_ids, ThreadPathWorkspace());
+
+    double ref_value;
+    if (arc_data.implicit_) {
+        ref_value = SolveSP2ImplicitPath(arc_data, strip_data, profits, forbidden,
+            pattern, arc_ids, ThreadPathWorkspace());
+    } else {
+        // 只取目标值; 新列与收敛判断以随后的标签定价为准
+        node->price_value_ = NAN;
+        SolveNodeSP2ArcFlow(params, data, node, strip_type_id);
+        ref_value = node->price_value_;
+    }
+    if (isnan(ref_value)) return;
+
+    // 容差取 CPLEX MIP 默认相对间隙 (1e-4)
+    if (fabs(label_value - ref_value) > 1.0e-4 * max(1.0, fabs(ref_value))) {
+        LOG_WARN_FMT("[SP2] 错误: 条带类型%d 标签定价 (不含割) 目标值 %.6f 与 %s %.6f 不一致\n",
+            strip_type_id, label_value, arc_data.implicit_ ? "最长路" : "Arc Flow", ref_value);
+    }
+}
+#endif
+
+bool SolveNodeSP2Labels(ProblemParams& params, ProblemData& data,
+    BPNode* node, int strip_type_id) {
+
+    // 确保共享Arc网络已生成
+    if ((int)data.sp2_strip_data_.size() <= strip_type_id) {
+        GenerateSP2Arcs(data, params);
+    }
+
+    int num_item_types = params.num_item_types_;
+    int num_strip_types = params.num_strip_types_;
+    const SP2ArcFlowData& arc_data = data.sp2_arc_data_;
+    const SP2StripData& strip_data = data.sp2_strip_data_[strip_type_id];
+    const auto& length_items = strip_data.length_items_;
+
+    // 子板收益 π_i (只取正值)
+    vector<double> profits(num_item_types, 0.0);
+    for (int i = 0; i < num_item_types; i++) {
+        profits[i] = max(node->duals_[num_strip_types + i], 0.0);
+    }
+
+    // 禁用 Arc 编号 (按节点缓存)
+    PricingWorkspace& ws = GetPricingWorkspace();
+    RefreshZeroArcIds(ws, data, node);
+    const vector<int>& forbidden = SP2ZeroArcIds(ws, strip_type_id);
+
+    // 与本条带有关的割
+    vector<const RankOneCut*> cuts;
+    vector<double> cut_duals;
+    for (const auto& cut_row : node->cut_rows_) {
+        if (cut_row.dual_ <= kZeroTolerance) continue;
+        const RankOneCut& cut = data.cut_pool_[cut_row.cut_id_];
+        bool relevant = any_of(cut.items_.begin(), cut.items_.end(), [&](int i) {
+            return find(length_items.begin(), length_items.end(), i) != length_items.end();
+        });
+        if (relevant) {
+            cuts.push_back(&cut);
+            cut_duals.push_back(cut_row.dual_);
+        }
+    }
+
+    LOG_DEBUG_FMT("[SP2-%d] 条带类型%d 求解SP2 (标签, 割%d条)\n",
+        node->iter_, strip_type_id, (int)cuts.size());
+
+#ifndef NDEBUG
+    CheckSP2LabelPath(params, data, node, strip_type_id, profits, forbidden);
+#endif
+
+    vector<int> pattern;
+    vector<int> arc_ids;
+    double rc = SolveSP2LabelPath(arc_data, strip_data, profits, forbidden,
+        cuts, cut_duals, pattern, arc_ids, ThreadPathWorkspace());
+    node->price_value_ = rc;
+    double dual_v = node->duals_[strip_type_id];  // 条带对偶价格
+
+    // 判断改进条件: rc > v_j
+    if (rc > dual_v + kRcTolerance) {
+        node->new_x_col_.pattern_ = pattern;
+        node->new_x_col_.arc_ids_ = arc_ids;
+        node->new_strip_type_ = strip_type_id;
+        LOG_DEBUG("  [SP2] 找到改进列");
+        return false;  // 找到改进列
+    }
+    LOG_DEBUG("  [SP2] 收敛");
+    return true;  // 收敛
+}
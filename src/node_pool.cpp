@@ -0,0 +1,177 @@
+// node_pool.cpp - 分支树节点池
+//
+// 分支定价过程中的子节点从节点池分配，不再逐个 new:
+// - 节点按块分配 (每块 kNodePoolBlockSize 个)，块在 RunBranchAndPrice 结束时整体释放
+// - 节点被剪枝、得到整数解或完成分支后立即归还，重置为空节点放入空闲链表
+//   重置时节点内各容器 (Arc 约束、对偶价格、解) 的内存随之释放
+// - 之后的分配优先复用空闲节点，树被剪枝时在用节点数随之下降
+//
+// 列数据由全局列池 (ColumnStore) 连续存储，所有节点共享，不随节点回收
+//
+// 内存预算 (params.mem_limit_mb_ > 0) 下的节点溢出:
+// - 待处理节点由 WriteNodeRecord 追加写入溢出文件，内存中只保留 (偏移, 下界, 编号)
+// - 读回时按偏移定位，读出后移除登记; 文件只追加不回收，求解结束后删除
+
+#include "2DBP.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// 从节点池分配一个空节点
+BPNode* AllocNode(NodePool& pool) {
+    pool.num_allocs_++;
+
+    BPNode* node = nullptr;
+    if (!pool.free_list_.empty()) {
+        node = pool.free_list_.back();
+        pool.free_list_.pop_back();
+        pool.num_reuses_++;
+    } else {
+        if (pool.blocks_.empty() || pool.block_used_ == kNodePoolBlockSize) {
+            pool.blocks_.emplace_back(new BPNode[kNodePoolBlockSize]);
+            pool.block_used_ = 0;
+        }
+        node = &pool.blocks_.back()[pool.block_used_++];
+    }
+
+    pool.num_live_++;
+    pool.peak_live_ = max(pool.peak_live_, pool.num_live_);
+    return node;
+}
+
+// 归还节点: 重置为空节点 (释放其容器内存) 后放入空闲链表
+void ReleaseNode(NodePool& pool, BPNode* node) {
+    *node = BPNode();
+    pool.free_list_.push_back(node);
+    pool.num_live_--;
+    pool.num_released_++;
+}
+
+// 进程峰值常驻内存 (MB)，无法获取时返回 -1
+double GetPeakRssMB() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+    }
+    return -1;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return usage.ru_maxrss / 1024.0;  // Linux 下单位为 KB
+    }
+    return -1;
+#endif
+}
+
+// 进程当前常驻内存 (MB)，无法获取时返回 -1
+double GetCurrentRssMB() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.WorkingSetSize / (1024.0 * 1024.0);
+    }
+    return -1;
+#else
+    // /proc/self/statm 第二项为常驻页数
+    ifstream statm("/proc/self/statm");
+    long long total_pages = 0;
+    long long resident_pages = 0;
+    if (statm >> total_pages >> resident_pages) {
+        return resident_pages * (sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0));
+    }
+    return -1;
+#endif
+}
+
+// 输出节点池统计
+void LogNodePoolStats(const NodePool& pool) {
+    LOG_FMT("[BP] 节点池: 分配%lld次 (复用%lld次), 在用%d, 峰值在用%d, 已回收%d, 节点块%d\n",
+        pool.num_allocs_, pool.num_reuses_, pool.num_live_, pool.peak_live_,
+        pool.num_released_, (int)pool.blocks_.size());
+    LOG_FMT("[BP] 峰值内存 (RSS): %.1f MB\n", GetPeakRssMB());
+}
+
+// 将节点追加写入溢出文件 (首次调用时创建文件)
+bool SpillNode(NodeSpill& spill, const BPNode& node) {
+    if (!spill.file_.is_open()) {
+        filesystem::create_directories(kSpillDir);
+        spill.path_ = kSpillDir + "nodes_" + GetTimestampString() + ".bin";
+        spill.file_.open(spill.path_, ios::in | ios::out | ios::binary | ios::trunc);
+        if (!spill.file_.is_open()) {
+            LOG_WARN_FMT("[BP] 错误: 无法创建溢出文件 %s\n", spill.path_.c_str());
+            return false;
+        }
+        LOG_FMT("[BP] 溢出文件: %s\n", spill.path_.c_str());
+    }
+
+    spill.file_.clear();
+    spill.file_.seekp(0, ios::end);
+    SpilledNode entry;
+    entry.offset_ = static_cast<long long>(spill.file_.tellp());
+    entry.lower_bound_ = node.lower_bound_;
+    entry.id_ = node.id_;
+
+    WriteNodeRecord(spill.file_, node);
+    spill.file_.flush();
+    if (!spill.file_) {
+        LOG_WARN_FMT("[BP] 错误: 写入溢出文件失败 (节点 %d)\n", node.id_);
+        return false;
+    }
+
+    spill.entries_.push_back(entry);
+    spill.num_spilled_++;
+    return true;
+}
+
+// 读出第 entry_idx 个溢出节点，保留其登记 (写检查点时使用)
+bool PeekSpilledNode(NodeSpill& spill, int entry_idx, BPNode& node) {
+    const SpilledNode& entry = spill.entries_[entry_idx];
+    spill.file_.clear();
+    spill.file_.seekg(entry.offset_);
+    if (!ReadNodeRecord(spill.file_, node)) {
+        LOG_WARN_FMT("[BP] 错误: 读回溢出节点 %d 失败\n", entry.id_);
+        return false;
+    }
+    return true;
+}
+
+// 读回第 entry_idx 个溢出节点，并移除其登记
+bool ReloadSpilledNode(NodeSpill& spill, int entry_idx, BPNode& node) {
+    bool ok = PeekSpilledNode(spill, entry_idx, node);
+    spill.entries_.erase(spill.entries_.begin() + entry_idx);
+    if (!ok) return false;
+    spill.num_reloaded_++;
+    return true;
+}
+
+// 剪掉下界不小于 ub 的溢出节点 (只移除登记)，返回剪掉的个数
+int DropSpilledNodes(NodeSpill& spill, double ub) {
+    auto last = remove_if(spill.entries_.begin(), spill.entries_.end(),
+        [ub](const SpilledNode& entry) { return entry.lower_bound_ >= ub - kZeroTolerance; });
+    int num_dropped = static_cast<int>(spill.entries_.end() - last);
+    spill.entries_.erase(last, spill.entries_.end());
+    spill.num_dropped_ += num_dropped;
+    return num_dropped;
+}
+
+// 关闭并删除溢出文件
+void CloseNodeSpill(NodeSpill& spill) {
+    if (!spill.file_.is_open()) return;
+    spill.file_.close();
+    error_code ec;
+    filesystem::remove(spill.path_, ec);
+    LOG_FMT("[BP] 节点溢出: 写出%d, 读回%d, 磁盘剪枝%d, 未处理%d\n",
+        spill.num_spilled_, spill.num_reloaded_, spill.num_dropped_,
+        (int)spill.entries_.size());
+}
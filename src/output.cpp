@@ -35,6 +35,8 @@ static string JsonDouble(double value, int precision = 4) {
 
 // 导出切割方案为JSON格式
 void ExportSolution(ProblemParams& params, ProblemData& data) {
+    PROFILE_ZONE("export.solution");
+
     filesystem::create_directories("results");
 
     string timestamp = GetTimestampString();
@@ -42,7 +44,7 @@ void ExportSolution(ProblemParams& params, ProblemData& data) {
     ofstream fout(output_file);
 
     if (!fout) {
-        LOG_FMT("[错误] 无法创建输出文件: %s\n", output_file.c_str());
+        LOG_WARN_FMT("[错误] 无法创建输出文件: %s\n", output_file.c_str());
         return;
     }
 
@@ -63,10 +65,14 @@ void ExportSolution(ProblemParams& params, ProblemData& data) {
     fout << "  },\n";
 
     // Summary
-    int num_plates = 0;
-    for (const auto& y_col : params.global_best_y_cols_) {
-        if (y_col.value_ > kZeroTolerance) {
-            num_plates += static_cast<int>(round(y_col.value_));
+    const ColumnStore& y_store = data.y_columns_;
+    const ColumnStore& x_store = data.x_columns_;
+    const NodeSolution& best = params.global_best_sol_;
+
+    int num_plates = params.fixed_plates_;  // 预处理固定的整板
+    for (const auto& entry : best.y_cols_) {
+        if (entry.value_ > kZeroTolerance) {
+            num_plates += static_cast<int>(round(entry.value_));
         }
     }
 
@@ -76,18 +82,24 @@ void ExportSolution(ProblemParams& params, ProblemData& data) {
                           data.item_types_[i].length_ *
                           data.item_types_[i].demand_;
     }
+    for (const auto& item : data.fixed_items_) {
+        total_item_area += item.width_ * item.length_ * item.demand_;
+    }
     double total_stock_area = num_plates * stock_width * stock_length;
     double total_utilization = (total_stock_area > 0) ? (total_item_area / total_stock_area) : 0.0;
 
+    // 目标值与下界都计入预处理固定的整板
+    double objective = params.global_best_int_ + params.fixed_plates_;
+    double root_lb = params.root_lb_ + params.fixed_plates_;
     double gap = 0.0;
-    if (params.global_best_int_ > kZeroTolerance) {
-        gap = (params.global_best_int_ - params.root_lb_) / params.global_best_int_;
+    if (objective > kZeroTolerance) {
+        gap = (objective - root_lb) / objective;
     }
 
     fout << "  \"summary\": {\n";
     fout << "    \"num_plates\": " << num_plates << ",\n";
-    fout << "    \"objective_value\": " << JsonDouble(params.global_best_int_) << ",\n";
-    fout << "    \"root_lb\": " << JsonDouble(params.root_lb_) << ",\n";
+    fout << "    \"objective_value\": " << JsonDouble(objective) << ",\n";
+    fout << "    \"root_lb\": " << JsonDouble(root_lb) << ",\n";
     fout << "    \"gap\": " << JsonDouble(gap) << ",\n";
     fout << "    \"total_utilization\": " << JsonDouble(total_utilization) << "\n";
     fout << "  },\n";
@@ -98,24 +110,31 @@ void ExportSolution(ProblemParams& params, ProblemData& data) {
     fout << "    \"length\": " << stock_length << "\n";
     fout << "  },\n";
 
-    // Item Types (从1开始编号)
+    // Item Types (从1开始编号, 预处理固定的整板子板排在最后)
+    int num_fixed_types = static_cast<int>(data.fixed_items_.size());
+    int num_export_types = num_item_types + num_fixed_types;
     fout << "  \"item_types\": [\n";
-    for (int i = 0; i < num_item_types; i++) {
-        const auto& item = data.item_types_[i];
+    for (int i = 0; i < num_export_types; i++) {
+        const auto& item = (i < num_item_types) ? data.item_types_[i]
+                                                : data.fixed_items_[i - num_item_types];
         fout << "    {\"id\": " << (i + 1)
              << ", \"width\": " << item.width_
              << ", \"length\": " << item.length_
              << ", \"demand\": " << item.demand_ << "}";
-        if (i < num_item_types - 1) fout << ",";
+        if (i < num_export_types - 1) fout << ",";
         fout << "\n";
     }
     fout << "  ],\n";
 
     // Plates
-    vector<vector<const XColumn*>> strip_x_cols(num_strip_types);
-    for (const auto& x_col : params.global_best_x_cols_) {
-        if (x_col.value_ > kZeroTolerance) {
-            strip_x_cols[x_col.strip_type_id_].push_back(&x_col);
+    // 按条带类型分组 X 列, 记录剩余可用次数 (每分配一个条带减 1)
+    // x_remaining[k] 对应 best.x_cols_[k]
+    vector<vector<int>> strip_x_cols(num_strip_types);
+    vector<double> x_remaining(best.x_cols_.size());
+    for (int k = 0; k < (int)best.x_cols_.size(); k++) {
+        x_remaining[k] = best.x_cols_[k].value_;
+        if (x_remaining[k] > kZeroTolerance) {
+            strip_x_cols[x_store.strip_types_[best.x_cols_[k].col_]].push_back(k);
         }
     }
 
@@ -128,10 +147,11 @@ void ExportSolution(ProblemParams& params, ProblemData& data) {
 
     int global_plate_id = 0;
 
-    for (const auto& y_col : params.global_best_y_cols_) {
-        if (y_col.value_ < kZeroTolerance) continue;
+    for (const auto& y_entry : best.y_cols_) {
+        if (y_entry.value_ < kZeroTolerance) continue;
 
-        int y_count = static_cast<int>(round(y_col.value_));
+        int y_col = y_entry.col_;
+        int y_count = static_cast<int>(round(y_entry.value_));
 
         for (int k = 0; k < y_count; k++) {
             global_plate_id++;
@@ -143,26 +163,26 @@ void ExportSolution(ProblemParams& params, ProblemData& data) {
             int strip_y = 0;
 
             for (int j = 0; j < num_strip_types; j++) {
-                int strip_count = y_col.pattern_[j];
+                int strip_count = GetPatternCoef(y_store, y_col, j);
                 if (strip_count <= 0) continue;
 
                 int strip_width = data.strip_types_[j].width_;
 
                 for (int s = 0; s < strip_count; s++) {
-                    const XColumn* x_col = nullptr;
-                    for (auto& col : strip_x_cols[j]) {
-                        if (col->value_ >= 1.0 - kZeroTolerance) {
-                            x_col = col;
-                            const_cast<XColumn*>(col)->value_ -= 1.0;
+                    int x_col = -1;
+                    for (int k : strip_x_cols[j]) {
+                        if (x_remaining[k] >= 1.0 - kZeroTolerance) {
+                            x_col = best.x_cols_[k].col_;
+                            x_remaining[k] -= 1.0;
                             break;
                         }
                     }
 
                     int item_x = 0;
 
-                    if (x_col != nullptr) {
+                    if (x_col >= 0) {
                         for (int i = 0; i < num_item_types; i++) {
-                            int item_count = x_col->pattern_[i];
+                            int item_count = GetPatternCoef(x_store, x_col, i);
                             if (item_count <= 0) continue;
                             if (data.item_types_[i].width_ != strip_width) continue;
 
@@ -220,6 +240,26 @@ void ExportSolution(ProblemParams& params, ProblemData& data) {
         }
     }
 
+    // 预处理固定的整板: 每块母板只放一个子板
+    for (int f = 0; f < num_fixed_types; f++) {
+        const auto& fixed = data.fixed_items_[f];
+        for (int k = 0; k < fixed.demand_; k++) {
+            global_plate_id++;
+
+            PlateData plate;
+            plate.plate_id = global_plate_id;
+            plate.utilization = 1.0;
+            map<string, int> item;
+            item["item_type"] = num_item_types + f + 1;
+            item["x"] = 0;
+            item["y"] = 0;
+            item["width"] = fixed.width_;
+            item["length"] = fixed.length_;
+            plate.items.push_back(item);
+            all_plates.push_back(plate);
+        }
+    }
+
     // 按利用率降序排序
     sort(all_plates.begin(), all_plates.end(),
          [](const PlateData& a, const PlateData& b) {
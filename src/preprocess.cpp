@@ -0,0 +1,246 @@
+// preprocess.cpp - 算例预处理
+//
+// 读取数据之后、生成 Arc 网络之前依次执行:
+// 1. ReduceInstance: 算例约简
+//    - 合并 (宽度, 长度) 相同的子板行, 需求相加 (ERP 导出常有大量重复行)
+//    - 剔除放不进母板的子板 (其需求无法满足, 记录警告)
+//    - 独占整块母板的子板 (w = W 且 l = L) 直接固定为整板, 不进入主问题
+//    - 独占整个条带的子板 (l = L) 不做固定: 仍需与其他条带组合到母板上,
+//      条带上只能放 1 个, 由定价数量上界 (ComputePricingBounds) 体现
+// 2. PreprocessDimensions: 尺寸缩放
+// 3. ComputePricingBounds: 定价子问题的数量上界
+//
+// 尺寸缩放: Arc Flow 网络节点数、DP 表长度都与母板尺寸 W / L 成正比, 在建网前先做两步无损缩减:
+// 1. 可达容量: 用全部尺寸做完全背包可达性 (subset-sum), 取不超过容量的最大可达值
+//    超出该值的部分任何方案都用不上, 直接截掉
+// 2. 最大公约数: 所有尺寸及可达容量同除以它们的 GCD
+//    (可达容量本身是尺寸的整数组合, 必为 GCD 的倍数)
+//
+// 宽度方向使用条带宽度 (即不同的子板宽度), 长度方向使用全部子板长度
+// 长度方向对所有条带类型取并集, 单个条带的可达长度不会超过该值, 因此对每个 SP2 都无损
+//
+// 求解结束后 RestoreDimensions 将尺寸恢复为原始值, 供 ExportSolution 输出
+
+#include "2DBP.h"
+
+#include <numeric>  // for gcd
+
+using namespace std;
+
+// 算例约简
+// 修改 data.item_types_ 后重建条带类型与索引
+// 固定的整板子板移入 data.fixed_items_, 对应母板数记入 params.fixed_plates_
+void ReduceInstance(ProblemParams& params, ProblemData& data) {
+    int num_rows = static_cast<int>(data.item_types_.size());
+
+    // 1. 合并相同尺寸的子板 (保留首次出现的编号)
+    vector<ItemType> merged;
+    map<array<int, 2>, int> size_to_merged;
+    for (const auto& item : data.item_types_) {
+        array<int, 2> key = {item.width_, item.length_};
+        auto it = size_to_merged.find(key);
+        if (it == size_to_merged.end()) {
+            size_to_merged[key] = static_cast<int>(merged.size());
+            merged.push_back(item);
+        } else {
+            merged[it->second].demand_ += item.demand_;
+        }
+    }
+    int num_merged = num_rows - static_cast<int>(merged.size());
+
+    // 2. 剔除放不下的子板, 3. 固定整板子板
+    vector<ItemType> kept;
+    vector<ItemType> full_plate;
+    int num_dropped = 0;
+    for (const auto& item : merged) {
+        if (item.demand_ <= 0) continue;
+        if (item.width_ > params.stock_width_ || item.length_ > params.stock_length_) {
+            LOG_WARN_FMT("[预处理] 警告: 子板%d (%dx%d) 放不进母板, 需求%d无法满足, 已剔除\n",
+                item.type_id_, item.width_, item.length_, item.demand_);
+            num_dropped++;
+            continue;
+        }
+        if (item.width_ == params.stock_width_ && item.length_ == params.stock_length_) {
+            full_plate.push_back(item);
+            continue;
+        }
+        kept.push_back(item);
+    }
+
+    // 整板子板只有在还剩其他子板时才移出 (保证主问题非空)
+    params.fixed_plates_ = 0;
+    data.fixed_items_.clear();
+    if (!kept.empty()) {
+        for (const auto& item : full_plate) {
+            params.fixed_plates_ += item.demand_;
+            data.fixed_items_.push_back(item);
+        }
+    } else {
+        kept.insert(kept.end(), full_plate.begin(), full_plate.end());
+    }
+
+    data.item_types_.swap(kept);
+    BuildStripTypes(params, data);
+
+    LOG_FMT("[预处理] 子板行: %d -> %d (合并%d, 剔除%d, 固定整板%d种/%d块)\n",
+        num_rows, params.num_item_types_, num_merged, num_dropped,
+        (int)data.fixed_items_.size(), params.fixed_plates_);
+}
+
+// 计算一维完全背包的最大可达容量
+// sizes: 物品尺寸 (可重复使用), capacity: 容量上界
+// 返回: 不超过 capacity 的最大可达容量, 没有可放入的物品时返回 0
+static int MaxReachableCapacity(const vector<int>& sizes, int capacity) {
+    vector<char> reach(capacity + 1, 0);
+    reach[0] = 1;
+    for (int pos = 0; pos < capacity; pos++) {
+        if (!reach[pos]) continue;
+        for (int size : sizes) {
+            if (size > 0 && pos + size <= capacity) {
+                reach[pos + size] = 1;
+            }
+        }
+    }
+    for (int pos = capacity; pos > 0; pos--) {
+        if (reach[pos]) return pos;
+    }
+    return 0;
+}
+
+// 计算一组尺寸的最大公约数 (只统计不超过 capacity 的尺寸)
+static int SizesGcd(const vector<int>& sizes, int capacity) {
+    int g = 0;
+    for (int size : sizes) {
+        if (size > 0 && size <= capacity) {
+            g = gcd(g, size);
+        }
+    }
+    return g;
+}
+
+// 尺寸缩放预处理
+// 在 LoadInput 之后、生成 Arc 网络之前调用
+// 修改: params.stock_width_ / stock_length_, data 中的子板、条带尺寸及索引表
+// 原始尺寸保存在 params.orig_stock_*_ 与 params.dim_scale_*_ 中
+void PreprocessDimensions(ProblemParams& params, ProblemData& data) {
+    params.orig_stock_width_ = params.stock_width_;
+    params.orig_stock_length_ = params.stock_length_;
+    params.dim_scale_width_ = 1;
+    params.dim_scale_length_ = 1;
+
+    vector<int> widths;
+    for (const auto& strip : data.strip_types_) {
+        widths.push_back(strip.width_);
+    }
+    vector<int> lengths;
+    for (const auto& item : data.item_types_) {
+        lengths.push_back(item.length_);
+    }
+
+    // 宽度方向: 可达容量 + GCD
+    int reach_width = MaxReachableCapacity(widths, params.stock_width_);
+    int gcd_width = SizesGcd(widths, params.stock_width_);
+    if (reach_width <= 0 || gcd_width <= 0) {
+        reach_width = params.stock_width_;
+        gcd_width = 1;
+    }
+
+    // 长度方向: 可达容量 + GCD
+    int reach_length = MaxReachableCapacity(lengths, params.stock_length_);
+    int gcd_length = SizesGcd(lengths, params.stock_length_);
+    if (reach_length <= 0 || gcd_length <= 0) {
+        reach_length = params.stock_length_;
+        gcd_length = 1;
+    }
+
+    // 超过容量的尺寸不参与 GCD, 向上取整后仍大于缩放后的容量, 不会进入网络
+    auto scale_down = [](int size, int g) {
+        return (size % g == 0) ? size / g : size / g + 1;
+    };
+
+    params.stock_width_ = reach_width / gcd_width;
+    params.stock_length_ = reach_length / gcd_length;
+    params.dim_scale_width_ = gcd_width;
+    params.dim_scale_length_ = gcd_length;
+
+    for (auto& item : data.item_types_) {
+        item.orig_width_ = item.width_;
+        item.orig_length_ = item.length_;
+        item.width_ = scale_down(item.width_, gcd_width);
+        item.length_ = scale_down(item.length_, gcd_length);
+    }
+    data.strip_widths_.clear();
+    for (auto& strip : data.strip_types_) {
+        strip.orig_width_ = strip.width_;
+        strip.width_ = scale_down(strip.width_, gcd_width);
+        strip.length_ = params.stock_length_;
+        data.strip_widths_.push_back(strip.width_);
+    }
+
+    BuildLengthIndex(data);
+    BuildWidthIndex(data);
+
+    LOG_FMT("[预处理] 宽度: W=%d -> 可达%d, GCD=%d, 缩放后W=%d\n",
+        params.orig_stock_width_, reach_width, gcd_width, params.stock_width_);
+    LOG_FMT("[预处理] 长度: L=%d -> 可达%d, GCD=%d, 缩放后L=%d\n",
+        params.orig_stock_length_, reach_length, gcd_length, params.stock_length_);
+}
+
+// 恢复原始尺寸
+// 求解结束、导出解之前调用; 重复调用无副作用
+void RestoreDimensions(ProblemParams& params, ProblemData& data) {
+    if (params.orig_stock_width_ < 0) return;  // 未做预处理
+    if (params.dim_scale_width_ == 1 && params.dim_scale_length_ == 1 &&
+        params.stock_width_ == params.orig_stock_width_ &&
+        params.stock_length_ == params.orig_stock_length_) {
+        return;
+    }
+
+    for (auto& item : data.item_types_) {
+        item.width_ = item.orig_width_;
+        item.length_ = item.orig_length_;
+    }
+    data.strip_widths_.clear();
+    for (auto& strip : data.strip_types_) {
+        strip.width_ = strip.orig_width_;
+        strip.length_ = params.orig_stock_length_;
+        data.strip_widths_.push_back(strip.width_);
+    }
+    params.stock_width_ = params.orig_stock_width_;
+    params.stock_length_ = params.orig_stock_length_;
+    params.dim_scale_width_ = 1;
+    params.dim_scale_length_ = 1;
+
+    BuildLengthIndex(data);
+    BuildWidthIndex(data);
+
+    LOG_FMT("[预处理] 恢复原始尺寸: W=%d x L=%d\n",
+        params.stock_width_, params.stock_length_);
+}
+
+// 计算定价子问题的数量上界
+// 一块母板上 j 型条带数: min(W / w_j, 能放入该条带的子板总需求)
+// 一个条带上 i 型子板数: min(L / l_i, d_i)
+// 超过需求的数量不会带来更好的整数解, 上界收紧定价可行域并减小 LP 中的被支配列
+void ComputePricingBounds(ProblemParams& params, ProblemData& data) {
+    int num_strip_types = params.num_strip_types_;
+    int num_item_types = params.num_item_types_;
+
+    data.strip_max_per_plate_.assign(num_strip_types, 0);
+    for (int j = 0; j < num_strip_types; j++) {
+        int strip_width = data.strip_types_[j].width_;
+        int fit_demand = 0;
+        for (int i = 0; i < num_item_types; i++) {
+            if (data.item_types_[i].width_ <= strip_width) {
+                fit_demand += data.item_types_[i].demand_;
+            }
+        }
+        data.strip_max_per_plate_[j] = min(params.stock_width_ / strip_width, fit_demand);
+    }
+
+    data.item_max_per_strip_.assign(num_item_types, 0);
+    for (int i = 0; i < num_item_types; i++) {
+        const auto& item = data.item_types_[i];
+        data.item_max_per_strip_[i] = min(params.stock_length_ / item.length_, item.demand_);
+    }
+}
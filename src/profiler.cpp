@@ -0,0 +1,139 @@
+// profiler.cpp - 分阶段性能计时实现
+//
+// 线程缓冲区由全局登记表持有, 线程结束后仍保留, 供 ReportProfile 汇总
+// 登记表只在线程首次计时时加锁; 记录本身只写本线程缓冲区
+
+#include "profiler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+
+#include "logger.h"
+
+using namespace std;
+
+bool g_profile_trace = false;
+
+// 全局线程缓冲区登记表
+static mutex g_profile_mutex;
+static vector<unique_ptr<ProfileThreadBuffer>> g_profile_buffers;
+
+ProfileThreadBuffer& ThreadProfileBuffer() {
+    thread_local ProfileThreadBuffer* buffer = nullptr;
+    if (buffer == nullptr) {
+        lock_guard<mutex> lock(g_profile_mutex);
+        g_profile_buffers.push_back(make_unique<ProfileThreadBuffer>());
+        buffer = g_profile_buffers.back().get();
+        buffer->tid_ = static_cast<int>(g_profile_buffers.size());
+        buffer->name_ = "thread-" + to_string(buffer->tid_);
+    }
+    return *buffer;
+}
+
+void SetProfileThreadName(const string& name) {
+    ThreadProfileBuffer().name_ = name;
+}
+
+// 记录一次区域计时: 区域数很少, 按名字指针线性查找
+void RecordProfileZone(const char* name, int64_t start_ns, int64_t end_ns) {
+    ProfileThreadBuffer& buffer = ThreadProfileBuffer();
+    int64_t dur_ns = end_ns - start_ns;
+
+    ProfileZoneStats* stats = nullptr;
+    for (auto& zone : buffer.zones_) {
+        if (zone.name_ == name) {
+            stats = &zone;
+            break;
+        }
+    }
+    if (stats == nullptr) {
+        buffer.zones_.emplace_back();
+        stats = &buffer.zones_.back();
+        stats->name_ = name;
+    }
+    stats->count_++;
+    stats->total_ns_ += dur_ns;
+    stats->max_ns_ = max(stats->max_ns_, dur_ns);
+
+    if (g_profile_trace) {
+        if (buffer.events_.size() < kMaxProfileEvents) {
+            buffer.events_.push_back({name, start_ns, dur_ns});
+        } else {
+            buffer.dropped_events_++;
+        }
+    }
+}
+
+// 写出 Chrome trace-event JSON
+// 每次计时为一个完整事件 (ph = "X"), 时间单位为微秒; 线程名以元数据事件 (ph = "M") 给出
+static bool WriteProfileTrace(const string& path) {
+    ofstream out(path);
+    if (!out) {
+        LOG_WARN_FMT("[Profile] 错误: 无法写入 trace 文件 %s\n", path.c_str());
+        return false;
+    }
+
+    out << fixed << setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    for (const auto& buffer : g_profile_buffers) {
+        out << (first ? "" : ",\n")
+            << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid_
+            << ",\"args\":{\"name\":\"" << buffer->name_ << "\"}}";
+        first = false;
+        for (const auto& event : buffer->events_) {
+            out << ",\n{\"name\":\"" << event.name_ << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                << buffer->tid_ << ",\"ts\":" << event.start_ns_ / 1000.0
+                << ",\"dur\":" << event.dur_ns_ / 1000.0 << "}";
+        }
+    }
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
+
+void ReportProfile(const string& trace_file) {
+    lock_guard<mutex> lock(g_profile_mutex);
+
+    // 按区域名合并各线程的统计
+    vector<ProfileZoneStats> merged;
+    int64_t num_events = 0;
+    int64_t num_dropped = 0;
+    for (const auto& buffer : g_profile_buffers) {
+        for (const auto& zone : buffer->zones_) {
+            auto it = find_if(merged.begin(), merged.end(), [&](const ProfileZoneStats& s) {
+                return strcmp(s.name_, zone.name_) == 0;
+            });
+            if (it == merged.end()) {
+                merged.push_back(zone);
+            } else {
+                it->count_ += zone.count_;
+                it->total_ns_ += zone.total_ns_;
+                it->max_ns_ = max(it->max_ns_, zone.max_ns_);
+            }
+        }
+        num_events += static_cast<int64_t>(buffer->events_.size());
+        num_dropped += buffer->dropped_events_;
+    }
+    if (merged.empty()) return;
+
+    sort(merged.begin(), merged.end(), [](const ProfileZoneStats& a, const ProfileZoneStats& b) {
+        return a.total_ns_ > b.total_ns_;
+    });
+
+    LOG("------------------------------------------------------------");
+    LOG_FMT("[Profile] 各阶段耗时 (线程%d个, 总时间含嵌套区域)\n", (int)g_profile_buffers.size());
+    LOG_FMT("  %-24s %10s %12s %10s %10s\n", "zone", "calls", "total(ms)", "mean(ms)", "max(ms)");
+    for (const auto& zone : merged) {
+        LOG_FMT("  %-24s %10lld %12.1f %10.3f %10.3f\n", zone.name_, (long long)zone.count_,
+            zone.total_ns_ / 1.0e6, zone.total_ns_ / 1.0e6 / zone.count_, zone.max_ns_ / 1.0e6);
+    }
+
+    if (!trace_file.empty() && WriteProfileTrace(trace_file)) {
+        LOG_FMT("[Profile] trace 已写入 %s (事件%lld个, 丢弃%lld个)\n",
+            trace_file.c_str(), (long long)num_events, (long long)num_dropped);
+    }
+}
@@ -0,0 +1,97 @@
+// profiler.h - 分阶段性能计时头文件
+//
+// 功能: 以作用域 (RAII) 计时各求解阶段, 结束时在日志中输出汇总表,
+//       可选输出 Chrome trace-event JSON (chrome://tracing / Perfetto 打开)
+//
+// 设计:
+// - 计时基于 steady_clock (MSVC 下为 QueryPerformanceCounter)
+// - 每个线程一个缓冲区 (thread_local), 记录时不加锁; 线程首次计时时登记一次
+// - 各线程按区域名累计次数 / 总时间 / 最大时间; 开启 trace 时另记每次调用的起止时间
+// - 区域名必须是字符串常量 (按指针保存)
+// - 总时间为包含时间 (含嵌套区域)
+//
+// 使用方式:
+//   void SolveSomething() {
+//       PROFILE_ZONE("rmp.node.update");   // 作用域结束时记录
+//       ...
+//   }
+//   ReportProfile(trace_file);             // 所有线程结束后调用
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+constexpr size_t kMaxProfileEvents = 1 << 20;  // trace 模式下每个线程最多记录的事件数
+
+// 单个区域的累计统计
+struct ProfileZoneStats {
+    const char* name_ = nullptr;
+    int64_t count_ = 0;
+    int64_t total_ns_ = 0;
+    int64_t max_ns_ = 0;
+};
+
+// 单次计时事件 (trace 模式)
+struct ProfileEvent {
+    const char* name_ = nullptr;
+    int64_t start_ns_ = 0;                  // 相对程序启动的纳秒数
+    int64_t dur_ns_ = 0;
+};
+
+// 线程缓冲区 (只由所属线程写入; ReportProfile 在各线程结束后读取)
+struct ProfileThreadBuffer {
+    int tid_ = 0;                           // 登记顺序编号
+    std::string name_;                      // 线程名 (trace 中的泳道名)
+    std::vector<ProfileZoneStats> zones_;
+    std::vector<ProfileEvent> events_;
+    int64_t dropped_events_ = 0;            // 超过 kMaxProfileEvents 后丢弃的事件数
+};
+
+// 是否记录 trace 事件 (main 在创建工作线程前设置)
+extern bool g_profile_trace;
+
+// 相对程序启动的纳秒数
+inline int64_t ProfileNow() {
+    static const auto epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - epoch).count();
+}
+
+// 当前线程的缓冲区 (首次调用时登记)
+ProfileThreadBuffer& ThreadProfileBuffer();
+
+// 设置当前线程名
+void SetProfileThreadName(const std::string& name);
+
+// 记录一次区域计时
+void RecordProfileZone(const char* name, int64_t start_ns, int64_t end_ns);
+
+// 输出汇总表到日志; trace_file 非空时写出 Chrome trace-event JSON
+// 须在所有计时线程结束后调用
+void ReportProfile(const std::string& trace_file);
+
+// 作用域计时
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : name_(name), start_ns_(ProfileNow()) {}
+    ~ProfileScope() { RecordProfileZone(name_, start_ns_, ProfileNow()); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name_;
+    int64_t start_ns_;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+// 计时当前作用域, name 为字符串常量
+#define PROFILE_ZONE(name) ProfileScope PROFILE_CONCAT(profile_zone_, __LINE__)(name)
+
+#endif  // PROFILER_H_
@@ -26,6 +26,29 @@
 
 using namespace std;
 
+// 从当前RMP读取列池中各列的解值
+// 全部取值写入 store.values_ (按列编号下标), 非零列另外记入 nonzero_cols
+// var_indices_ 无效 (不在当前RMP中) 的列取值为 0
+void ExtractColumnValues(IloCplex& cplex, IloNumVarArray& vars,
+    ColumnStore& store, vector<ColumnValue>& nonzero_cols) {
+
+    store.values_.assign(store.num_cols_, 0.0);
+    nonzero_cols.clear();
+    for (int col = 0; col < store.num_cols_; col++) {
+        int var_idx = store.var_indices_[col];
+        if (var_idx < 0 || var_idx >= vars.getSize()) {
+            LOG_WARN_FMT("[ERROR] column %d has invalid var_index=%d (vars.size=%d)\n",
+                    col, var_idx, (int)vars.getSize());
+            continue;
+        }
+
+        double val = cplex.getValue(vars[var_idx]);
+        if (fabs(val) < kZeroTolerance) continue;  // 处理数值误差, 零值不记录
+        store.values_[col] = val;
+        nonzero_cols.push_back({col, val});
+    }
+}
+
 // 根节点列生成主循环
 // 功能: 通过交替求解主问题和子问题, 逐步生成列直至收敛
 // 流程:
@@ -34,6 +57,8 @@ using namespace std;
 //   3. 直到SP1和所有SP2都收敛, 或达到最大迭代次数
 // 输出: 列生成收敛后的LP最优解存储在root_node中
 void SolveRootCG(ProblemParams& params, ProblemData& data, BPNode& root_node) {
+    PROFILE_ZONE("cg.root");
+
     LOG("[CG] 根节点列生成开始");
 
     // 继承全局SP方法设置
@@ -60,7 +85,14 @@ void SolveRootCG(ProblemParams& params, ProblemData& data, BPNode& root_node) {
     bool feasible = SolveRootInitMP(params, data, env, model, obj, cons, vars,
                                      cplex, root_node);
 
+    // 流水线列生成 (--cg-threads): 定价与 RMP 求解重叠进行, 之后的同步循环负责最终收敛判断
+    if (feasible && params.cg_threads_ > 0) {
+        feasible = RunAsyncRootCG(params, data, obj, cons, vars, cplex, root_node);
+    }
+
     if (feasible) {
+        CGIterTrace trace;  // --cg-trace 逐次迭代记录
+
         // 列生成主循环
         while (true) {
             root_node.iter_++;
@@ -74,24 +106,28 @@ void SolveRootCG(ProblemParams& params, ProblemData& data, BPNode& root_node) {
 
             // 检查最大迭代次数限制
             if (root_node.iter_ >= kMaxCgIter) {
-                LOG_FMT("[CG] 警告: 达到最大迭代次数 %d (异常), 强制终止\n", kMaxCgIter);
-                LOG("[CG]    正常应该收敛, 请检查算法或降低 kMaxCgIter 以更早发现问题");
+                LOG_WARN_FMT("[CG] 警告: 达到最大迭代次数 %d (异常), 强制终止\n", kMaxCgIter);
+                LOG_WARN("[CG]    正常应该收敛, 请检查算法或降低 kMaxCgIter 以更早发现问题");
                 break;
             }
 
             // 控制台进度: 首次迭代、每5次迭代输出
             if (root_node.iter_ == 1 || root_node.iter_ % 5 == 0) {
                 double obj_val = cplex.getValue(obj);
-                int num_y = static_cast<int>(root_node.y_columns_.size());
-                int num_x = static_cast<int>(root_node.x_columns_.size());
+                int num_y = data.y_columns_.num_cols_;
+                int num_x = data.x_columns_.num_cols_;
                 PROGRESS(GetElapsedTime(params),
                     "CG   | iter=%-3d obj=%-7.2f Y=%-3d X=%-3d\n",
                     root_node.iter_, obj_val, num_y, num_x);
             }
 
+            BeginCGIterTrace(trace, params, root_node.id_, root_node.iter_, cplex, cons, vars);
+
             // 步骤1: 求解SP1子问题 (宽度方向背包)
             // 寻找能改进目标的新Y列 (母板切割模式)
+            int64_t sp_start = ProfileNow();
             bool sp1_converged = SolveRootSP1(params, data, root_node);
+            TraceSP1(trace, root_node, sp1_converged, sp_start);
 
             if (sp1_converged) {
                 // SP1收敛: 没有新的Y列能改进目标
@@ -100,22 +136,28 @@ void SolveRootCG(ProblemParams& params, ProblemData& data, BPNode& root_node) {
 
                 for (int j = 0; j < params.num_strip_types_; j++) {
                     // 为条带类型j寻找能改进目标的新X列
+                    sp_start = ProfileNow();
                     bool sp2_converged = SolveRootSP2(params, data, root_node, j);
+                    TraceSP2(trace, root_node, j, sp2_converged, sp_start);
 
                     if (!sp2_converged) {
                         all_sp2_converged = false;
                         // 找到改进列, 立即添加到主问题
-                        SolveRootUpdateMP(params, data, env, model, obj, cons, vars,
+                        int64_t mp_start = ProfileNow();
+                        SolveRootUpdateMP(params, data, obj, cons, vars,
                                           cplex, root_node);
+                        TraceMasterSolve(trace, mp_start);
                     }
                 }
 
                 // 检查是否完全收敛
                 if (all_sp2_converged) {
+                    WriteCGIterTrace(trace);
                     LOG_FMT("[CG] 列生成收敛, 迭代%d次\n", root_node.iter_);
+                    root_node.cg_converged_ = 1;
                     double final_obj = cplex.getValue(obj);
-                    int num_y = static_cast<int>(root_node.y_columns_.size());
-                    int num_x = static_cast<int>(root_node.x_columns_.size());
+                    int num_y = data.y_columns_.num_cols_;
+                    int num_x = data.x_columns_.num_cols_;
                     PROGRESS(GetElapsedTime(params),
                         "CG   | 收敛 iter=%-3d obj=%-7.2f Y=%-3d X=%-3d\n",
                         root_node.iter_, final_obj, num_y, num_x);
@@ -123,13 +165,16 @@ void SolveRootCG(ProblemParams& params, ProblemData& data, BPNode& root_node) {
                 }
             } else {
                 // SP1找到改进列, 添加新Y列并继续迭代
-                SolveRootUpdateMP(params, data, env, model, obj, cons, vars,
+                int64_t mp_start = ProfileNow();
+                SolveRootUpdateMP(params, data, obj, cons, vars,
                                   cplex, root_node);
+                TraceMasterSolve(trace, mp_start);
             }
+            WriteCGIterTrace(trace);
         }
 
         // 求解最终主问题, 提取完整解
-        SolveRootFinalMP(params, data, env, model, obj, cons, vars,
+        SolveRootFinalMP(params, data, obj, cons, vars,
                          cplex, root_node);
 
         // 保存根节点下界到params（用于输出JSON）
@@ -161,9 +206,12 @@ bool SolveRootInitMP(ProblemParams& params, ProblemData& data,
     IloEnv& env, IloModel& model, IloObjective& obj,
     IloRangeArray& cons, IloNumVarArray& vars,
     IloCplex& cplex, BPNode& root_node) {
+    PROFILE_ZONE("rmp.root.init");
 
-    int num_y_cols = static_cast<int>(root_node.y_columns_.size());
-    int num_x_cols = static_cast<int>(root_node.x_columns_.size());
+    ColumnStore& y_store = data.y_columns_;
+    ColumnStore& x_store = data.x_columns_;
+    int num_y_cols = y_store.num_cols_;
+    int num_x_cols = x_store.num_cols_;
     int num_strip_types = params.num_strip_types_;
     int num_item_types = params.num_item_types_;
     int num_rows = num_strip_types + num_item_types;  // 约束总数
@@ -201,7 +249,7 @@ bool SolveRootInitMP(ProblemParams& params, ProblemData& data,
 
         // 条带产出系数: C_jk = pattern[j]
         for (int j = 0; j < num_strip_types; j++) {
-            cplex_col += cons[j](root_node.y_columns_[col].pattern_[j]);
+            cplex_col += cons[j](GetPatternCoef(y_store, col, j));
         }
         // 需求约束系数: 0 (Y列不直接满足需求)
         for (int i = 0; i < num_item_types; i++) {
@@ -211,7 +259,7 @@ bool SolveRootInitMP(ProblemParams& params, ProblemData& data,
         string var_name = "Y_" + to_string(col + 1);
         IloNumVar var(cplex_col, 0, IloInfinity, ILOFLOAT, var_name.c_str());
         vars.add(var);
-        root_node.y_columns_[col].var_index_ = col;  // 记录在vars中的索引
+        y_store.var_indices_[col] = col;  // 记录在vars中的索引
         cplex_col.end();
     }
 
@@ -219,7 +267,7 @@ bool SolveRootInitMP(ProblemParams& params, ProblemData& data,
     // 目标系数 = 0 (条带模式不计入目标)
     for (int col = 0; col < num_x_cols; col++) {
         IloNumColumn cplex_col = obj(0.0);  // 目标函数系数
-        int strip_type = root_node.x_columns_[col].strip_type_id_;
+        int strip_type = x_store.strip_types_[col];
 
         // 条带消耗系数: -1在对应条带类型位置
         // 这表示X列消耗一个对应类型的条带
@@ -228,13 +276,13 @@ bool SolveRootInitMP(ProblemParams& params, ProblemData& data,
         }
         // 需求约束系数: B_ip = pattern[i]
         for (int i = 0; i < num_item_types; i++) {
-            cplex_col += cons[num_strip_types + i](root_node.x_columns_[col].pattern_[i]);
+            cplex_col += cons[num_strip_types + i](GetPatternCoef(x_store, col, i));
         }
 
         string var_name = "X_" + to_string(col + 1);
         IloNumVar var(cplex_col, 0, IloInfinity, ILOFLOAT, var_name.c_str());
         vars.add(var);
-        root_node.x_columns_[col].var_index_ = num_y_cols + col;  // 记录在vars中的索引
+        x_store.var_indices_[col] = num_y_cols + col;  // 记录在vars中的索引
         cplex_col.end();
     }
 
@@ -247,7 +295,7 @@ bool SolveRootInitMP(ProblemParams& params, ProblemData& data,
         cplex.exportModel(lp_file.c_str());
     }
 
-    bool feasible = cplex.solve();
+    bool feasible = SolveMasterLP(params, cplex, kCplexRootMaster);
 
     if (!feasible) {
         LOG("[MP] 初始主问题不可行");
@@ -255,7 +303,7 @@ bool SolveRootInitMP(ProblemParams& params, ProblemData& data,
     }
 
     double obj_val = cplex.getValue(obj);
-    LOG_FMT("[MP] 目标值: %.4f\n", obj_val);
+    LOG_DEBUG_FMT("[MP] 目标值: %.4f\n", obj_val);
 
     // 提取对偶价格, 用于子问题求解
     // 对偶价格反映约束"放松一单位"对目标的改善
@@ -269,91 +317,97 @@ bool SolveRootInitMP(ProblemParams& params, ProblemData& data,
     return true;
 }
 
-// 更新主问题: 添加由子问题生成的新列
-// 功能: 将SP1/SP2生成的新列添加到主问题, 并重新求解获取新对偶价格
-// 新Y列: 来自SP1, 表示新的母板切割模式
-// 新X列: 来自SP2, 表示新的条带切割模式
-// 返回值: true=更新后可行, false=不可行
-bool SolveRootUpdateMP(ProblemParams& params, ProblemData& data,
-    IloEnv& env, IloModel& model, IloObjective& obj,
-    IloRangeArray& cons, IloNumVarArray& vars,
-    IloCplex& cplex, BPNode& node) {
+// 向根节点主问题添加一列并存入全局列池
+// strip_type = -1 为Y列 (母板切割模式), 否则为该条带类型的X列 (条带切割模式)
+// col.arc_ids_ 替换为规范Arc编号 (入池时计算一次, 用于Arc分支)
+void AddRootColumn(ProblemParams& params, ProblemData& data,
+    IloObjective& obj, IloRangeArray& cons, IloNumVarArray& vars,
+    NewColumn& col, int strip_type) {
 
     int num_strip_types = params.num_strip_types_;
     int num_item_types = params.num_item_types_;
 
-    // 添加新Y列 (如果SP1找到改进列)
-    if (!node.new_y_col_.pattern_.empty()) {
+    if (strip_type < 0) {
         IloNumColumn cplex_col = obj(1.0);  // 目标系数=1
 
         // 添加条带产出系数
         for (int j = 0; j < num_strip_types; j++) {
-            cplex_col += cons[j](node.new_y_col_.pattern_[j]);
+            cplex_col += cons[j](col.pattern_[j]);
         }
         // 需求约束系数为0
         for (int i = 0; i < num_item_types; i++) {
             cplex_col += cons[num_strip_types + i](0);
         }
 
-        int col_id = static_cast<int>(node.y_columns_.size()) + 1;
+        int col_id = data.y_columns_.num_cols_ + 1;
         string var_name = "Y_" + to_string(col_id);
 
         IloNumVar var(cplex_col, 0, IloInfinity, ILOFLOAT, var_name.c_str());
         vars.add(var);
         cplex_col.end();
 
-        // 保存新列到列池
-        YColumn y_col;
-        y_col.pattern_ = node.new_y_col_.pattern_;
-        y_col.arc_set_ = node.new_y_col_.arc_set_;  // Arc集合 (用于Arc分支)
-        y_col.var_index_ = vars.getSize() - 1;      // 记录该列在vars中的索引
-        node.y_columns_.push_back(y_col);
+        ComputeYColumnArcIds(data, col.pattern_, col.arc_ids_);
+        int y_col = AppendColumn(data.y_columns_, col.pattern_, -1, col.arc_ids_);
+        data.y_columns_.var_indices_[y_col] = vars.getSize() - 1;  // 记录该列在vars中的索引
+        return;
+    }
 
-        // 清空临时存储
-        node.new_y_col_.pattern_.clear();
-        node.new_y_col_.arc_set_.clear();
+    IloNumColumn cplex_col = obj(0.0);  // 目标系数=0
+
+    // 添加条带消耗系数: 在对应条带类型位置为-1
+    for (int j = 0; j < num_strip_types; j++) {
+        cplex_col += cons[j]((j == strip_type) ? -1 : 0);
+    }
+    // 添加需求满足系数
+    for (int i = 0; i < num_item_types; i++) {
+        cplex_col += cons[num_strip_types + i](col.pattern_[i]);
     }
 
-    // 添加新X列 (如果SP2找到改进列)
-    if (!node.new_x_col_.pattern_.empty()) {
-        int strip_type = node.new_strip_type_;  // 该X列属于哪种条带类型
-        IloNumColumn cplex_col = obj(0.0);  // 目标系数=0
+    int col_id = data.x_columns_.num_cols_ + 1;
+    string var_name = "X_" + to_string(col_id);
 
-        // 添加条带消耗系数: 在对应条带类型位置为-1
-        for (int j = 0; j < num_strip_types; j++) {
-            cplex_col += cons[j]((j == strip_type) ? -1 : 0);
-        }
-        // 添加需求满足系数
-        for (int i = 0; i < num_item_types; i++) {
-            cplex_col += cons[num_strip_types + i](node.new_x_col_.pattern_[i]);
-        }
+    IloNumVar var(cplex_col, 0, IloInfinity, ILOFLOAT, var_name.c_str());
+    vars.add(var);
+    cplex_col.end();
 
-        int col_id = static_cast<int>(node.x_columns_.size()) + 1;
-        string var_name = "X_" + to_string(col_id);
+    ComputeXColumnArcIds(data, col.pattern_, strip_type, col.arc_ids_);
+    int x_col = AppendColumn(data.x_columns_, col.pattern_, strip_type, col.arc_ids_);
+    data.x_columns_.var_indices_[x_col] = vars.getSize() - 1;  // 记录该列在vars中的索引
+}
 
-        IloNumVar var(cplex_col, 0, IloInfinity, ILOFLOAT, var_name.c_str());
-        vars.add(var);
-        cplex_col.end();
+// 更新主问题: 添加由子问题生成的新列
+// 功能: 将SP1/SP2生成的新列添加到主问题, 并重新求解获取新对偶价格
+// 新Y列: 来自SP1, 表示新的母板切割模式
+// 新X列: 来自SP2, 表示新的条带切割模式
+// 返回值: true=更新后可行, false=不可行
+bool SolveRootUpdateMP(ProblemParams& params, ProblemData& data,
+    IloObjective& obj, IloRangeArray& cons, IloNumVarArray& vars,
+    IloCplex& cplex, BPNode& node) {
+    PROFILE_ZONE("rmp.root.update");
 
-        // 保存新列到列池
-        XColumn x_col;
-        x_col.strip_type_id_ = strip_type;
-        x_col.pattern_ = node.new_x_col_.pattern_;
-        x_col.arc_set_ = node.new_x_col_.arc_set_;  // Arc集合 (用于Arc分支)
-        x_col.var_index_ = vars.getSize() - 1;      // 记录该列在vars中的索引
-        node.x_columns_.push_back(x_col);
+    int num_strip_types = params.num_strip_types_;
+    int num_item_types = params.num_item_types_;
 
-        // 清空临时存储
+    // 添加新Y列 (如果SP1找到改进列)
+    if (!node.new_y_col_.pattern_.empty()) {
+        AddRootColumn(params, data, obj, cons, vars, node.new_y_col_, -1);
+        node.new_y_col_.pattern_.clear();
+        node.new_y_col_.arc_ids_.clear();
+    }
+
+    // 添加新X列 (如果SP2找到改进列)
+    if (!node.new_x_col_.pattern_.empty()) {
+        AddRootColumn(params, data, obj, cons, vars, node.new_x_col_, node.new_strip_type_);
         node.new_x_col_.pattern_.clear();
-        node.new_x_col_.arc_set_.clear();
+        node.new_x_col_.arc_ids_.clear();
     }
 
     // 求解更新后的主问题 (复用传入的cplex对象)
-    LOG_FMT("[MP-%d] 更新并求解主问题\n", node.iter_);
+    LOG_DEBUG_FMT("[MP-%d] 更新并求解主问题\n", node.iter_);
 
     // 注意: 不需要重新extract, IloCplex会自动跟踪模型变化
     // 只需调用solve()即可
-    bool feasible = cplex.solve();
+    bool feasible = SolveMasterLP(params, cplex, kCplexRootMaster);
 
     if (!feasible) {
         LOG("[MP] 更新后主问题不可行");
@@ -361,7 +415,7 @@ bool SolveRootUpdateMP(ProblemParams& params, ProblemData& data,
     }
 
     double obj_val = cplex.getValue(obj);
-    LOG_FMT("[MP] 目标值: %.4f\n", obj_val);
+    LOG_DEBUG_FMT("[MP] 目标值: %.4f\n", obj_val);
 
     // 提取新的对偶价格, 用于下一轮子问题求解
     node.duals_.clear();
@@ -382,9 +436,9 @@ bool SolveRootUpdateMP(ProblemParams& params, ProblemData& data,
 //   - node.solution_: 完整的LP解 (包括每列的取值)
 // 返回值: true=可行, false=不可行
 bool SolveRootFinalMP(ProblemParams& params, ProblemData& data,
-    IloEnv& env, IloModel& model, IloObjective& obj,
-    IloRangeArray& cons, IloNumVarArray& vars,
+    IloObjective& obj, IloRangeArray& cons, IloNumVarArray& vars,
     IloCplex& cplex, BPNode& node) {
+    PROFILE_ZONE("rmp.root.final");
 
     LOG_FMT("[MP-Final] 节点%d求解最终主问题\n", node.id_);
 
@@ -396,7 +450,7 @@ bool SolveRootFinalMP(ProblemParams& params, ProblemData& data,
         cplex.exportModel(lp_file.c_str());
     }
 
-    bool feasible = cplex.solve();
+    bool feasible = SolveMasterLP(params, cplex, kCplexRootMaster);
 
     if (!feasible) {
         LOG("[MP] 最终主问题不可行");
@@ -410,47 +464,18 @@ bool SolveRootFinalMP(ProblemParams& params, ProblemData& data,
 
     LOG_FMT("[MP] 最终目标值: %.4f\n", obj_val);
 
-    // 提取Y列的解值 - 使用var_index_正确访问vars数组
+    // 提取各列的解值 - 使用var_indices_正确访问vars数组
     // Y列对应母板切割模式, 其值表示该模式的使用次数
-    node.solution_.y_columns_.clear();
-    for (int col = 0; col < (int)node.y_columns_.size(); col++) {
-        int var_idx = node.y_columns_[col].var_index_;
-        if (var_idx < 0 || var_idx >= vars.getSize()) {
-            LOG_FMT("[ERROR] Y column %d has invalid var_index=%d (vars.size=%d)\n",
-                    col, var_idx, vars.getSize());
-            continue;
-        }
-
-        double val = cplex.getValue(vars[var_idx]);
-        if (fabs(val) < kZeroTolerance) val = 0;  // 处理数值误差
-
-        YColumn y_col = node.y_columns_[col];
-        y_col.value_ = val;  // 记录解值
-        node.solution_.y_columns_.push_back(y_col);
-
-        // 日志输出非零解
-        if (val > kZeroTolerance) {
-            LOG_FMT("  Y_%d = %.4f (var_idx=%d)\n", col + 1, val, var_idx);
+    ExtractColumnValues(cplex, vars, data.y_columns_, node.solution_.y_cols_);
+    ExtractColumnValues(cplex, vars, data.x_columns_, node.solution_.x_cols_);
+
+    // 日志输出非零解
+    for (const auto& entry : node.solution_.y_cols_) {
+        if (entry.value_ > kZeroTolerance) {
+            LOG_TRACE_FMT("  Y_%d = %.4f (var_idx=%d)\n", entry.col_ + 1, entry.value_,
+                data.y_columns_.var_indices_[entry.col_]);
         }
     }
 
-    // 提取X列的解值 - 使用var_index_正确访问vars数组
-    node.solution_.x_columns_.clear();
-    for (int col = 0; col < (int)node.x_columns_.size(); col++) {
-        int var_idx = node.x_columns_[col].var_index_;
-        if (var_idx < 0 || var_idx >= vars.getSize()) {
-            LOG_FMT("[ERROR] X column %d has invalid var_index=%d (vars.size=%d)\n",
-                    col, var_idx, vars.getSize());
-            continue;
-        }
-
-        double val = cplex.getValue(vars[var_idx]);
-        if (fabs(val) < kZeroTolerance) val = 0;
-
-        XColumn x_col = node.x_columns_[col];
-        x_col.value_ = val;
-        node.solution_.x_columns_.push_back(x_col);
-    }
-
     return true;
 }
@@ -47,7 +47,7 @@ bool SolveRootSP1Knapsack(ProblemParams& params, ProblemData& data, BPNode& node
     for (int j = 0; j < num_strip_types; j++) {
         // G_j: 第j型条带在该母板模式中的切割数量
         string var_name = "G_" + to_string(j + 1);
-        IloNumVar var(env, 0, IloInfinity, ILOINT, var_name.c_str());
+        IloNumVar var(env, 0, data.strip_max_per_plate_[j], ILOINT, var_name.c_str());
         vars.add(var);
 
         double dual = node.duals_[j];  // 取条带平衡约束对偶价格
@@ -69,17 +69,19 @@ bool SolveRootSP1Knapsack(ProblemParams& params, ProblemData& data, BPNode& node
     wid_expr.end();
 
     // 调用CPLEX求解背包问题
-    LOG_FMT("[SP1-%d] 节点%d 求解SP1 (背包)\n", node.iter_, node.id_);
+    LOG_DEBUG_FMT("[SP1-%d] 节点%d 求解SP1 (背包)\n", node.iter_, node.id_);
     IloCplex cplex(env);
     cplex.extract(model);
     cplex.setOut(env.getNullStream());  // 关闭CPLEX输出
+    ApplyCplexProfile(cplex, params.cplex_profiles_[kCplexPricing]);
     bool feasible = cplex.solve();
 
     bool cg_converged = true;  // 默认假设收敛
 
     if (feasible) {
         double rc = cplex.getObjValue();  // reduced cost = 目标值
-        LOG_FMT("  [SP1] Reduced Cost: %.4f\n", rc);
+        node.price_value_ = rc;
+        LOG_TRACE_FMT("  [SP1] Reduced Cost: %.4f\n", rc);
 
         // 提取解向量, 构建新Y列的pattern
         // pattern[j] 表示该母板模式切割j型条带的数量
@@ -96,15 +98,15 @@ bool SolveRootSP1Knapsack(ProblemParams& params, ProblemData& data, BPNode& node
         // 若 rc > 1, 说明该列的对偶收益超过成本, 能改进目标
         if (rc > 1 + kRcTolerance) {
             cg_converged = false;  // 找到改进列, 继续迭代
-            LOG("  [SP1] 找到改进列");
+            LOG_DEBUG("  [SP1] 找到改进列");
         } else {
             cg_converged = true;   // 无改进列, 收敛
             node.new_y_col_.pattern_.clear();  // 清空无效的pattern
-            LOG("  [SP1] 收敛");
+            LOG_DEBUG("  [SP1] 收敛");
         }
     } else {
         // 背包问题不可行通常不应发生 (空模式总是可行的)
-        LOG("  [SP1] 子问题不可行");
+        LOG_DEBUG("  [SP1] 子问题不可行");
     }
 
     // 释放CPLEX资源
@@ -130,6 +132,9 @@ bool SolveRootSP1Knapsack(ProblemParams& params, ProblemData& data, BPNode& node
 //   - 分支时可对某Arc的流量添加约束 (禁用/上界/下界)
 // 返回值: true=列生成收敛, false=找到改进列
 bool SolveRootSP1ArcFlow(ProblemParams& params, ProblemData& data, BPNode& node) {
+    // 建模计时起点
+    auto build_start = chrono::steady_clock::now();
+
     IloEnv env;
     IloModel model(env);
     IloNumVarArray vars(env);
@@ -148,13 +153,10 @@ bool SolveRootSP1ArcFlow(ProblemParams& params, ProblemData& data, BPNode& node)
         IloNumVar var(env, 0, 1, ILOINT, var_name.c_str());
         vars.add(var);
 
-        // Arc的长度(终点-起点)对应条带宽度
-        int arc_width = arc_data.arc_list_[i][1] - arc_data.arc_list_[i][0];
-
-        // 检查是否为物品弧 (存在对应的条带类型)
+        // 检查是否为物品弧 (预计算的条带类型标签)
         // 损耗弧 (长度为1且无对应条带) 收益为0
-        if (data.width_to_strip_index_.count(arc_width) > 0) {
-            int strip_idx = data.width_to_strip_index_.at(arc_width);
+        int strip_idx = arc_data.arc_strip_index_[i];
+        if (strip_idx >= 0) {
             double dual = node.duals_[strip_idx];  // 该条带的对偶价格
             if (dual != 0.0) {  // 跳过零系数项
                 obj_expr += vars[i] * dual;
@@ -176,6 +178,19 @@ bool SolveRootSP1ArcFlow(ProblemParams& params, ProblemData& data, BPNode& node)
     model.add(wid_expr <= params.stock_width_);
     wid_expr.end();
 
+    // 数量上界: j 型条带弧的流量之和不超过 strip_max_per_plate_[j] (比容量更紧时才添加)
+    for (int j = 0; j < num_strip_types; j++) {
+        if (data.strip_max_per_plate_[j] >= params.stock_width_ / data.strip_types_[j].width_) {
+            continue;
+        }
+        IloExpr cnt_expr(env);
+        for (int i = 0; i < num_arcs; i++) {
+            if (arc_data.arc_strip_index_[i] == j) cnt_expr += vars[i];
+        }
+        model.add(cnt_expr <= data.strip_max_per_plate_[j]);
+        cnt_expr.end();
+    }
+
     // 起点约束: 从节点0出发的流量 = 1
     // 确保路径从节点0开始
     IloExpr begin_expr(env);
@@ -214,33 +229,38 @@ bool SolveRootSP1ArcFlow(ProblemParams& params, ProblemData& data, BPNode& node)
     // 注意: 根节点没有从父节点继承的Arc约束
     // Arc约束只在非根节点的RMP中作为行约束处理
 
+    // 建模耗时 (不含CPLEX求解)
+    double build_ms = chrono::duration<double, milli>(
+        chrono::steady_clock::now() - build_start).count();
+
     // 求解Arc Flow子问题
-    LOG_FMT("[SP1-%d] 节点%d 求解SP1 (Arc Flow)\n", node.iter_, node.id_);
+    LOG_DEBUG_FMT("[SP1-%d] 节点%d 求解SP1 (Arc Flow)\n", node.iter_, node.id_);
     IloCplex cplex(env);
     cplex.extract(model);
     cplex.setOut(env.getNullStream());
+    ApplyCplexProfile(cplex, params.cplex_profiles_[kCplexPricing]);
     bool feasible = cplex.solve();
+    LOG_TRACE_FMT("  [SP1] 建模耗时: %.3f ms\n", build_ms);
 
     bool cg_converged = true;
 
     if (feasible) {
         double rc = cplex.getObjValue();
-        LOG_FMT("  [SP1] Reduced Cost: %.4f\n", rc);
+        node.price_value_ = rc;
+        LOG_TRACE_FMT("  [SP1] Reduced Cost: %.4f\n", rc);
 
         // 根据选中的Arc构建切割模式
         // 遍历所有Arc, 统计每种条带被选中的次数
         // 只计物品弧, 不计损耗弧
         vector<int> pattern(num_strip_types, 0);
-        set<array<int, 2>> selected_arcs;  // 记录选中的Arc用于子节点Arc约束
+        vector<int> selected_arcs;  // 记录选中的Arc用于子节点Arc约束 (Arc编号, 升序)
         for (int i = 0; i < num_arcs; i++) {
             double val = cplex.getValue(vars[i]);
             if (val > 0.5) {  // Arc被选中 (二值变量, 用0.5判断)
-                const auto& arc = arc_data.arc_list_[i];
-                selected_arcs.insert(arc);  // 记录Arc
-                int arc_width = arc[1] - arc[0];
+                selected_arcs.push_back(i);  // 记录Arc
                 // 只统计物品弧
-                if (data.width_to_strip_index_.count(arc_width) > 0) {
-                    int strip_idx = data.width_to_strip_index_.at(arc_width);
+                int strip_idx = arc_data.arc_strip_index_[i];
+                if (strip_idx >= 0) {
                     pattern[strip_idx]++;  // 该条带类型数量+1
                 }
                 // else: 损耗弧, 不计入pattern
@@ -251,14 +271,14 @@ bool SolveRootSP1ArcFlow(ProblemParams& params, ProblemData& data, BPNode& node)
         if (rc > 1 + kRcTolerance) {
             cg_converged = false;
             node.new_y_col_.pattern_ = pattern;  // 保存新Y列
-            node.new_y_col_.arc_set_ = selected_arcs;  // 保存Arc集合
-            LOG("  [SP1] 找到改进列");
+            node.new_y_col_.arc_ids_ = selected_arcs;  // 保存Arc集合
+            LOG_DEBUG("  [SP1] 找到改进列");
         } else {
             cg_converged = true;
-            LOG("  [SP1] 收敛");
+            LOG_DEBUG("  [SP1] 收敛");
         }
     } else {
-        LOG("  [SP1] 子问题不可行");
+        LOG_DEBUG("  [SP1] 子问题不可行");
     }
 
     // 释放CPLEX资源
@@ -277,7 +297,7 @@ bool SolveRootSP1DP(ProblemParams& params, ProblemData& data, BPNode& node) {
     int num_strip_types = params.num_strip_types_;
     int W = params.stock_width_;
 
-    LOG_FMT("[SP1-%d] 节点%d 求解SP1 (DP)\n", node.iter_, node.id_);
+    LOG_DEBUG_FMT("[SP1-%d] 节点%d 求解SP1 (DP)\n", node.iter_, node.id_);
 
     // dp[w] = (最大价值, 方案)
     vector<double> dp(W + 1, 0.0);
@@ -290,24 +310,20 @@ bool SolveRootSP1DP(ProblemParams& params, ProblemData& data, BPNode& node) {
 
         if (val <= 0) continue;
 
-        for (int w = wid; w <= W; w++) {
-            if (dp[w - wid] + val > dp[w]) {
-                dp[w] = dp[w - wid] + val;
-                choice[w] = choice[w - wid];
-                choice[w][j]++;
-            }
-        }
+        // 完全背包转移, 数量受 strip_max_per_plate_[j] 限制
+        AddKnapsackItem(dp, choice, j, wid, val, data.strip_max_per_plate_[j]);
     }
 
     double rc = dp[W];
-    LOG_FMT("  [SP1] Reduced Cost: %.4f\n", rc);
+    node.price_value_ = rc;
+    LOG_TRACE_FMT("  [SP1] Reduced Cost: %.4f\n", rc);
 
     if (rc > 1 + kRcTolerance) {
         node.new_y_col_.pattern_ = choice[W];
-        LOG("  [SP1] 找到改进列");
+        LOG_DEBUG("  [SP1] 找到改进列");
         return false;
     } else {
-        LOG("  [SP1] 收敛");
+        LOG_DEBUG("  [SP1] 收敛");
         return true;
     }
 }
@@ -330,7 +346,7 @@ bool SolveRootSP2Knapsack(ProblemParams& params, ProblemData& data,
 
     for (int i = 0; i < num_item_types; i++) {
         string var_name = "D_" + to_string(i + 1);
-        IloNumVar var(env, 0, IloInfinity, ILOINT, var_name.c_str());
+        IloNumVar var(env, 0, data.item_max_per_strip_[i], ILOINT, var_name.c_str());
         vars.add(var);
 
         // 只考虑宽度匹配的子件
@@ -367,19 +383,21 @@ bool SolveRootSP2Knapsack(ProblemParams& params, ProblemData& data,
     len_expr.end();
 
     // 求解
-    LOG_FMT("[SP2-%d] 条带类型%d 求解SP2 (背包)\n", node.iter_, strip_type_id);
+    LOG_DEBUG_FMT("[SP2-%d] 条带类型%d 求解SP2 (背包)\n", node.iter_, strip_type_id);
 
     IloCplex cplex(env);
     cplex.extract(model);
     cplex.setOut(env.getNullStream());
+    ApplyCplexProfile(cplex, params.cplex_profiles_[kCplexPricing]);
     bool feasible = cplex.solve();
 
     bool cg_converged = true;
 
     if (feasible) {
         double rc = cplex.getObjValue();
+        node.price_value_ = rc;
         double dual_v = node.duals_[strip_type_id];
-        LOG_FMT("  [SP2] Reduced Cost: %.4f (v_j=%.4f)\n", rc - dual_v, dual_v);
+        LOG_TRACE_FMT("  [SP2] Reduced Cost: %.4f (v_j=%.4f)\n", rc - dual_v, dual_v);
 
         if (rc > dual_v + kRcTolerance) {
             cg_converged = false;
@@ -397,10 +415,10 @@ bool SolveRootSP2Knapsack(ProblemParams& params, ProblemData& data,
                 node.new_x_col_.pattern_.push_back(int_val);
             }
             node.new_strip_type_ = strip_type_id;
-            LOG("  [SP2] 找到改进列");
+            LOG_DEBUG("  [SP2] 找到改进列");
         } else {
             cg_converged = true;
-            LOG("  [SP2] 收敛");
+            LOG_DEBUG("  [SP2] 收敛");
         }
     }
 
@@ -417,13 +435,16 @@ bool SolveRootSP2Knapsack(ProblemParams& params, ProblemData& data,
 // SP2: 长度背包问题 - Arc Flow模型求解
 bool SolveRootSP2ArcFlow(ProblemParams& params, ProblemData& data,
     BPNode& node, int strip_type_id) {
+    // 建模计时起点
+    auto build_start = chrono::steady_clock::now();
 
     // 确保Arc网络已生成
-    if ((int)data.sp2_arc_data_.size() <= strip_type_id) {
-        GenerateSP2Arcs(data, params, strip_type_id);
+    if ((int)data.sp2_strip_data_.size() <= strip_type_id) {
+        GenerateSP2Arcs(data, params);
     }
 
-    SP2ArcFlowData& arc_data = data.sp2_arc_data_[strip_type_id];
+    const SP2ArcFlowData& arc_data = data.sp2_arc_data_;
+    const SP2StripData& strip_data = data.sp2_strip_data_[strip_type_id];
     int num_arcs = static_cast<int>(arc_data.arc_list_.size());
     int num_item_types = params.num_item_types_;
     int num_strip_types = params.num_strip_types_;
@@ -432,21 +453,27 @@ bool SolveRootSP2ArcFlow(ProblemParams& params, ProblemData& data,
         return true;  // 无可用Arc, 视为收敛
     }
 
+    // 共享网络上本条带类型的子板标签 (-1 为损耗弧或不可用)
+    vector<int> arc_items(num_arcs);
+    for (int i = 0; i < num_arcs; i++) {
+        arc_items[i] = GetSP2ArcItem(arc_data, strip_data, i);
+    }
+
     IloEnv env;
     IloModel model(env);
     IloNumVarArray vars(env);
 
-    // 为每个Arc创建0-1变量
+    // 为每个Arc创建0-1变量 (本条带放不下的子板弧上界为0)
     IloExpr obj_expr(env);
     for (int i = 0; i < num_arcs; i++) {
         string var_name = "a_" + to_string(i + 1);
-        IloNumVar var(env, 0, 1, ILOINT, var_name.c_str());
+        int ub = SP2ArcAllowed(arc_data, strip_data, i) ? 1 : 0;
+        IloNumVar var(env, 0, ub, ILOINT, var_name.c_str());
         vars.add(var);
 
-        // Arc长度对应子件长度
-        int arc_len = arc_data.arc_list_[i][1] - arc_data.arc_list_[i][0];
-        if (data.length_to_item_index_.count(arc_len)) {
-            int item_idx = data.length_to_item_index_[arc_len];
+        // Arc长度对应子件长度 (本条带类型的子板标签)
+        int item_idx = arc_items[i];
+        if (item_idx >= 0) {
             double dual = node.duals_[num_strip_types + item_idx];
             if (dual > 0) {
                 obj_expr += vars[i] * dual;
@@ -466,6 +493,23 @@ bool SolveRootSP2ArcFlow(ProblemParams& params, ProblemData& data,
     model.add(len_expr <= params.stock_length_);
     len_expr.end();
 
+    // 数量上界: i 型子板弧的流量之和不超过 item_max_per_strip_[i] (比容量更紧时才添加)
+    for (int k = 0; k < num_item_types; k++) {
+        if (data.item_max_per_strip_[k] >= params.stock_length_ / data.item_types_[k].length_) {
+            continue;
+        }
+        IloExpr cnt_expr(env);
+        bool has_arc = false;
+        for (int i = 0; i < num_arcs; i++) {
+            if (arc_items[i] == k) {
+                cnt_expr += vars[i];
+                has_arc = true;
+            }
+        }
+        if (has_arc) model.add(cnt_expr <= data.item_max_per_strip_[k]);
+        cnt_expr.end();
+    }
+
     // 起点约束
     IloExpr begin_expr(env);
     for (int idx : arc_data.begin_arc_indices_) {
@@ -502,16 +546,22 @@ bool SolveRootSP2ArcFlow(ProblemParams& params, ProblemData& data,
     // Arc约束只在非根节点的RMP中作为行约束处理
 
     // 求解
-    LOG_FMT("[SP2-%d] 条带类型%d 求解SP2 (Arc Flow)\n", node.iter_, strip_type_id);
+    double build_ms = chrono::duration<double, milli>(
+        chrono::steady_clock::now() - build_start).count();
+
+    LOG_DEBUG_FMT("[SP2-%d] 条带类型%d 求解SP2 (Arc Flow)\n", node.iter_, strip_type_id);
     IloCplex cplex(env);
     cplex.extract(model);
     cplex.setOut(env.getNullStream());
+    ApplyCplexProfile(cplex, params.cplex_profiles_[kCplexPricing]);
     bool feasible = cplex.solve();
+    LOG_TRACE_FMT("  [SP2] 建模耗时: %.3f ms\n", build_ms);
 
     bool cg_converged = true;
 
     if (feasible) {
         double rc = cplex.getObjValue();
+        node.price_value_ = rc;
         double dual_v = node.duals_[strip_type_id];
 
         if (rc > dual_v + kRcTolerance) {
@@ -519,27 +569,25 @@ bool SolveRootSP2ArcFlow(ProblemParams& params, ProblemData& data,
 
             // 根据选中的Arc生成pattern
             vector<int> pattern(num_item_types, 0);
-            set<array<int, 2>> selected_arcs;  // 记录选中的Arc用于子节点Arc约束
+            vector<int> selected_arcs;  // 记录选中的Arc用于子节点Arc约束 (Arc编号, 升序)
             for (int i = 0; i < num_arcs; i++) {
                 double val = cplex.getValue(vars[i]);
                 if (val > 0.5) {
-                    const auto& arc = arc_data.arc_list_[i];
-                    selected_arcs.insert(arc);  // 记录Arc
-                    int arc_len = arc[1] - arc[0];
-                    if (data.length_to_item_index_.count(arc_len)) {
-                        int item_idx = data.length_to_item_index_[arc_len];
+                    selected_arcs.push_back(i);  // 记录Arc
+                    int item_idx = arc_items[i];
+                    if (item_idx >= 0) {
                         pattern[item_idx]++;
                     }
                 }
             }
 
             node.new_x_col_.pattern_ = pattern;
-            node.new_x_col_.arc_set_ = selected_arcs;  // 保存Arc集合
+            node.new_x_col_.arc_ids_ = selected_arcs;  // 保存Arc集合
             node.new_strip_type_ = strip_type_id;
-            LOG("  [SP2] 找到改进列");
+            LOG_DEBUG("  [SP2] 找到改进列");
         } else {
             cg_converged = true;
-            LOG("  [SP2] 收敛");
+            LOG_DEBUG("  [SP2] 收敛");
         }
     }
 
@@ -562,7 +610,7 @@ bool SolveRootSP2DP(ProblemParams& params, ProblemData& data,
     int L = params.stock_length_;
     int strip_width = data.strip_types_[strip_type_id].width_;
 
-    LOG_FMT("[SP2-%d] 条带类型%d 求解SP2 (DP)\n", node.iter_, strip_type_id);
+    LOG_DEBUG_FMT("[SP2-%d] 条带类型%d 求解SP2 (DP)\n", node.iter_, strip_type_id);
 
     // dp[l] = (最大价值, 方案)
     vector<double> dp(L + 1, 0.0);
@@ -578,26 +626,59 @@ bool SolveRootSP2DP(ProblemParams& params, ProblemData& data,
 
         if (val <= 0) continue;
 
-        for (int l = len; l <= L; l++) {
-            if (dp[l - len] + val > dp[l]) {
-                dp[l] = dp[l - len] + val;
-                choice[l] = choice[l - len];
-                choice[l][i]++;
-            }
-        }
+        // 完全背包转移, 数量受 item_max_per_strip_[i] 限制
+        AddKnapsackItem(dp, choice, i, len, val, data.item_max_per_strip_[i]);
     }
 
     double rc = dp[L];
+    node.price_value_ = rc;
     double dual_v = node.duals_[strip_type_id];
-    LOG_FMT("  [SP2] Reduced Cost: %.4f (v_j=%.4f)\n", rc - dual_v, dual_v);
+    LOG_TRACE_FMT("  [SP2] Reduced Cost: %.4f (v_j=%.4f)\n", rc - dual_v, dual_v);
 
     if (rc > dual_v + kRcTolerance) {
         node.new_x_col_.pattern_ = choice[L];
         node.new_strip_type_ = strip_type_id;
-        LOG("  [SP2] 找到改进列");
+        LOG_DEBUG("  [SP2] 找到改进列");
         return false;
     } else {
-        LOG("  [SP2] 收敛");
+        LOG_DEBUG("  [SP2] 收敛");
         return true;
     }
 }
+
+// SP2: 长度背包问题 - 隐式网络最长路求解
+// 条带长度超过 kImplicitArcMinLength 时代替 Arc Flow 模型 (不再显式建网)
+bool SolveRootSP2Implicit(ProblemParams& params, ProblemData& data,
+    BPNode& node, int strip_type_id) {
+
+    int num_item_types = params.num_item_types_;
+    int num_strip_types = params.num_strip_types_;
+    const SP2ArcFlowData& arc_data = data.sp2_arc_data_;
+    const SP2StripData& strip_data = data.sp2_strip_data_[strip_type_id];
+
+    LOG_DEBUG_FMT("[SP2-%d] 条带类型%d 求解SP2 (隐式网络)\n", node.iter_, strip_type_id);
+
+    // 子板收益 π_i (只取正值)
+    vector<double> profits(num_item_types, 0.0);
+    for (int i = 0; i < num_item_types; i++) {
+        profits[i] = max(node.duals_[num_strip_types + i], 0.0);
+    }
+
+    vector<int> pattern;
+    vector<int> arc_ids;
+    double rc = SolveSP2ImplicitPath(arc_data, strip_data, profits, vector<int>(),
+        pattern, arc_ids, ThreadPathWorkspace());
+    node.price_value_ = rc;
+    double dual_v = node.duals_[strip_type_id];
+    LOG_TRACE_FMT("  [SP2] Reduced Cost: %.4f (v_j=%.4f)\n", rc - dual_v, dual_v);
+
+    if (rc > dual_v + kRcTolerance) {
+        node.new_x_col_.pattern_ = pattern;
+        node.new_x_col_.arc_ids_ = arc_ids;
+        node.new_strip_type_ = strip_type_id;
+        LOG_DEBUG("  [SP2] 找到改进列");
+        return false;
+    }
+    LOG_DEBUG("  [SP2] 收敛");
+    return true;
+}
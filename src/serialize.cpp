@@ -0,0 +1,458 @@
+// serialize.cpp - 二进制序列化: 节点记录与分支定价检查点
+//
+// 节点记录: 将待处理节点写成紧凑的二进制记录，供节点溢出 (spill) 和检查点使用
+// 只保存继续分支所需的信息:
+//   - 节点标识、下界、分支方向、列生成是否收敛
+//   - 待分支 Arc (由 SelectBranchArc 设置)
+//   - 从祖先累积的 SP1 / SP2 Arc 约束
+//   - 继承的秩1割 (割池下标)
+//   - LP 解的非零列 (只存列编号与取值，列本身在全局列池中)
+// 对偶价格、Arc 约束行、新列等 CG 过程数据在子节点求解时重新生成，不写入
+//
+// 列区间: 列池中 [begin, num_cols_) 的切割方案、条带类型与 Arc 编号，供分布式模式同步新列
+// 割区间: 割池中 [begin, size) 的割，供检查点与分布式模式同步割池
+//
+// 检查点: 列池 + 割池 + 根节点 + 待处理节点 + 当前最优整数解 + 下界统计，写入单个文件
+// --resume 读回后直接进入分支定价，不再重复启发式与根节点列生成
+// 文件头记录算例指纹 (预处理后的母板尺寸与子板尺寸/需求)，与当前算例不符时拒绝读取
+//
+// 记录格式 (本机字节序): 魔数, 版本, 各字段依次写出; 容器先写元素个数
+
+#include "2DBP.h"
+
+using namespace std;
+
+constexpr int32_t kNodeRecordMagic = 0x4E4F4445;  // "NODE"
+constexpr int32_t kNodeRecordVersion = 3;         // 格式变化时递增
+constexpr int32_t kCheckpointMagic = 0x434B5054;  // "CKPT"
+constexpr int32_t kCheckpointVersion = 2;         // 格式变化时递增
+
+// 基本类型读写
+template <typename T>
+static void WritePod(ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static bool ReadPod(istream& in, T& value) {
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return static_cast<bool>(in);
+}
+
+// 元素为 POD 的 vector: 个数 + 连续数据
+template <typename T>
+static void WritePodVector(ostream& out, const vector<T>& values) {
+    WritePod(out, static_cast<int32_t>(values.size()));
+    if (!values.empty()) {
+        out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    }
+}
+
+template <typename T>
+static bool ReadPodVector(istream& in, vector<T>& values) {
+    int32_t size = 0;
+    if (!ReadPod(in, size) || size < 0) return false;
+    values.resize(size);
+    if (size > 0) {
+        in.read(reinterpret_cast<char*>(values.data()), size * sizeof(T));
+    }
+    return static_cast<bool>(in);
+}
+
+// Arc 集合 (按升序写出，读回时顺序插入)
+static void WriteArcSet(ostream& out, const set<array<int, 2>>& arcs) {
+    WritePodVector(out, vector<array<int, 2>>(arcs.begin(), arcs.end()));
+}
+
+static bool ReadArcSet(istream& in, set<array<int, 2>>& arcs) {
+    vector<array<int, 2>> values;
+    if (!ReadPodVector(in, values)) return false;
+    arcs.clear();
+    for (const auto& arc : values) {
+        arcs.emplace_hint(arcs.end(), arc);
+    }
+    return true;
+}
+
+// 按条带类型存储的 map: 个数 + (条带类型, 值) 对
+template <typename T, typename WriteFn>
+static void WriteStripMap(ostream& out, const map<int, T>& values, WriteFn write_value) {
+    WritePod(out, static_cast<int32_t>(values.size()));
+    for (const auto& [strip_type, value] : values) {
+        WritePod(out, static_cast<int32_t>(strip_type));
+        write_value(out, value);
+    }
+}
+
+template <typename T, typename ReadFn>
+static bool ReadStripMap(istream& in, map<int, T>& values, ReadFn read_value) {
+    int32_t size = 0;
+    if (!ReadPod(in, size) || size < 0) return false;
+    values.clear();
+    for (int32_t k = 0; k < size; k++) {
+        int32_t strip_type = 0;
+        if (!ReadPod(in, strip_type)) return false;
+        if (!read_value(in, values[strip_type])) return false;
+    }
+    return true;
+}
+
+// 节点解 (非零列引用)
+static void WriteSolution(ostream& out, const NodeSolution& solution) {
+    WritePodVector(out, solution.y_cols_);
+    WritePodVector(out, solution.x_cols_);
+    WritePod(out, solution.obj_val_);
+}
+
+static bool ReadSolution(istream& in, NodeSolution& solution) {
+    return ReadPodVector(in, solution.y_cols_) &&
+        ReadPodVector(in, solution.x_cols_) &&
+        ReadPod(in, solution.obj_val_);
+}
+
+// 写出一个节点记录
+void WriteNodeRecord(ostream& out, const BPNode& node) {
+    WritePod(out, kNodeRecordMagic);
+    WritePod(out, kNodeRecordVersion);
+
+    // 标识与分支状态
+    WritePod(out, static_cast<int32_t>(node.id_));
+    WritePod(out, static_cast<int32_t>(node.parent_id_));
+    WritePod(out, static_cast<int32_t>(node.branch_dir_));
+    WritePod(out, static_cast<int32_t>(node.depth_));
+    WritePod(out, node.lower_bound_);
+    WritePod(out, static_cast<int32_t>(node.cg_converged_));
+    WritePod(out, static_cast<int32_t>(node.branch_type_));
+    WritePod(out, node.branch_arc_);
+    WritePod(out, node.branch_arc_flow_);
+    WritePod(out, static_cast<int32_t>(node.branch_arc_strip_type_));
+
+    // SP1 Arc 约束
+    WriteArcSet(out, node.sp1_zero_arcs_);
+    WritePodVector(out, node.sp1_lower_arcs_);
+    WritePodVector(out, node.sp1_lower_bounds_);
+    WritePodVector(out, node.sp1_greater_arcs_);
+    WritePodVector(out, node.sp1_greater_bounds_);
+
+    // SP2 Arc 约束
+    auto write_arcs = [](ostream& o, const vector<array<int, 2>>& v) { WritePodVector(o, v); };
+    auto write_bounds = [](ostream& o, const vector<int>& v) { WritePodVector(o, v); };
+    WriteStripMap(out, node.sp2_zero_arcs_, WriteArcSet);
+    WriteStripMap(out, node.sp2_lower_arcs_, write_arcs);
+    WriteStripMap(out, node.sp2_lower_bounds_, write_bounds);
+    WriteStripMap(out, node.sp2_greater_arcs_, write_arcs);
+    WriteStripMap(out, node.sp2_greater_bounds_, write_bounds);
+
+    // 秩1割 (割池下标)
+    WritePodVector(out, node.cut_ids_);
+
+    // LP 解 (列编号引用全局列池)
+    WriteSolution(out, node.solution_);
+}
+
+// 读回一个节点记录，格式或版本不符时返回 false
+bool ReadNodeRecord(istream& in, BPNode& node) {
+    int32_t magic = 0;
+    int32_t version = 0;
+    if (!ReadPod(in, magic) || magic != kNodeRecordMagic) return false;
+    if (!ReadPod(in, version) || version != kNodeRecordVersion) return false;
+
+    int32_t id = 0, parent_id = 0, branch_dir = 0, depth = 0;
+    int32_t cg_converged = 0, branch_type = 0, strip_type = 0;
+    if (!ReadPod(in, id) || !ReadPod(in, parent_id) || !ReadPod(in, branch_dir) ||
+        !ReadPod(in, depth) || !ReadPod(in, node.lower_bound_) ||
+        !ReadPod(in, cg_converged) || !ReadPod(in, branch_type) || !ReadPod(in, node.branch_arc_) ||
+        !ReadPod(in, node.branch_arc_flow_) || !ReadPod(in, strip_type)) {
+        return false;
+    }
+    node.id_ = id;
+    node.parent_id_ = parent_id;
+    node.branch_dir_ = branch_dir;
+    node.depth_ = depth;
+    node.cg_converged_ = cg_converged;
+    node.branch_type_ = branch_type;
+    node.branch_arc_strip_type_ = strip_type;
+
+    if (!ReadArcSet(in, node.sp1_zero_arcs_) ||
+        !ReadPodVector(in, node.sp1_lower_arcs_) ||
+        !ReadPodVector(in, node.sp1_lower_bounds_) ||
+        !ReadPodVector(in, node.sp1_greater_arcs_) ||
+        !ReadPodVector(in, node.sp1_greater_bounds_)) {
+        return false;
+    }
+
+    auto read_arcs = [](istream& i, vector<array<int, 2>>& v) { return ReadPodVector(i, v); };
+    auto read_bounds = [](istream& i, vector<int>& v) { return ReadPodVector(i, v); };
+    if (!ReadStripMap(in, node.sp2_zero_arcs_, ReadArcSet) ||
+        !ReadStripMap(in, node.sp2_lower_arcs_, read_arcs) ||
+        !ReadStripMap(in, node.sp2_lower_bounds_, read_bounds) ||
+        !ReadStripMap(in, node.sp2_greater_arcs_, read_arcs) ||
+        !ReadStripMap(in, node.sp2_greater_bounds_, read_bounds) ||
+        !ReadPodVector(in, node.cut_ids_)) {
+        return false;
+    }
+
+    return ReadSolution(in, node.solution_);
+}
+
+// 列池: 全部数组依次写出
+static void WriteColumnStore(ostream& out, const ColumnStore& store) {
+    WritePod(out, static_cast<int32_t>(store.width_));
+    WritePod(out, static_cast<int32_t>(store.num_cols_));
+    WritePod(out, static_cast<int32_t>(store.wide_ ? 1 : 0));
+    WritePodVector(out, store.patterns16_);
+    WritePodVector(out, store.patterns32_);
+    WritePodVector(out, store.values_);
+    WritePodVector(out, store.strip_types_);
+    WritePodVector(out, store.var_indices_);
+    WritePodVector(out, store.arc_offsets_);
+    WritePodVector(out, store.arc_ids_);
+}
+
+static bool ReadColumnStore(istream& in, ColumnStore& store) {
+    int32_t width = 0, num_cols = 0, wide = 0;
+    if (!ReadPod(in, width) || !ReadPod(in, num_cols) || !ReadPod(in, wide)) return false;
+    store.width_ = width;
+    store.num_cols_ = num_cols;
+    store.wide_ = (wide != 0);
+    return ReadPodVector(in, store.patterns16_) &&
+        ReadPodVector(in, store.patterns32_) &&
+        ReadPodVector(in, store.values_) &&
+        ReadPodVector(in, store.strip_types_) &&
+        ReadPodVector(in, store.var_indices_) &&
+        ReadPodVector(in, store.arc_offsets_) &&
+        ReadPodVector(in, store.arc_ids_) &&
+        static_cast<int>(store.arc_offsets_.size()) == num_cols + 1;
+}
+
+// 写出列池中 [begin, num_cols_) 的列 (取值与变量索引不写出)
+void WriteColumnRange(ostream& out, const ColumnStore& store, int begin) {
+    int count = store.num_cols_ - begin;
+    WritePod(out, static_cast<int32_t>(store.width_));
+    WritePod(out, static_cast<int32_t>(store.wide_ ? 1 : 0));
+    WritePod(out, static_cast<int32_t>(begin));
+    WritePod(out, static_cast<int32_t>(count));
+
+    size_t first = static_cast<size_t>(begin) * store.width_;
+    size_t last = static_cast<size_t>(store.num_cols_) * store.width_;
+    if (store.wide_) {
+        WritePodVector(out, vector<int32_t>(store.patterns32_.begin() + first,
+            store.patterns32_.begin() + last));
+    } else {
+        WritePodVector(out, vector<int16_t>(store.patterns16_.begin() + first,
+            store.patterns16_.begin() + last));
+    }
+    WritePodVector(out, vector<int>(store.strip_types_.begin() + begin, store.strip_types_.end()));
+    WritePodVector(out, vector<int>(store.arc_offsets_.begin() + begin, store.arc_offsets_.end()));
+    WritePodVector(out, vector<int>(store.arc_ids_.begin() + store.arc_offsets_[begin],
+        store.arc_ids_.end()));
+}
+
+// 读回列区间并追加到列池末尾，begin 输出发送方的起始列号
+// 空列池读取时沿用发送方的宽度与存储类型
+bool ReadColumnRange(istream& in, ColumnStore& store, int& begin) {
+    int32_t width = 0, wide = 0, first = 0, count = 0;
+    if (!ReadPod(in, width) || !ReadPod(in, wide) || !ReadPod(in, first) ||
+        !ReadPod(in, count) || count < 0) {
+        return false;
+    }
+    if (store.num_cols_ == 0) {
+        store.width_ = width;
+        store.wide_ = (wide != 0);
+    }
+    if (width != store.width_ || (wide != 0) != store.wide_) return false;
+    begin = first;
+
+    vector<int16_t> patterns16;
+    vector<int32_t> patterns32;
+    vector<int> strip_types, arc_offsets, arc_ids;
+    bool ok = store.wide_ ? ReadPodVector(in, patterns32) : ReadPodVector(in, patterns16);
+    if (!ok || !ReadPodVector(in, strip_types) || !ReadPodVector(in, arc_offsets) ||
+        !ReadPodVector(in, arc_ids)) {
+        return false;
+    }
+    size_t num_coefs = static_cast<size_t>(count) * width;
+    if ((store.wide_ ? patterns32.size() : patterns16.size()) != num_coefs ||
+        static_cast<int>(strip_types.size()) != count ||
+        static_cast<int>(arc_offsets.size()) != count + 1) {
+        return false;
+    }
+
+    store.patterns16_.insert(store.patterns16_.end(), patterns16.begin(), patterns16.end());
+    store.patterns32_.insert(store.patterns32_.end(), patterns32.begin(), patterns32.end());
+    store.strip_types_.insert(store.strip_types_.end(), strip_types.begin(), strip_types.end());
+    store.values_.resize(store.num_cols_ + count, 0.0);
+    store.var_indices_.resize(store.num_cols_ + count, -1);
+    // CSR 偏移改为相对本地 arc_ids_ 末尾
+    int shift = static_cast<int>(store.arc_ids_.size()) - arc_offsets[0];
+    for (int k = 1; k <= count; k++) {
+        store.arc_offsets_.push_back(arc_offsets[k] + shift);
+    }
+    store.arc_ids_.insert(store.arc_ids_.end(), arc_ids.begin(), arc_ids.end());
+    store.num_cols_ += count;
+    return true;
+}
+
+// 写出割池中 [begin, size) 的割
+void WriteCutRange(ostream& out, const vector<RankOneCut>& cuts, int begin) {
+    WritePod(out, static_cast<int32_t>(begin));
+    WritePod(out, static_cast<int32_t>(cuts.size()) - begin);
+    for (int k = begin; k < (int)cuts.size(); k++) {
+        WritePod(out, static_cast<int32_t>(cuts[k].denom_));
+        WritePod(out, static_cast<int32_t>(cuts[k].rhs_));
+        WritePodVector(out, cuts[k].items_);
+    }
+}
+
+// 读回割区间并追加到 cuts 末尾，begin 输出发送方的起始下标
+bool ReadCutRange(istream& in, vector<RankOneCut>& cuts, int& begin) {
+    int32_t first = 0, count = 0;
+    if (!ReadPod(in, first) || !ReadPod(in, count) || count < 0) return false;
+    begin = first;
+    for (int k = 0; k < count; k++) {
+        int32_t denom = 0, rhs = 0;
+        RankOneCut cut;
+        if (!ReadPod(in, denom) || !ReadPod(in, rhs) || !ReadPodVector(in, cut.items_) ||
+            denom <= 0) {
+            return false;
+        }
+        cut.denom_ = denom;
+        cut.rhs_ = rhs;
+        cuts.push_back(move(cut));
+    }
+    return true;
+}
+
+// 算例指纹: 预处理后的母板尺寸、子板尺寸与需求
+vector<int32_t> InstanceFingerprint(const ProblemParams& params, const ProblemData& data) {
+    vector<int32_t> key = {params.stock_width_, params.stock_length_,
+        params.num_item_types_, params.num_strip_types_};
+    for (const auto& item : data.item_types_) {
+        key.push_back(item.width_);
+        key.push_back(item.length_);
+        key.push_back(item.demand_);
+    }
+    return key;
+}
+
+// 写出检查点 (先写临时文件再改名，中途被杀不会留下半个检查点)
+// root: 根节点 (保存其解、下界与是否已分支); open_nodes: 全部待处理节点 (含已读回的溢出节点)
+bool SaveCheckpoint(const string& path, const ProblemParams& params, const ProblemData& data,
+    const BPNode& root, const vector<const BPNode*>& open_nodes, const BPCheckpoint& stats) {
+    PROFILE_ZONE("checkpoint.write");
+
+    error_code ec;
+    filesystem::path parent = filesystem::path(path).parent_path();
+    if (!parent.empty()) filesystem::create_directories(parent, ec);
+
+    string tmp_path = path + ".tmp";
+    {
+        ofstream out(tmp_path, ios::binary | ios::trunc);
+        if (!out) {
+            LOG_WARN_FMT("[检查点] 错误: 无法写入 %s\n", tmp_path.c_str());
+            return false;
+        }
+
+        WritePod(out, kCheckpointMagic);
+        WritePod(out, kCheckpointVersion);
+        WritePodVector(out, InstanceFingerprint(params, data));
+
+        // 全局状态
+        WritePod(out, params.global_best_int_);
+        WriteSolution(out, params.global_best_sol_);
+        WritePod(out, params.root_lb_);
+        WritePod(out, static_cast<int32_t>(params.node_counter_));
+        WritePod(out, stats.released_lb_);
+        WritePod(out, static_cast<int32_t>(stats.released_pruned_));
+        WritePod(out, stats.elapsed_sec_);
+
+        // 列池
+        WriteColumnStore(out, data.y_columns_);
+        WriteColumnStore(out, data.x_columns_);
+        WriteCutRange(out, data.cut_pool_, 0);
+
+        // 根节点与待处理节点
+        WritePod(out, static_cast<int32_t>(root.branched_flag_));
+        WriteNodeRecord(out, root);
+        WritePod(out, static_cast<int32_t>(open_nodes.size()));
+        for (const BPNode* node : open_nodes) {
+            WriteNodeRecord(out, *node);
+        }
+
+        if (!out) {
+            LOG_WARN_FMT("[检查点] 错误: 写入失败 %s\n", tmp_path.c_str());
+            return false;
+        }
+    }
+
+    filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+        LOG_WARN_FMT("[检查点] 错误: 无法改名为 %s (%s)\n", path.c_str(), ec.message().c_str());
+        return false;
+    }
+    LOG_FMT("[检查点] 已写入 %s (Y=%d, X=%d, 待处理节点%d, UB=%.0f)\n",
+        path.c_str(), data.y_columns_.num_cols_, data.x_columns_.num_cols_,
+        (int)open_nodes.size(), params.global_best_int_);
+    return true;
+}
+
+// 读回检查点: 恢复列池、最优整数解与根节点，待处理节点放入 checkpoint.open_nodes_
+// 调用前须完成与写出时相同的数据读取、预处理与建网
+bool LoadCheckpoint(const string& path, ProblemParams& params, ProblemData& data,
+    BPNode& root, BPCheckpoint& checkpoint) {
+
+    ifstream in(path, ios::binary);
+    if (!in) {
+        LOG_WARN_FMT("[检查点] 错误: 无法打开 %s\n", path.c_str());
+        return false;
+    }
+
+    int32_t magic = 0, version = 0;
+    if (!ReadPod(in, magic) || magic != kCheckpointMagic ||
+        !ReadPod(in, version) || version != kCheckpointVersion) {
+        LOG_WARN_FMT("[检查点] 错误: %s 不是当前版本的检查点文件\n", path.c_str());
+        return false;
+    }
+    vector<int32_t> fingerprint;
+    if (!ReadPodVector(in, fingerprint) || fingerprint != InstanceFingerprint(params, data)) {
+        LOG_WARN("[检查点] 错误: 检查点与当前算例不符");
+        return false;
+    }
+
+    int32_t node_counter = 0, released_pruned = 0, root_branched = 0, num_open = 0;
+    int cut_begin = 0;
+    data.cut_pool_.clear();
+    bool ok = ReadPod(in, params.global_best_int_) &&
+        ReadSolution(in, params.global_best_sol_) &&
+        ReadPod(in, params.root_lb_) &&
+        ReadPod(in, node_counter) &&
+        ReadPod(in, checkpoint.released_lb_) &&
+        ReadPod(in, released_pruned) &&
+        ReadPod(in, checkpoint.elapsed_sec_) &&
+        ReadColumnStore(in, data.y_columns_) &&
+        ReadColumnStore(in, data.x_columns_) &&
+        ReadCutRange(in, data.cut_pool_, cut_begin) &&
+        ReadPod(in, root_branched) &&
+        ReadNodeRecord(in, root) &&
+        ReadPod(in, num_open) && num_open >= 0;
+    if (!ok) {
+        LOG_WARN_FMT("[检查点] 错误: %s 内容不完整\n", path.c_str());
+        return false;
+    }
+    params.node_counter_ = node_counter;
+    checkpoint.released_pruned_ = released_pruned;
+    root.branched_flag_ = root_branched;
+
+    checkpoint.open_nodes_.assign(num_open, BPNode());
+    for (auto& node : checkpoint.open_nodes_) {
+        if (!ReadNodeRecord(in, node)) {
+            LOG_WARN_FMT("[检查点] 错误: %s 节点记录不完整\n", path.c_str());
+            return false;
+        }
+    }
+
+    LOG_FMT("[检查点] 已读取 %s (Y=%d, X=%d, 待处理节点%d, UB=%.0f, 此前耗时%.1fs)\n",
+        path.c_str(), data.y_columns_.num_cols_, data.x_columns_.num_cols_,
+        num_open, params.global_best_int_, checkpoint.elapsed_sec_);
+    return true;
+}
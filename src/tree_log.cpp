@@ -0,0 +1,88 @@
+// tree_log.cpp - 分支定价树事件记录 (--tree-log <file>)
+//
+// RunBranchAndPrice 每个事件写出一行 JSON (JSON Lines), 供离线分析与回放,
+// 汇总工具见 tools/bp_tree_summary.cpp. 所有事件含 ev (事件名)、t (程序启动后的秒数)、node:
+//   created    parent, depth, dir (0=根节点, 1=左分支 <=, 2=右分支 >=)
+//   selected   lb (所选节点下界, 最优优先时即全局下界), ub (无整数解时为 null), open (待处理节点数)
+//   solved     lb, iter (列生成迭代次数), ms (节点列生成耗时, 根节点为 null), converged, cuts
+//   branched   type (sp1 / sp2), arc [起点, 终点], flow (分数流量), strip (SP2 条带类型), lb
+//   pruned     reason (bound / prescreen / infeasible / timeout / integer), lb
+//   incumbent  obj
+// 分布式模式 (--serve) 不记录
+
+#include "2DBP.h"
+
+using namespace std;
+
+static ofstream g_tree_log;
+
+// 数值字段, 非有限值写为 null
+static string JsonNumber(double value, const char* format) {
+    if (!isfinite(value)) return "null";
+    char buf[64];
+    snprintf(buf, sizeof(buf), format, value);
+    return buf;
+}
+
+// 写出一个事件: 公共字段 + extra (以逗号开头的其余字段)
+static void WriteTreeEvent(ProblemParams& params, const char* event, int node_id,
+    const string& extra) {
+    if (!g_tree_log.is_open()) return;
+    g_tree_log << "{\"ev\":\"" << event << "\",\"t\":" << JsonNumber(GetElapsedTime(params), "%.3f")
+               << ",\"node\":" << node_id << extra << "}\n" << flush;
+}
+
+bool OpenTreeLog(const string& path) {
+    g_tree_log.open(path);
+    if (!g_tree_log) {
+        LOG_WARN_FMT("[错误] 无法写入分支树事件文件: %s\n", path.c_str());
+        return false;
+    }
+    LOG_FMT("[系统] 分支树事件记录: %s\n", path.c_str());
+    return true;
+}
+
+void CloseTreeLog() {
+    if (g_tree_log.is_open()) g_tree_log.close();
+}
+
+void LogTreeCreated(ProblemParams& params, const BPNode* node) {
+    int dir = node->parent_id_ < 0 ? 0 : node->branch_dir_;
+    WriteTreeEvent(params, "created", node->id_,
+        ",\"parent\":" + to_string(node->parent_id_) + ",\"depth\":" + to_string(node->depth_) +
+        ",\"dir\":" + to_string(dir));
+}
+
+void LogTreeSelected(ProblemParams& params, const BPNode* node, int num_open) {
+    WriteTreeEvent(params, "selected", node->id_,
+        ",\"lb\":" + JsonNumber(node->lower_bound_, "%.6f") +
+        ",\"ub\":" + JsonNumber(params.global_best_int_, "%.6f") +
+        ",\"open\":" + to_string(num_open));
+}
+
+void LogTreeSolved(ProblemParams& params, const BPNode* node, double cg_ms) {
+    WriteTreeEvent(params, "solved", node->id_,
+        ",\"lb\":" + JsonNumber(node->lower_bound_, "%.6f") +
+        ",\"iter\":" + to_string(node->iter_) + ",\"ms\":" + JsonNumber(cg_ms, "%.3f") +
+        ",\"converged\":" + to_string(node->cg_converged_) +
+        ",\"cuts\":" + to_string(node->cut_ids_.size()));
+}
+
+void LogTreeBranched(ProblemParams& params, const BPNode* node) {
+    const char* type = node->branch_type_ == kBranchSP1Arc ? "sp1" : "sp2";
+    WriteTreeEvent(params, "branched", node->id_,
+        string(",\"type\":\"") + type + "\",\"arc\":[" + to_string(node->branch_arc_[0]) + "," +
+        to_string(node->branch_arc_[1]) + "],\"flow\":" + JsonNumber(node->branch_arc_flow_, "%.6f") +
+        ",\"strip\":" + to_string(node->branch_arc_strip_type_) +
+        ",\"lb\":" + JsonNumber(node->lower_bound_, "%.6f"));
+}
+
+void LogTreePruned(ProblemParams& params, int node_id, double lower_bound, const char* reason) {
+    WriteTreeEvent(params, "pruned", node_id,
+        string(",\"reason\":\"") + reason + "\",\"lb\":" + JsonNumber(lower_bound, "%.6f"));
+}
+
+void LogTreeIncumbent(ProblemParams& params, const BPNode* node) {
+    WriteTreeEvent(params, "incumbent", node->id_,
+        ",\"obj\":" + JsonNumber(node->solution_.obj_val_, "%.6f"));
+}
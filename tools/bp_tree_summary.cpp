@@ -0,0 +1,329 @@
+// bp_tree_summary.cpp - 分支树事件记录汇总工具
+//
+// 读取 --tree-log 写出的 JSON Lines (事件格式见 src/tree_log.cpp), 输出:
+// - 树形: 节点数、各深度节点数、剪枝原因、节点列生成耗时与迭代次数
+// - 下界进展: 随时间变化的全局下界 / 上界 / 间隙
+// - 分支效果: 按分支类型 (SP1 / SP2 Arc) 与方向统计子节点下界提升及直接剪枝比例
+//
+// 用法:
+//   bp_tree_summary <tree.jsonl>...          每个文件输出完整汇总
+//   bp_tree_summary --csv <tree.jsonl>...    每个文件一行, 便于多次运行横向比较
+//
+// 不依赖 CPLEX 与求解器源码, 单独编译
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+constexpr int kMaxProgressRows = 20;        // 下界进展表最多输出的行数
+
+// 节点状态 (由事件重建)
+struct TreeNode {
+    int parent_ = -1;
+    int depth_ = 0;
+    int dir_ = 0;                           // 0=根节点, 1=左分支, 2=右分支
+    double lb_ = NAN;                       // 列生成下界 (未求解时为 NaN)
+    bool solved_ = false;
+    bool branched_ = false;
+    string pruned_;                         // 剪枝原因, 空表示未剪枝
+    string branch_type_;                    // 分支类型 (本节点被分支时)
+};
+
+// 下界进展中的一点 (selected / incumbent 事件)
+struct BoundPoint {
+    double t_ = 0.0;
+    double lb_ = NAN;
+    double ub_ = NAN;
+    int open_ = 0;
+};
+
+// 单个分支方向的统计
+struct BranchDirStats {
+    int children_ = 0;
+    int solved_ = 0;                        // 有有效下界的子节点
+    double lb_gain_ = 0.0;                  // 子节点下界 - 父节点下界 之和
+    int fathomed_ = 0;                      // 子节点直接剪枝 (含不可行与整数解)
+};
+
+struct TreeSummary {
+    string file_;
+    map<int, TreeNode> nodes_;
+    map<string, int> prune_reasons_;
+    vector<BoundPoint> progress_;
+    int num_incumbents_ = 0;
+    double ub_ = NAN;
+    double end_time_ = 0.0;
+    double cg_ms_ = 0.0;                    // 分支节点列生成总耗时 (不含根节点)
+    int cg_timed_ = 0;
+    long long cg_iters_ = 0;
+    int num_events_ = 0;
+    int bad_lines_ = 0;
+};
+
+// 读取字段原始文本 ("key":value), 字符串去掉引号; 字段不存在时返回 false
+static bool FindField(const string& line, const string& key, string& value) {
+    string pattern = "\"" + key + "\":";
+    size_t pos = line.find(pattern);
+    if (pos == string::npos) return false;
+    pos += pattern.size();
+
+    if (pos < line.size() && line[pos] == '"') {
+        size_t end = line.find('"', pos + 1);
+        if (end == string::npos) return false;
+        value = line.substr(pos + 1, end - pos - 1);
+        return true;
+    }
+    size_t end = line[pos] == '[' ? line.find(']', pos) + 1 : line.find_first_of(",}", pos);
+    if (end == string::npos || end == 0) return false;
+    value = line.substr(pos, end - pos);
+    return true;
+}
+
+// 数值字段, 不存在或为 null 时返回 NaN
+static double NumberField(const string& line, const string& key) {
+    string value;
+    if (!FindField(line, key, value) || value == "null") return NAN;
+    char* end = nullptr;
+    double number = strtod(value.c_str(), &end);
+    return end == value.c_str() ? NAN : number;
+}
+
+static int IntField(const string& line, const string& key, int fallback) {
+    double number = NumberField(line, key);
+    return isnan(number) ? fallback : static_cast<int>(number);
+}
+
+static bool LoadTreeLog(const string& path, TreeSummary& summary) {
+    ifstream in(path);
+    if (!in) {
+        cerr << "Cannot open " << path << "\n";
+        return false;
+    }
+    summary.file_ = path;
+
+    string line;
+    while (getline(in, line)) {
+        if (line.empty()) continue;
+        string event;
+        int id = IntField(line, "node", -1);
+        if (!FindField(line, "ev", event) || id < 0) {
+            summary.bad_lines_++;
+            continue;
+        }
+        summary.num_events_++;
+        double t = NumberField(line, "t");
+        if (!isnan(t)) summary.end_time_ = max(summary.end_time_, t);
+
+        TreeNode& node = summary.nodes_[id];
+        if (event == "created") {
+            node.parent_ = IntField(line, "parent", -1);
+            node.depth_ = IntField(line, "depth", 0);
+            node.dir_ = IntField(line, "dir", 0);
+        } else if (event == "solved") {
+            node.solved_ = true;
+            node.lb_ = NumberField(line, "lb");
+            double ms = NumberField(line, "ms");
+            if (!isnan(ms)) {
+                summary.cg_ms_ += ms;
+                summary.cg_timed_++;
+                summary.cg_iters_ += IntField(line, "iter", 0);
+            }
+        } else if (event == "selected") {
+            BoundPoint point;
+            point.t_ = t;
+            point.lb_ = NumberField(line, "lb");
+            point.ub_ = NumberField(line, "ub");
+            point.open_ = IntField(line, "open", 0);
+            summary.progress_.push_back(point);
+        } else if (event == "branched") {
+            node.branched_ = true;
+            FindField(line, "type", node.branch_type_);
+            if (isnan(node.lb_)) node.lb_ = NumberField(line, "lb");
+        } else if (event == "pruned") {
+            string reason;
+            FindField(line, "reason", reason);
+            node.pruned_ = reason;
+            if (isnan(node.lb_)) node.lb_ = NumberField(line, "lb");
+            summary.prune_reasons_[reason]++;
+        } else if (event == "incumbent") {
+            summary.num_incumbents_++;
+            double obj = NumberField(line, "obj");
+            if (isnan(summary.ub_) || obj < summary.ub_) summary.ub_ = obj;
+            BoundPoint point;
+            point.t_ = t;
+            point.lb_ = summary.progress_.empty() ? NAN : summary.progress_.back().lb_;
+            point.ub_ = summary.ub_;
+            point.open_ = summary.progress_.empty() ? 0 : summary.progress_.back().open_;
+            summary.progress_.push_back(point);
+        } else {
+            summary.bad_lines_++;
+        }
+    }
+    return true;
+}
+
+// 结束时的全局下界: 未分支且未剪枝节点下界的最小值; 没有这样的节点时搜索已完成, 取上界
+static double FinalLowerBound(const TreeSummary& summary) {
+    double lb = INFINITY;
+    for (const auto& [id, node] : summary.nodes_) {
+        if (node.branched_ || !node.pruned_.empty() || isnan(node.lb_)) continue;
+        lb = min(lb, node.lb_);
+    }
+    return lb < INFINITY ? lb : summary.ub_;
+}
+
+static double Gap(double lb, double ub) {
+    if (isnan(lb) || isnan(ub) || ub <= 0) return NAN;
+    return (ub - lb) / ub * 100.0;
+}
+
+// 分支效果: 按 "类型/方向" 汇总子节点
+static map<string, BranchDirStats> BranchStats(const TreeSummary& summary) {
+    map<string, BranchDirStats> stats;
+    for (const auto& [id, node] : summary.nodes_) {
+        if (node.parent_ < 0 || node.dir_ == 0) continue;
+        auto parent_it = summary.nodes_.find(node.parent_);
+        if (parent_it == summary.nodes_.end()) continue;
+        const TreeNode& parent = parent_it->second;
+        if (parent.branch_type_.empty()) continue;
+
+        BranchDirStats& s = stats[parent.branch_type_ + (node.dir_ == 1 ? " <=" : " >=")];
+        s.children_++;
+        if (!node.pruned_.empty() && node.pruned_ != "timeout") s.fathomed_++;
+        if (node.solved_ && node.pruned_ != "infeasible" && node.pruned_ != "timeout" &&
+            !isnan(node.lb_) && !isnan(parent.lb_)) {
+            s.solved_++;
+            s.lb_gain_ += node.lb_ - parent.lb_;
+        }
+    }
+    return stats;
+}
+
+static void PrintSummary(const TreeSummary& summary) {
+    int num_branched = 0;
+    int num_open = 0;
+    int max_depth = 0;
+    map<int, int> depth_count;
+    for (const auto& [id, node] : summary.nodes_) {
+        if (node.branched_) num_branched++;
+        if (!node.branched_ && node.pruned_.empty()) num_open++;
+        max_depth = max(max_depth, node.depth_);
+        depth_count[node.depth_]++;
+    }
+    double final_lb = FinalLowerBound(summary);
+
+    printf("== %s\n", summary.file_.c_str());
+    printf("[树形] 节点%d个, 已分支%d, 剪枝%d, 未处理%d, 最大深度%d, 用时 %.1f s\n",
+        (int)summary.nodes_.size(), num_branched,
+        (int)(summary.nodes_.size() - num_branched - num_open), num_open, max_depth,
+        summary.end_time_);
+    printf("  剪枝原因:");
+    for (const auto& [reason, count] : summary.prune_reasons_) {
+        printf(" %s=%d", reason.c_str(), count);
+    }
+    printf("\n  各深度节点数:");
+    for (const auto& [depth, count] : depth_count) {
+        printf(" %d:%d", depth, count);
+    }
+    printf("\n");
+    if (summary.cg_timed_ > 0) {
+        printf("  节点列生成: %d次, 平均 %.1f ms, 平均迭代 %.1f\n", summary.cg_timed_,
+            summary.cg_ms_ / summary.cg_timed_, (double)summary.cg_iters_ / summary.cg_timed_);
+    }
+
+    printf("[下界进展] 整数解更新%d次, 结束时 LB=%.4f UB=%.4f Gap=%.2f%%\n",
+        summary.num_incumbents_, final_lb, summary.ub_, Gap(final_lb, summary.ub_));
+    if (!summary.progress_.empty()) {
+        printf("  %10s %12s %12s %9s %8s\n", "t(s)", "lb", "ub", "gap(%)", "open");
+        int num_points = static_cast<int>(summary.progress_.size());
+        int step = max(1, (num_points + kMaxProgressRows - 1) / kMaxProgressRows);
+        for (int k = 0; k < num_points; k++) {
+            if (k % step != 0 && k != num_points - 1) continue;
+            const BoundPoint& point = summary.progress_[k];
+            printf("  %10.2f %12.4f %12.4f %9.2f %8d\n", point.t_, point.lb_, point.ub_,
+                Gap(point.lb_, point.ub_), point.open_);
+        }
+    }
+
+    map<string, BranchDirStats> stats = BranchStats(summary);
+    if (!stats.empty()) {
+        printf("[分支效果] 子节点下界提升 = 子节点下界 - 父节点下界\n");
+        printf("  %-8s %10s %14s %12s\n", "branch", "children", "mean_lb_gain", "fathomed(%)");
+        for (const auto& [key, s] : stats) {
+            printf("  %-8s %10d %14.4f %12.1f\n", key.c_str(), s.children_,
+                s.solved_ > 0 ? s.lb_gain_ / s.solved_ : NAN, 100.0 * s.fathomed_ / s.children_);
+        }
+    }
+    if (summary.bad_lines_ > 0) {
+        printf("  (跳过无法解析的行 %d)\n", summary.bad_lines_);
+    }
+    printf("\n");
+}
+
+static void PrintCsvRow(const TreeSummary& summary) {
+    int num_branched = 0;
+    int max_depth = 0;
+    for (const auto& [id, node] : summary.nodes_) {
+        if (node.branched_) num_branched++;
+        max_depth = max(max_depth, node.depth_);
+    }
+    double final_lb = FinalLowerBound(summary);
+    auto reason = [&](const char* name) {
+        auto it = summary.prune_reasons_.find(name);
+        return it == summary.prune_reasons_.end() ? 0 : it->second;
+    };
+    printf("%s,%d,%d,%d,%d,%d,%d,%d,%d,%.6f,%.6f,%.4f,%.3f\n", summary.file_.c_str(),
+        (int)summary.nodes_.size(), num_branched, max_depth,
+        reason("bound") + reason("prescreen"), reason("infeasible"), reason("integer"),
+        reason("timeout"), summary.num_incumbents_, final_lb, summary.ub_,
+        Gap(final_lb, summary.ub_), summary.end_time_);
+}
+
+int main(int argc, char* argv[]) {
+    bool csv = false;
+    vector<string> files;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--csv") {
+            csv = true;
+        } else if (arg == "-h" || arg == "--help") {
+            files.clear();
+            break;
+        } else {
+            files.push_back(arg);
+        }
+    }
+    if (files.empty()) {
+        cout << "Usage: " << argv[0] << " [--csv] <tree.jsonl>...\n";
+        cout << "  Summarise branch-and-price tree event logs written by --tree-log\n";
+        cout << "  --csv    One line per log: nodes, depth, prune reasons, final bounds and gap\n";
+        return 1;
+    }
+
+    if (csv) {
+        printf("file,nodes,branched,max_depth,pruned_bound,infeasible,integer,timeout,"
+               "incumbents,final_lb,final_ub,gap_pct,time_s\n");
+    }
+    int rc = 0;
+    for (const string& file : files) {
+        TreeSummary summary;
+        if (!LoadTreeLog(file, summary)) {
+            rc = 1;
+            continue;
+        }
+        if (csv) {
+            PrintCsvRow(summary);
+        } else {
+            PrintSummary(summary);
+        }
+    }
+    return rc;
+}